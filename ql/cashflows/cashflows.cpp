@@ -559,112 +559,56 @@ namespace QuantLib {
                 return -1;
         }
 
-        // helper fucntion used to calculate Time-To-Discount for each stage when calculating discount factor stepwisely
-        Time getStepwiseDiscountTime(const ext::shared_ptr<QuantLib::CashFlow>& cashFlow,
-                                     const DayCounter& dc,
-                                     Date npvDate,
-                                     Date lastDate) {
-            Date cashFlowDate = cashFlow->date();
-            Date refStartDate, refEndDate;
-            ext::shared_ptr<Coupon> coupon =
-                    ext::dynamic_pointer_cast<Coupon>(cashFlow);
-            if (coupon != nullptr) {
-                refStartDate = coupon->referencePeriodStart();
-                refEndDate = coupon->referencePeriodEnd();
-            } else {
-                if (lastDate == npvDate) {
-                    // we don't have a previous coupon date,
-                    // so we fake it
-                    refStartDate = cashFlowDate - 1*Years;
-                } else  {
-                    refStartDate = lastDate;
-                }
-                refEndDate = cashFlowDate;
-            }
-
-            if ((coupon != nullptr) && lastDate != coupon->accrualStartDate()) {
-                Time couponPeriod = dc.yearFraction(coupon->accrualStartDate(),
-                                                cashFlowDate, refStartDate, refEndDate);
-                Time accruedPeriod = dc.yearFraction(coupon->accrualStartDate(),
-                                                lastDate, refStartDate, refEndDate);
-                return couponPeriod - accruedPeriod;
-            } else {
-                return dc.yearFraction(lastDate, cashFlowDate,
-                                       refStartDate, refEndDate);
-            }
+        void checkDayCounter(const LegSnapshot& leg,
+                             const InterestRate& y) {
+            QL_REQUIRE(!leg.dayCounter().empty(),
+                       "no day counter given for leg snapshot");
+            QL_REQUIRE(leg.dayCounter() == y.dayCounter(),
+                       "leg snapshot built with " << leg.dayCounter() <<
+                       " day counter, different from the yield one");
         }
 
-        Real simpleDuration(const Leg& leg,
-                            const InterestRate& y,
-                            bool includeSettlementDateFlows,
-                            Date settlementDate,
-                            Date npvDate) {
+        Real simpleDuration(const LegSnapshot& leg,
+                            const InterestRate& y) {
             if (leg.empty())
                 return 0.0;
 
-            if (settlementDate == Date())
-                settlementDate = Settings::instance().evaluationDate();
+            checkDayCounter(leg, y);
 
-            if (npvDate == Date())
-                npvDate = settlementDate;
+            const std::vector<Real>& amounts = leg.amounts();
+            const std::vector<Time>& times = leg.times();
 
             Real P = 0.0;
             Real dPdy = 0.0;
-            Time t = 0.0;
-            Date lastDate = npvDate;
-            const DayCounter& dc = y.dayCounter();
-            for (const auto& i : leg) {
-                if (i->hasOccurred(settlementDate, includeSettlementDateFlows))
-                    continue;
-
-                Real c = i->amount();
-                if (i->tradingExCoupon(settlementDate)) {
-                    c = 0.0;
-                }
-
-                t += getStepwiseDiscountTime(i, dc, npvDate, lastDate);
+            for (Size i=0; i<amounts.size(); ++i) {
+                Real c = amounts[i];
+                Time t = times[i];
                 DiscountFactor B = y.discountFactor(t);
                 P += c * B;
                 dPdy += t * c * B;
-
-                lastDate = i->date();
             }
             if (P == 0.0) // no cashflows
                 return 0.0;
             return dPdy/P;
         }
 
-        Real modifiedDuration(const Leg& leg,
-                              const InterestRate& y,
-                              bool includeSettlementDateFlows,
-                              Date settlementDate,
-                              Date npvDate) {
+        Real modifiedDuration(const LegSnapshot& leg,
+                              const InterestRate& y) {
             if (leg.empty())
                 return 0.0;
 
-            if (settlementDate == Date())
-                settlementDate = Settings::instance().evaluationDate();
+            checkDayCounter(leg, y);
 
-            if (npvDate == Date())
-                npvDate = settlementDate;
+            const std::vector<Real>& amounts = leg.amounts();
+            const std::vector<Time>& times = leg.times();
 
             Real P = 0.0;
-            Time t = 0.0;
             Real dPdy = 0.0;
             Rate r = y.rate();
             Natural N = y.frequency();
-            Date lastDate = npvDate;
-            const DayCounter& dc = y.dayCounter();
-            for (const auto& i : leg) {
-                if (i->hasOccurred(settlementDate, includeSettlementDateFlows))
-                    continue;
-
-                Real c = i->amount();
-                if (i->tradingExCoupon(settlementDate)) {
-                    c = 0.0;
-                }
-
-                t += getStepwiseDiscountTime(i, dc, npvDate, lastDate);
+            for (Size i=0; i<amounts.size(); ++i) {
+                Real c = amounts[i];
+                Time t = times[i];
                 DiscountFactor B = y.discountFactor(t);
                 P += c * B;
                 switch (y.compounding()) {
@@ -693,7 +637,6 @@ namespace QuantLib {
                     QL_FAIL("unknown compounding convention (" <<
                             Integer(y.compounding()) << ")");
                 }
-                lastDate = i->date();
             }
 
             if (P == 0.0) // no cashflows
@@ -701,64 +644,36 @@ namespace QuantLib {
             return -dPdy/P; // reverse derivative sign
         }
 
-        Real macaulayDuration(const Leg& leg,
-                              const InterestRate& y,
-                              bool includeSettlementDateFlows,
-                              Date settlementDate,
-                              Date npvDate) {
+        Real macaulayDuration(const LegSnapshot& leg,
+                              const InterestRate& y) {
 
             QL_REQUIRE(y.compounding() == Compounded,
                        "compounded rate required");
 
-            return (1.0+y.rate()/y.frequency()) *
-                modifiedDuration(leg, y,
-                                 includeSettlementDateFlows,
-                                 settlementDate, npvDate);
+            return (1.0+y.rate()/y.frequency()) * modifiedDuration(leg, y);
         }
 
-        struct CashFlowLater {
-            bool operator()(const ext::shared_ptr<CashFlow> &c,
-                            const ext::shared_ptr<CashFlow> &d) {
-                return c->date() > d->date();
-            }
-        };
-
     } // anonymous namespace ends here
 
-    CashFlows::IrrFinder::IrrFinder(const Leg& leg,
+    CashFlows::IrrFinder::IrrFinder(const LegSnapshot& leg,
                                     Real npv,
-                                    DayCounter dayCounter,
                                     Compounding comp,
-                                    Frequency freq,
-                                    bool includeSettlementDateFlows,
-                                    Date settlementDate,
-                                    Date npvDate)
-    : leg_(leg), npv_(npv), dayCounter_(std::move(dayCounter)), compounding_(comp),
-      frequency_(freq), includeSettlementDateFlows_(includeSettlementDateFlows),
-      settlementDate_(settlementDate), npvDate_(npvDate) {
-
-        if (settlementDate_ == Date())
-            settlementDate_ = Settings::instance().evaluationDate();
-
-        if (npvDate_ == Date())
-            npvDate_ = settlementDate_;
-
+                                    Frequency freq)
+    : leg_(leg), npv_(npv), compounding_(comp), frequency_(freq) {
+        QL_REQUIRE(!leg_.dayCounter().empty(),
+                   "no day counter given for leg snapshot");
         checkSign();
     }
 
     Real CashFlows::IrrFinder::operator()(Rate y) const {
-        InterestRate yield(y, dayCounter_, compounding_, frequency_);
-        Real NPV = CashFlows::npv(leg_, yield,
-                                  includeSettlementDateFlows_,
-                                  settlementDate_, npvDate_);
+        InterestRate yield(y, leg_.dayCounter(), compounding_, frequency_);
+        Real NPV = CashFlows::npv(leg_, yield);
         return npv_ - NPV;
     }
 
     Real CashFlows::IrrFinder::derivative(Rate y) const {
-        InterestRate yield(y, dayCounter_, compounding_, frequency_);
-        return modifiedDuration(leg_, yield,
-                                includeSettlementDateFlows_,
-                                settlementDate_, npvDate_);
+        InterestRate yield(y, leg_.dayCounter(), compounding_, frequency_);
+        return modifiedDuration(leg_, yield);
     }
 
     void CashFlows::IrrFinder::checkSign() const {
@@ -768,16 +683,15 @@ namespace QuantLib {
 
         Integer lastSign = sign(-npv_),
                 signChanges = 0;
-        for (const auto& i : leg_) {
-            if (!i->hasOccurred(settlementDate_, includeSettlementDateFlows_) &&
-                !i->tradingExCoupon(settlementDate_)) {
-                Integer thisSign = sign(i->amount());
-                if (lastSign * thisSign < 0) // sign change
-                    signChanges++;
-
-                if (thisSign != 0)
-                    lastSign = thisSign;
-            }
+        for (Real amount : leg_.amounts()) {
+            // flows trading ex-coupon have a null amount and are
+            // thus skipped
+            Integer thisSign = sign(amount);
+            if (lastSign * thisSign < 0) // sign change
+                signChanges++;
+
+            if (thisSign != 0)
+                lastSign = thisSign;
         }
         QL_REQUIRE(signChanges > 0,
                    "the given cash flows cannot result in the given market "
@@ -812,39 +726,10 @@ namespace QuantLib {
         if (leg.empty())
             return 0.0;
 
-        if (settlementDate == Date())
-            settlementDate = Settings::instance().evaluationDate();
-
-        if (npvDate == Date())
-            npvDate = settlementDate;
-
-#if defined(QL_EXTRA_SAFETY_CHECKS)
-        QL_REQUIRE(std::adjacent_find(leg.begin(), leg.end(),
-                                      CashFlowLater()) == leg.end(),
-                   "cashflows must be sorted in ascending order w.r.t. their payment dates");
-#endif
-
-        Real npv = 0.0;
-        DiscountFactor discount = 1.0;
-        Date lastDate = npvDate;
-        const DayCounter& dc = y.dayCounter();
-        for (const auto& i : leg) {
-            if (i->hasOccurred(settlementDate, includeSettlementDateFlows))
-                continue;
-
-            Real amount = i->amount();
-            if (i->tradingExCoupon(settlementDate)) {
-                amount = 0.0;
-            }
-
-            DiscountFactor b = y.discountFactor(getStepwiseDiscountTime(i, dc, npvDate, lastDate));
-            discount *= b;
-            lastDate = i->date();
-
-            npv += amount * discount;
-        }
-
-        return npv;
+        LegSnapshot snapshot(leg, y.dayCounter(),
+                             includeSettlementDateFlows,
+                             settlementDate, npvDate);
+        return npv(snapshot, y);
     }
 
     Real CashFlows::npv(const Leg& leg,
@@ -926,28 +811,10 @@ namespace QuantLib {
         if (leg.empty())
             return 0.0;
 
-        if (settlementDate == Date())
-            settlementDate = Settings::instance().evaluationDate();
-
-        if (npvDate == Date())
-            npvDate = settlementDate;
-
-        switch (type) {
-          case Duration::Simple:
-            return simpleDuration(leg, rate,
-                                  includeSettlementDateFlows,
-                                  settlementDate, npvDate);
-          case Duration::Modified:
-            return modifiedDuration(leg, rate,
-                                    includeSettlementDateFlows,
-                                    settlementDate, npvDate);
-          case Duration::Macaulay:
-            return macaulayDuration(leg, rate,
-                                    includeSettlementDateFlows,
-                                    settlementDate, npvDate);
-          default:
-            QL_FAIL("unknown duration type");
-        }
+        LegSnapshot snapshot(leg, rate.dayCounter(),
+                             includeSettlementDateFlows,
+                             settlementDate, npvDate);
+        return duration(snapshot, rate, type);
     }
 
     Time CashFlows::duration(const Leg& leg,
@@ -973,30 +840,190 @@ namespace QuantLib {
         if (leg.empty())
             return 0.0;
 
-        if (settlementDate == Date())
-            settlementDate = Settings::instance().evaluationDate();
+        LegSnapshot snapshot(leg, y.dayCounter(),
+                             includeSettlementDateFlows,
+                             settlementDate, npvDate);
+        return convexity(snapshot, y);
+    }
 
-        if (npvDate == Date())
-            npvDate = settlementDate;
 
-        const DayCounter& dc = y.dayCounter();
+    Real CashFlows::convexity(const Leg& leg,
+                              Rate yield,
+                              const DayCounter& dc,
+                              Compounding comp,
+                              Frequency freq,
+                              bool includeSettlementDateFlows,
+                              Date settlementDate,
+                              Date npvDate) {
+        return convexity(leg, InterestRate(yield, dc, comp, freq),
+                         includeSettlementDateFlows,
+                         settlementDate, npvDate);
+    }
+
+    Real CashFlows::basisPointValue(const Leg& leg,
+                                    const InterestRate& y,
+                                    bool includeSettlementDateFlows,
+                                    Date settlementDate,
+                                    Date npvDate) {
+        if (leg.empty())
+            return 0.0;
+
+        LegSnapshot snapshot(leg, y.dayCounter(),
+                             includeSettlementDateFlows,
+                             settlementDate, npvDate);
+        return basisPointValue(snapshot, y);
+    }
+
+    Real CashFlows::basisPointValue(const Leg& leg,
+                                    Rate yield,
+                                    const DayCounter& dc,
+                                    Compounding comp,
+                                    Frequency freq,
+                                    bool includeSettlementDateFlows,
+                                    Date settlementDate,
+                                    Date npvDate) {
+        return basisPointValue(leg, InterestRate(yield, dc, comp, freq),
+                               includeSettlementDateFlows,
+                               settlementDate, npvDate);
+    }
+
+    Real CashFlows::yieldValueBasisPoint(const Leg& leg,
+                                         const InterestRate& y,
+                                         bool includeSettlementDateFlows,
+                                         Date settlementDate,
+                                         Date npvDate) {
+        if (leg.empty())
+            return 0.0;
+
+        LegSnapshot snapshot(leg, y.dayCounter(),
+                             includeSettlementDateFlows,
+                             settlementDate, npvDate);
+        return yieldValueBasisPoint(snapshot, y);
+    }
+
+    Real CashFlows::yieldValueBasisPoint(const Leg& leg,
+                                         Rate yield,
+                                         const DayCounter& dc,
+                                         Compounding comp,
+                                         Frequency freq,
+                                         bool includeSettlementDateFlows,
+                                         Date settlementDate,
+                                         Date npvDate) {
+        return yieldValueBasisPoint(leg, InterestRate(yield, dc, comp, freq),
+                                    includeSettlementDateFlows,
+                                    settlementDate, npvDate);
+    }
+
+    // LegSnapshot functions
+
+    Real CashFlows::npv(const LegSnapshot& leg,
+                        const YieldTermStructure& discountCurve) {
+        if (leg.empty())
+            return 0.0;
+
+        const std::vector<Date>& dates = leg.dates();
+        const std::vector<Real>& amounts = leg.amounts();
+
+        Real totalNPV = 0.0;
+        for (Size i=0; i<dates.size(); ++i)
+            totalNPV += amounts[i] * discountCurve.discount(dates[i]);
+
+        return totalNPV/discountCurve.discount(leg.npvDate());
+    }
+
+    Real CashFlows::bps(const LegSnapshot& leg,
+                        const YieldTermStructure& discountCurve) {
+        if (leg.empty())
+            return 0.0;
+
+        const std::vector<Date>& dates = leg.dates();
+        const std::vector<Real>& factors = leg.bpsFactors();
+
+        Real bps = 0.0;
+        for (Size i=0; i<dates.size(); ++i) {
+            if (factors[i] != 0.0)
+                bps += factors[i] * discountCurve.discount(dates[i]);
+        }
+        return basisPoint_*bps/discountCurve.discount(leg.npvDate());
+    }
+
+    Real CashFlows::npv(const LegSnapshot& leg,
+                        const InterestRate& y) {
+        if (leg.empty())
+            return 0.0;
+
+        checkDayCounter(leg, y);
+
+        const std::vector<Real>& amounts = leg.amounts();
+        const std::vector<Time>& periods = leg.periods();
+
+        Real npv = 0.0;
+        DiscountFactor discount = 1.0;
+        for (Size i=0; i<amounts.size(); ++i) {
+            discount *= y.discountFactor(periods[i]);
+            npv += amounts[i] * discount;
+        }
+
+        return npv;
+    }
+
+    Real CashFlows::bps(const LegSnapshot& leg,
+                        const InterestRate& yield) {
+        if (leg.empty())
+            return 0.0;
+
+        FlatForward flatRate(leg.settlementDate(), yield.rate(),
+                             yield.dayCounter(), yield.compounding(),
+                             yield.frequency());
+        return bps(leg, flatRate);
+    }
+
+    Rate CashFlows::yield(const LegSnapshot& leg,
+                          Real npv,
+                          Compounding compounding,
+                          Frequency frequency,
+                          Real accuracy,
+                          Size maxIterations,
+                          Rate guess) {
+        NewtonSafe solver;
+        solver.setMaxEvaluations(maxIterations);
+        return CashFlows::yield<NewtonSafe>(solver, leg, npv,
+                                            compounding, frequency,
+                                            accuracy, guess);
+    }
+
+    Time CashFlows::duration(const LegSnapshot& leg,
+                             const InterestRate& rate,
+                             Duration::Type type) {
+        switch (type) {
+          case Duration::Simple:
+            return simpleDuration(leg, rate);
+          case Duration::Modified:
+            return modifiedDuration(leg, rate);
+          case Duration::Macaulay:
+            return macaulayDuration(leg, rate);
+          default:
+            QL_FAIL("unknown duration type");
+        }
+    }
+
+    Real CashFlows::convexity(const LegSnapshot& leg,
+                              const InterestRate& y) {
+        if (leg.empty())
+            return 0.0;
+
+        checkDayCounter(leg, y);
+
+        const std::vector<Real>& amounts = leg.amounts();
+        const std::vector<Time>& times = leg.times();
 
         Real P = 0.0;
-        Time t = 0.0;
         Real d2Pdy2 = 0.0;
         Rate r = y.rate();
         Natural N = y.frequency();
-        Date lastDate = npvDate;
-        for (const auto& i : leg) {
-            if (i->hasOccurred(settlementDate, includeSettlementDateFlows))
-                continue;
-
-            Real c = i->amount();
-            if (i->tradingExCoupon(settlementDate)) {
-                c = 0.0;
-            }
-
-            t += getStepwiseDiscountTime(i, dc, npvDate, lastDate);
+        for (Size i=0; i<amounts.size(); ++i) {
+            Real c = amounts[i];
+            Time t = times[i];
             DiscountFactor B = y.discountFactor(t);
             P += c * B;
             switch (y.compounding()) {
@@ -1025,7 +1052,6 @@ namespace QuantLib {
                 QL_FAIL("unknown compounding convention (" <<
                         Integer(y.compounding()) << ")");
             }
-            lastDate = i->date();
         }
 
         if (P == 0.0)
@@ -1035,44 +1061,15 @@ namespace QuantLib {
         return d2Pdy2/P;
     }
 
-
-    Real CashFlows::convexity(const Leg& leg,
-                              Rate yield,
-                              const DayCounter& dc,
-                              Compounding comp,
-                              Frequency freq,
-                              bool includeSettlementDateFlows,
-                              Date settlementDate,
-                              Date npvDate) {
-        return convexity(leg, InterestRate(yield, dc, comp, freq),
-                         includeSettlementDateFlows,
-                         settlementDate, npvDate);
-    }
-
-    Real CashFlows::basisPointValue(const Leg& leg,
-                                    const InterestRate& y,
-                                    bool includeSettlementDateFlows,
-                                    Date settlementDate,
-                                    Date npvDate) {
+    Real CashFlows::basisPointValue(const LegSnapshot& leg,
+                                    const InterestRate& y) {
         if (leg.empty())
             return 0.0;
 
-        if (settlementDate == Date())
-            settlementDate = Settings::instance().evaluationDate();
-
-        if (npvDate == Date())
-            npvDate = settlementDate;
-
-        Real npv = CashFlows::npv(leg, y,
-                                  includeSettlementDateFlows,
-                                  settlementDate, npvDate);
+        Real npv = CashFlows::npv(leg, y);
         Real modifiedDuration = CashFlows::duration(leg, y,
-                                                    Duration::Modified,
-                                                    includeSettlementDateFlows,
-                                                    settlementDate, npvDate);
-        Real convexity = CashFlows::convexity(leg, y,
-                                              includeSettlementDateFlows,
-                                              settlementDate, npvDate);
+                                                    Duration::Modified);
+        Real convexity = CashFlows::convexity(leg, y);
         Real delta = -modifiedDuration*npv;
         Real gamma = (convexity/100.0)*npv;
 
@@ -1083,58 +1080,19 @@ namespace QuantLib {
         return delta + 0.5*gamma;
     }
 
-    Real CashFlows::basisPointValue(const Leg& leg,
-                                    Rate yield,
-                                    const DayCounter& dc,
-                                    Compounding comp,
-                                    Frequency freq,
-                                    bool includeSettlementDateFlows,
-                                    Date settlementDate,
-                                    Date npvDate) {
-        return basisPointValue(leg, InterestRate(yield, dc, comp, freq),
-                               includeSettlementDateFlows,
-                               settlementDate, npvDate);
-    }
-
-    Real CashFlows::yieldValueBasisPoint(const Leg& leg,
-                                         const InterestRate& y,
-                                         bool includeSettlementDateFlows,
-                                         Date settlementDate,
-                                         Date npvDate) {
+    Real CashFlows::yieldValueBasisPoint(const LegSnapshot& leg,
+                                         const InterestRate& y) {
         if (leg.empty())
             return 0.0;
 
-        if (settlementDate == Date())
-            settlementDate = Settings::instance().evaluationDate();
-
-        if (npvDate == Date())
-            npvDate = settlementDate;
-
-        Real npv = CashFlows::npv(leg, y,
-                                  includeSettlementDateFlows,
-                                  settlementDate, npvDate);
+        Real npv = CashFlows::npv(leg, y);
         Real modifiedDuration = CashFlows::duration(leg, y,
-                                                    Duration::Modified,
-                                                    includeSettlementDateFlows,
-                                                    settlementDate, npvDate);
+                                                    Duration::Modified);
 
         Real shift = 0.01;
         return (1.0/(-npv*modifiedDuration))*shift;
     }
 
-    Real CashFlows::yieldValueBasisPoint(const Leg& leg,
-                                         Rate yield,
-                                         const DayCounter& dc,
-                                         Compounding comp,
-                                         Frequency freq,
-                                         bool includeSettlementDateFlows,
-                                         Date settlementDate,
-                                         Date npvDate) {
-        return yieldValueBasisPoint(leg, InterestRate(yield, dc, comp, freq),
-                                    includeSettlementDateFlows,
-                                    settlementDate, npvDate);
-    }
-
     // Z-spread utility functions
     namespace {
 
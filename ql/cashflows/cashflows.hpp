@@ -28,6 +28,7 @@
 #define quantlib_cashflows_hpp
 
 #include <ql/cashflows/duration.hpp>
+#include <ql/cashflows/legsnapshot.hpp>
 #include <ql/cashflow.hpp>
 #include <ql/interestrate.hpp>
 #include <ql/shared_ptr.hpp>
@@ -42,27 +43,20 @@ namespace QuantLib {
       private:
         class IrrFinder {
           public:
-            IrrFinder(const Leg& leg,
+            IrrFinder(const LegSnapshot& leg,
                       Real npv,
-                      DayCounter dayCounter,
                       Compounding comp,
-                      Frequency freq,
-                      bool includeSettlementDateFlows,
-                      Date settlementDate,
-                      Date npvDate);
+                      Frequency freq);
 
             Real operator()(Rate y) const;
             Real derivative(Rate y) const;
           private:
             void checkSign() const;
 
-            const Leg& leg_;
+            const LegSnapshot& leg_;
             Real npv_;
-            DayCounter dayCounter_;
             Compounding compounding_;
             Frequency frequency_;
-            bool includeSettlementDateFlows_;
-            Date settlementDate_, npvDate_;
         };
       public:
         CashFlows() = delete;
@@ -284,10 +278,10 @@ namespace QuantLib {
                           Date npvDate = Date(),
                           Real accuracy = 1.0e-10,
                           Rate guess = 0.05) {
-            IrrFinder objFunction(leg, npv, dayCounter, compounding,
-                                  frequency, includeSettlementDateFlows,
-                                  settlementDate, npvDate);
-            return solver.solve(objFunction, accuracy, guess, guess/10.0);
+            LegSnapshot snapshot(leg, dayCounter, includeSettlementDateFlows,
+                                 settlementDate, npvDate);
+            return yield<Solver>(solver, snapshot, npv, compounding,
+                                 frequency, accuracy, guess);
         }
 
         //! Cash-flow duration.
@@ -390,6 +384,52 @@ namespace QuantLib {
                                          Date npvDate = Date());
         //@}
 
+        //! \name LegSnapshot functions
+        /*! These overloads perform the same calculations as the
+            ones above on a pre-flattened leg, so that the cash flows
+            don't need to be inspected again at each call.  Settlement
+            and npv dates are the ones used for building the snapshot;
+            yield-based functions require the snapshot to have been
+            built with the day counter of the passed yield.
+        */
+        //@{
+        static Real npv(const LegSnapshot& leg,
+                        const YieldTermStructure& discountCurve);
+        static Real bps(const LegSnapshot& leg,
+                        const YieldTermStructure& discountCurve);
+        static Real npv(const LegSnapshot& leg,
+                        const InterestRate& yield);
+        static Real bps(const LegSnapshot& leg,
+                        const InterestRate& yield);
+        static Rate yield(const LegSnapshot& leg,
+                          Real npv,
+                          Compounding compounding,
+                          Frequency frequency,
+                          Real accuracy = 1.0e-10,
+                          Size maxIterations = 100,
+                          Rate guess = 0.05);
+        template <typename Solver>
+        static Rate yield(const Solver& solver,
+                          const LegSnapshot& leg,
+                          Real npv,
+                          Compounding compounding,
+                          Frequency frequency,
+                          Real accuracy = 1.0e-10,
+                          Rate guess = 0.05) {
+            IrrFinder objFunction(leg, npv, compounding, frequency);
+            return solver.solve(objFunction, accuracy, guess, guess/10.0);
+        }
+        static Time duration(const LegSnapshot& leg,
+                             const InterestRate& yield,
+                             Duration::Type type);
+        static Real convexity(const LegSnapshot& leg,
+                              const InterestRate& yield);
+        static Real basisPointValue(const LegSnapshot& leg,
+                                    const InterestRate& yield);
+        static Real yieldValueBasisPoint(const LegSnapshot& leg,
+                                         const InterestRate& yield);
+        //@}
+
         //! \name Z-spread functions
         /*! For details on z-spread refer to:
             "Credit Spreads Explained", Lehman Brothers European Fixed
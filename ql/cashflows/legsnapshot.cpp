@@ -0,0 +1,125 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/cashflows/legsnapshot.hpp>
+#include <ql/cashflows/coupon.hpp>
+#include <ql/settings.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace QuantLib {
+
+    namespace {
+
+        // time-to-discount of a cash flow from the previous one, as
+        // used when discount factors are calculated stepwise
+        Time stepwiseDiscountTime(const CashFlow& cashFlow,
+                                  const Coupon* coupon,
+                                  const DayCounter& dc,
+                                  Date npvDate,
+                                  Date lastDate) {
+            Date cashFlowDate = cashFlow.date();
+            Date refStartDate, refEndDate;
+            if (coupon != nullptr) {
+                refStartDate = coupon->referencePeriodStart();
+                refEndDate = coupon->referencePeriodEnd();
+            } else {
+                if (lastDate == npvDate) {
+                    // we don't have a previous coupon date,
+                    // so we fake it
+                    refStartDate = cashFlowDate - 1*Years;
+                } else  {
+                    refStartDate = lastDate;
+                }
+                refEndDate = cashFlowDate;
+            }
+
+            if ((coupon != nullptr) && lastDate != coupon->accrualStartDate()) {
+                Time couponPeriod = dc.yearFraction(coupon->accrualStartDate(),
+                                                cashFlowDate, refStartDate, refEndDate);
+                Time accruedPeriod = dc.yearFraction(coupon->accrualStartDate(),
+                                                lastDate, refStartDate, refEndDate);
+                return couponPeriod - accruedPeriod;
+            } else {
+                return dc.yearFraction(lastDate, cashFlowDate,
+                                       refStartDate, refEndDate);
+            }
+        }
+
+        struct CashFlowLater {
+            bool operator()(const ext::shared_ptr<CashFlow> &c,
+                            const ext::shared_ptr<CashFlow> &d) {
+                return c->date() > d->date();
+            }
+        };
+
+    }
+
+    LegSnapshot::LegSnapshot(const Leg& leg,
+                             DayCounter dayCounter,
+                             bool includeSettlementDateFlows,
+                             Date settlementDate,
+                             Date npvDate)
+    : dayCounter_(std::move(dayCounter)),
+      settlementDate_(settlementDate), npvDate_(npvDate) {
+
+        if (settlementDate_ == Date())
+            settlementDate_ = Settings::instance().evaluationDate();
+
+        if (npvDate_ == Date())
+            npvDate_ = settlementDate_;
+
+#if defined(QL_EXTRA_SAFETY_CHECKS)
+        QL_REQUIRE(std::adjacent_find(leg.begin(), leg.end(),
+                                      CashFlowLater()) == leg.end(),
+                   "cashflows must be sorted in ascending order w.r.t. their payment dates");
+#endif
+
+        dates_.reserve(leg.size());
+        amounts_.reserve(leg.size());
+        bpsFactors_.reserve(leg.size());
+        if (!dayCounter_.empty()) {
+            periods_.reserve(leg.size());
+            times_.reserve(leg.size());
+        }
+
+        Time t = 0.0;
+        Date lastDate = npvDate_;
+        for (const auto& cf : leg) {
+            if (cf->hasOccurred(settlementDate_, includeSettlementDateFlows))
+                continue;
+
+            const auto* coupon = dynamic_cast<const Coupon*>(cf.get());
+            bool exCoupon = cf->tradingExCoupon(settlementDate_);
+
+            dates_.push_back(cf->date());
+            amounts_.push_back(exCoupon ? 0.0 : cf->amount());
+            bpsFactors_.push_back((coupon != nullptr && !exCoupon) ?
+                                  coupon->nominal() * coupon->accrualPeriod() :
+                                  0.0);
+            if (!dayCounter_.empty()) {
+                Time dt = stepwiseDiscountTime(*cf, coupon, dayCounter_,
+                                               npvDate_, lastDate);
+                t += dt;
+                periods_.push_back(dt);
+                times_.push_back(t);
+            }
+            lastDate = cf->date();
+        }
+    }
+
+}
@@ -0,0 +1,99 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file legsnapshot.hpp
+    \brief Flattened representation of the live cash flows of a leg
+*/
+
+#ifndef quantlib_leg_snapshot_hpp
+#define quantlib_leg_snapshot_hpp
+
+#include <ql/cashflow.hpp>
+#include <ql/time/daycounter.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Flattened snapshot of the live cash flows of a leg
+    /*! The snapshot extracts, once and for all, the data needed by
+        the CashFlows analytics from the cash flows that did not
+        occur at the given settlement date: payment dates, amounts,
+        basis-point sensitivities and, if a day counter is given, the
+        stepwise discount times used by the yield-based functions.
+        The latter can then run over contiguous arrays without
+        virtual calls, which is convenient when they are called
+        repeatedly, e.g., inside a solver.
+
+        Cash flows trading ex-coupon are kept with a null amount so
+        that the stepwise discount times are not affected.
+
+        \warning The amounts are read when the snapshot is built;
+                 floating-rate coupons are not re-projected if their
+                 forecasting curves change afterwards, so a new
+                 snapshot must be built in that case.
+    */
+    class LegSnapshot {
+      public:
+        explicit LegSnapshot(const Leg& leg,
+                             DayCounter dayCounter = DayCounter(),
+                             bool includeSettlementDateFlows = false,
+                             Date settlementDate = Date(),
+                             Date npvDate = Date());
+        //! \name Inspectors
+        //@{
+        Size size() const { return dates_.size(); }
+        bool empty() const { return dates_.empty(); }
+        const DayCounter& dayCounter() const { return dayCounter_; }
+        Date settlementDate() const { return settlementDate_; }
+        Date npvDate() const { return npvDate_; }
+        //! payment dates of the live cash flows
+        const std::vector<Date>& dates() const { return dates_; }
+        //! amounts of the live cash flows (null if trading ex-coupon)
+        const std::vector<Real>& amounts() const { return amounts_; }
+        //! nominal times accrual period for live coupons, null otherwise
+        const std::vector<Real>& bpsFactors() const { return bpsFactors_; }
+        //! discount time between each cash flow and the previous one
+        const std::vector<Time>& periods() const;
+        //! cumulated discount times from the npv date
+        const std::vector<Time>& times() const;
+        //@}
+      private:
+        DayCounter dayCounter_;
+        Date settlementDate_, npvDate_;
+        std::vector<Date> dates_;
+        std::vector<Real> amounts_, bpsFactors_;
+        std::vector<Time> periods_, times_;
+    };
+
+
+    // inline definitions
+
+    inline const std::vector<Time>& LegSnapshot::periods() const {
+        QL_REQUIRE(!dayCounter_.empty(),
+                   "no day counter given for leg snapshot");
+        return periods_;
+    }
+
+    inline const std::vector<Time>& LegSnapshot::times() const {
+        QL_REQUIRE(!dayCounter_.empty(),
+                   "no day counter given for leg snapshot");
+        return times_;
+    }
+
+}
+
+#endif
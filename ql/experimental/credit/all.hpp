@@ -17,6 +17,7 @@
 #include <ql/experimental/credit/defaulttype.hpp>
 #include <ql/experimental/credit/distribution.hpp>
 #include <ql/experimental/credit/factorspreadedhazardratecurve.hpp>
+#include <ql/experimental/credit/fftpoollossmodel.hpp>
 #include <ql/experimental/credit/gaussianlhplossmodel.hpp>
 #include <ql/experimental/credit/homogeneouspooldef.hpp>
 #include <ql/experimental/credit/inhomogeneouspooldef.hpp>
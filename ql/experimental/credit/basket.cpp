@@ -108,10 +108,9 @@ namespace QuantLib {
 
     Disposable<vector<Real> > Basket::probabilities(const Date& d) const {
         vector<Real> prob(size());
-        vector<DefaultProbKey> defKeys = defaultKeys();
         for (Size j = 0; j < size(); j++)
-            prob[j] = pool_->get(pool_->names()[j]).defaultProbability(
-                defKeys[j])->defaultProbability(d);
+            prob[j] = pool_->get(j).defaultProbability(
+                pool_->defaultKey(j))->defaultProbability(d);
         return prob;
     }
 
@@ -121,8 +120,8 @@ namespace QuantLib {
         Real loss = 0.0;
         for (Size i = 0; i < size(); i++) {
             ext::shared_ptr<DefaultEvent> credEvent =
-                pool_->get(pool_->names()[i]).defaultedBetween(refDate_,
-                    endDate, pool_->defaultKeys()[i]);
+                pool_->get(i).defaultedBetween(refDate_,
+                    endDate, pool_->defaultKey(i));
             if (credEvent != nullptr) {
                 /* \todo If the event has not settled one would need to 
                 introduce some model recovery rate (independently of a loss 
@@ -131,9 +130,9 @@ namespace QuantLib {
                 if(credEvent->hasSettled())
                     loss += claim_->amount(credEvent->date(),
                             // notionals_[i],
-                            exposure(pool_->names()[i], credEvent->date()),
+                            exposure(i, credEvent->date()),
                             credEvent->settlement().recoveryRate(
-                                pool_->defaultKeys()[i].seniority()));
+                                pool_->defaultKey(i).seniority()));
             }
         }
         return loss;
@@ -146,18 +145,18 @@ namespace QuantLib {
         Real loss = 0.0;
         for (Size i = 0; i < size(); i++) {
             ext::shared_ptr<DefaultEvent> credEvent =
-                pool_->get(pool_->names()[i]).defaultedBetween(refDate_,
-                    endDate, pool_->defaultKeys()[i]);
+                pool_->get(i).defaultedBetween(refDate_,
+                    endDate, pool_->defaultKey(i));
             if (credEvent != nullptr) {
                 if(credEvent->hasSettled()) {
                     loss += claim_->amount(credEvent->date(),
                             //notionals_[i],
-                            exposure(pool_->names()[i], credEvent->date()),
+                            exposure(i, credEvent->date()),
                             //NOtice I am requesting an exposure in the past...
                             /* also the seniority does not belong to the 
                             counterparty anymore but to the position.....*/
                             credEvent->settlement().recoveryRate(
-                                pool_->defaultKeys()[i].seniority()));
+                                pool_->defaultKey(i).seniority()));
                 }
             }
         }
@@ -172,10 +171,10 @@ namespace QuantLib {
         Basket::liveList(const Date& endDate) const {
         std::vector<Size> calcBufferLiveList;
         for (Size i = 0; i < size(); i++)
-            if (!pool_->get(pool_->names()[i]).defaultedBetween(
+            if (!pool_->get(i).defaultedBetween(
                     refDate_,
                     endDate,
-                    pool_->defaultKeys()[i]))
+                    pool_->defaultKey(i)))
                 calcBufferLiveList.push_back(i);
 
         return calcBufferLiveList;
@@ -183,11 +182,10 @@ namespace QuantLib {
 
     Real Basket::remainingNotional(const Date& endDate) const {
         Real notional = 0;
-        vector<DefaultProbKey> defKeys = defaultKeys();
         for (Size i = 0; i < size(); i++) {
-            if (!pool_->get(pool_->names()[i]).defaultedBetween(refDate_,
-                                                        endDate,
-                                                        defKeys[i]))
+            if (!pool_->get(i).defaultedBetween(refDate_,
+                                                endDate,
+                                                pool_->defaultKey(i)))
                 notional += notionals_[i];
         }
         return notional;
@@ -201,10 +199,9 @@ namespace QuantLib {
 
         std::vector<Real> calcBufferNotionals;
         const std::vector<Size>& alive = liveList(endDate);
-        for(Size i=0; i<alive.size(); i++)
-            calcBufferNotionals.push_back(
-                exposure(pool_->names()[i], endDate)
-                );// some better way to trim it? 
+        calcBufferNotionals.reserve(alive.size());
+        for (unsigned long i : alive)
+            calcBufferNotionals.push_back(exposure(i, endDate));
         return calcBufferNotionals;
     }
 
@@ -214,35 +211,25 @@ namespace QuantLib {
         QL_REQUIRE(d >= refDate_, "Target date lies before basket inception");
         vector<Real> prob;
         const std::vector<Size>& alive = liveList();
-
-        for(Size i=0; i<alive.size(); i++)
-            prob.push_back(pool_->get(pool_->names()[i]).defaultProbability(
-                pool_->defaultKeys()[i])->defaultProbability(d, true));
+        prob.reserve(alive.size());
+        for (unsigned long i : alive)
+            prob.push_back(pool_->get(i).defaultProbability(
+                pool_->defaultKey(i))->defaultProbability(d, true));
         return prob;
     }
 
     /* It is supossed to return the addition of ALL notionals from the 
     requested ctpty......*/
     Real Basket::exposure(const std::string& name, const Date& d) const {
-        //'this->names_' contains duplicates, contrary to 'pool->names'
-        auto match = std::find(pool_->names().begin(), pool_->names().end(), name);
-        QL_REQUIRE(match != pool_->names().end(), "Name not in basket.");
-        Real totalNotional = 0.;
-        do{
-            totalNotional += 
-             // NOT IMPLEMENTED YET:
-    //positions_[std::distance(names_.begin(), match)]->expectedExposure(d);
-                notionals_[std::distance(pool_->names().begin(), match)];
-            ++match;
-            match = std::find(match, pool_->names().end(), name);
-        }while(match != pool_->names().end());
-
-        return totalNotional;
-        //Size position = std::distance(poolNames.begin(), 
-        //    std::find(poolNames.begin(), poolNames.end(), name));
-        //QL_REQUIRE(position < pool_->size(), "Name not in pool list");
-
-        //return positions_[position]->expectedExposure(d);
+        QL_REQUIRE(pool_->has(name), "Name not in basket.");
+        return exposure(pool_->index(name), d);
+    }
+
+    Real Basket::exposure(Size iName, const Date&) const {
+        // names in the pool are unique, so there's one notional per name
+        // NOT IMPLEMENTED YET:
+        //return positions_[iName]->expectedExposure(d);
+        return notionals_[iName];
     }
 
     Disposable<std::vector<std::string> >
@@ -270,7 +257,7 @@ namespace QuantLib {
         vector<DefaultProbKey> defKeys;
         defKeys.reserve(alive.size());
         for (unsigned long i : alive)
-            defKeys.push_back(pool_->defaultKeys()[i]);
+            defKeys.push_back(pool_->defaultKey(i));
         return defKeys;
     }
 
@@ -373,7 +360,7 @@ namespace QuantLib {
     Real Basket::recoveryRate(const Date& d, Size iName) const {
         calculate();
         return 
-            lossModel_->expectedRecovery(d, iName, pool_->defaultKeys()[iName]);
+            lossModel_->expectedRecovery(d, iName, pool_->defaultKey(iName));
     }
 
 }
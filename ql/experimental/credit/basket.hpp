@@ -100,10 +100,12 @@ namespace QuantLib {
         Real notional() const;
         //! Returns the total expected exposures for that name.
         Real exposure(const std::string& name, const Date& = Date()) const;
+        //! Returns the total expected exposures for the i-th name.
+        Real exposure(Size iName, const Date& = Date()) const;
         //! Underlying pool
         const ext::shared_ptr<Pool>& pool() const;
         //! The keys each counterparty enters the basket with (sensitive to)
-        Disposable<std::vector<DefaultProbKey> > defaultKeys() const;
+        const std::vector<DefaultProbKey>& defaultKeys() const;
         /*! Loss Given Default for all issuers/notionals based on
             expected recovery rates for the respective issuers.
         */
@@ -329,8 +331,7 @@ namespace QuantLib {
         return notionals_;
     }
 
-    inline Disposable<std::vector<DefaultProbKey> > 
-        Basket::defaultKeys() const {
+    inline const std::vector<DefaultProbKey>& Basket::defaultKeys() const {
         return pool_->defaultKeys();
     }
 
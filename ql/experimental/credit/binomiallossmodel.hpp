@@ -175,11 +175,9 @@ namespace QuantLib {
             std::accumulate(lgdsLeft.begin(), lgdsLeft.end(), Real(0.)) /
                 bsktSize;
 
-        std::vector<Probability> condDefProb(bsktSize, 0.);
-        for(Size j=0; j<bsktSize; j++)//transform
-            condDefProb[j] = 
-                copula_->conditionalDefaultProbabilityInvP(uncondDefProbInv[j],
-                    j, mktFactors);
+        std::vector<Probability> condDefProb;
+        copula_->conditionalDefaultProbabilitiesInvP(uncondDefProbInv,
+            mktFactors, condDefProb);
         // of full portfolio:
         Real avgProb = avgLgd <= QL_EPSILON ? 0. : // only if all are 0
                 std::inner_product(condDefProb.begin(), 
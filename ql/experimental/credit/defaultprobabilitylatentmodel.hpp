@@ -58,6 +58,10 @@ namespace QuantLib {
         ext::shared_ptr<LMIntegration> integration_;
     private:
         typedef typename copulaPolicy::initTraits initTraits;
+        // inverted remaining probabilities, see inverseRemainingProbabilities
+        mutable Date invProbsDate_;
+        mutable std::vector<Probability> remainingProbs_;
+        mutable std::vector<Real> invRemainingProbs_;
     public:
         /*!
         @param factorWeights Latent model independent factors weights for each 
@@ -99,6 +103,7 @@ namespace QuantLib {
             // in the future change 'size' to 'liveSize'
             QL_REQUIRE(basket_->size() == factorWeights_.size(), 
                 "Incompatible new basket and model sizes.");
+            invProbsDate_ = Date();
         }
 
         /*! Returns the probability of default of a given name conditional on
@@ -129,6 +134,7 @@ namespace QuantLib {
         }
     protected:
       void update() override {
+          invProbsDate_ = Date();
           if (basket_ != nullptr)
               basket_->notifyObservers();
           LatentModel<copulaPolicy>::update();
@@ -163,6 +169,61 @@ namespace QuantLib {
         
             return res;
         }
+
+        /*! Batch version of the method above, for loss models evaluating all
+        the names at each integration node. Returns in condProbs the
+        conditional default probabilities of the first invCumYProbs.size()
+        names; the factor projections are computed in a first pass over the
+        names and the copula cumulative is applied in a second one, and the
+        output buffer can be reused across nodes.
+        @param invCumYProbs Inverse cumul of the unconditional probabilities
+          of default of each name.
+        @param m Value of LM independent factors.
+        @param condProbs Output conditional probabilities.
+        */
+        void conditionalDefaultProbabilitiesInvP(
+            const std::vector<Real>& invCumYProbs,
+            const std::vector<Real>& m,
+            std::vector<Probability>& condProbs) const {
+            const Size nNames = invCumYProbs.size();
+            condProbs.resize(nNames);
+            for(Size iName=0; iName<nNames; iName++)
+                condProbs[iName] = (invCumYProbs[iName] -
+                    std::inner_product(factorWeights_[iName].begin(),
+                        factorWeights_[iName].end(), m.begin(), 0.))
+                    / idiosyncFctrs_[iName];
+            for(Size iName=0; iName<nNames; iName++) {
+                condProbs[iName] = cumulativeZ(condProbs[iName]);
+                #if defined(QL_EXTRA_SAFETY_CHECKS)
+                QL_REQUIRE (condProbs[iName] >= 0. && condProbs[iName] <= 1.,
+                            "conditional probability " << condProbs[iName] <<
+                            "out of range");
+                #endif
+            }
+        }
+
+        /*! Inverse cumul of the unconditional default probabilities of the
+        remaining names in the basket at the given date, to be passed to the
+        methods above. The last inversion is kept and reused while the date
+        and the probabilities do not change; loss models typically call this
+        repeatedly with the same date when solving for a statistic.
+        */
+        Disposable<std::vector<Real> > inverseRemainingProbabilities(
+            const Date& d) const {
+            QL_REQUIRE(basket_, "No portfolio basket set.");
+            std::vector<Probability> probs = 
+                basket_->remainingProbabilities(d);
+            if(d != invProbsDate_ || probs != remainingProbs_) {
+                invRemainingProbs_.resize(probs.size());
+                for(Size iName=0; iName<probs.size(); iName++)
+                    invRemainingProbs_[iName] = 
+                        inverseCumulativeY(probs[iName], iName);
+                remainingProbs_.swap(probs);
+                invProbsDate_ = d;
+            }
+            std::vector<Real> invProbs(invRemainingProbs_);
+            return invProbs;
+        }
     protected:
         /*! Returns the probability of default of a given name conditional on
         the realization of a given set of values of the model independent
@@ -181,7 +242,7 @@ namespace QuantLib {
         {
             const ext::shared_ptr<Pool>& pool = basket_->pool();
             Probability pDefUncond =
-                pool->get(pool->names()[iName]).
+                pool->get(iName).
                 defaultProbability(basket_->defaultKeys()[iName])
                   ->defaultProbability(date);
             return conditionalDefaultProbability(pDefUncond, iName, mktFactors);
@@ -212,7 +273,7 @@ namespace QuantLib {
             QL_REQUIRE(basket_, "No portfolio basket set.");
             const ext::shared_ptr<Pool>& pool = basket_->pool();
             // avoid repeating this in the integration:
-            Probability pUncond = pool->get(pool->names()[iName]).
+            Probability pUncond = pool->get(iName).
                 defaultProbability(basket_->defaultKeys()[iName])
                 ->defaultProbability(d);
             if (pUncond < 1.e-10) return 0.;
@@ -253,10 +314,10 @@ namespace QuantLib {
 
         const ext::shared_ptr<Pool>& pool = basket_->pool();
         // unconditionals:
-        Probability pi = pool->get(pool->names()[iNamei]).
+        Probability pi = pool->get(iNamei).
             defaultProbability(basket_->defaultKeys()[iNamei])
             ->defaultProbability(d);
-        Probability pj = pool->get(pool->names()[iNamej]).
+        Probability pj = pool->get(iNamej).
             defaultProbability(basket_->defaultKeys()[iNamej])
             ->defaultProbability(d);
         Real pipj = pi * pj;
@@ -298,7 +359,7 @@ namespace QuantLib {
             std::vector<Probability> pDefCond;
             for(Size i=0; i<poolSize; i++)
                 pDefCond.push_back(conditionalDefaultProbability(
-                    pool->get(pool->names()[i]).
+                    pool->get(i).
                     defaultProbability(basket_->defaultKeys()[i])->
                     defaultProbability(date), i, mktFactors));
 
@@ -0,0 +1,349 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fftpoollossmodel.hpp
+    \brief Pool loss distribution by Fourier inversion
+*/
+
+#ifndef quantlib_fft_pool_loss_model_hpp
+#define quantlib_fft_pool_loss_model_hpp
+
+#include <ql/experimental/credit/basket.hpp>
+#include <ql/experimental/credit/constantlosslatentmodel.hpp>
+#include <ql/experimental/credit/defaultlossmodel.hpp>
+#include <ql/math/fastfouriertransform.hpp>
+#include <complex>
+#include <map>
+
+namespace QuantLib {
+
+    //-------------------------------------------------------------------------
+    //! Default loss distribution of large non homogeneous pools by FFT
+    /*! The loss given default of each name is rounded to a multiple
+        \f$ k_i \f$ of a loss unit \f$ u \f$, chosen so that the tranche
+        detachment amount spans the given number of buckets. Conditional
+        on the latent factors \f$ m \f$ the names are independent and the
+        discrete Fourier transform of the pool loss distribution is
+        \f[
+        \hat{P}_j(m) = \prod_i \left(1 - p_i(m) + p_i(m)\,
+            e^{-2\pi i\,j k_i/M}\right)
+        \f]
+        where the transform size \f$ M \f$ exceeds the largest attainable
+        loss in units, so that there is no aliasing. The transform is linear
+        in the conditional distribution; thus, it is integrated over the
+        factors with the latent model integration and inverted only once
+        per date, instead of convolving the names at every integration node
+        as the bucketing algorithms do. The distributions at several dates
+        can be obtained from the same integration through
+        computeDistributions.
+
+        The distributions are kept and reused while the unconditional
+        default probabilities of the names at the given date do not change
+        and the latent model does not notify a change.
+
+        \warning The losses of the names are rounded to the loss unit; the
+                 number of buckets should be large enough for the smallest
+                 exposures in the pool to be resolved.
+    */
+    template<class copulaPolicy>
+    class FFTPoolLossModel : public DefaultLossModel, public Observer {
+      private:
+        void resetModel() override;
+
+      public:
+        // allow base correlations:
+        typedef copulaPolicy copulaType;
+
+        FFTPoolLossModel(
+            // restricted to non random recoveries
+            const ext::shared_ptr<ConstantLossLatentmodel<copulaPolicy> >&
+                copula,
+            Size nBuckets)
+        : copula_(copula), nBuckets_(nBuckets) {
+            QL_REQUIRE(nBuckets_ > 0, "null number of buckets given");
+            registerWith(copula_);
+        }
+
+        void update() override {
+            distributions_.clear();
+            notifyObservers();
+        }
+
+        /*! Computes the loss distributions at the given dates in a single
+            integration over the latent factors. The statistics below reuse
+            them when asked for any of these dates.
+        */
+        void computeDistributions(const std::vector<Date>& dates) const;
+        //! loss unit of the distribution grid
+        Real lossUnit() const { return lossUnit_; }
+
+        Real expectedTrancheLoss(const Date& d) const override;
+        Probability probOverLoss(const Date& d,
+                                 Real lossFraction) const override;
+        Real percentile(const Date& d, Real percentile) const override;
+        Real expectedShortfall(const Date& d,
+                               Probability percentile) const override;
+        Disposable<std::map<Real, Probability> >
+            lossDistribution(const Date& d) const override;
+
+      protected:
+        /*! Probabilities of the portfolio losses \f$ n u \f$ for \f$ n \f$
+            below the number of buckets; the missing probability mass
+            corresponds to losses over the detachment amount.
+        */
+        const std::vector<Probability>& lossProbabilities(
+                                                       const Date& d) const;
+        Real trancheLoss(Size n) const {
+            return std::min(std::max(n * lossUnit_ - attachAmount_, 0.),
+                            detachAmount_ - attachAmount_);
+        }
+
+        const ext::shared_ptr<ConstantLossLatentmodel<copulaPolicy> > copula_;
+        Size nBuckets_;
+        mutable Real attachAmount_, detachAmount_, lossUnit_;
+        // losses given default in loss units
+        mutable std::vector<Size> units_;
+        mutable Size fftOrder_;
+        // roots of unity e^{-2 \pi i t/M}
+        mutable std::vector<std::complex<Real> > roots_;
+
+      private:
+        /* Transforms of the conditional loss distributions at each of the
+           dates; real and imaginary parts of the non redundant frequencies
+           are stored consecutively.
+        */
+        Disposable<std::vector<Real> > conditionalTransforms(
+            const std::vector<std::vector<Real> >& invProbs,
+            const std::vector<Real>& mktFactors) const;
+        // unconditional probabilities and loss probabilities per date
+        mutable std::map<Date, std::pair<std::vector<Probability>,
+                                         std::vector<Probability> > >
+            distributions_;
+    };
+
+    typedef FFTPoolLossModel<GaussianCopulaPolicy> FFTGaussPoolLossModel;
+    typedef FFTPoolLossModel<TCopulaPolicy> FFTStudentPoolLossModel;
+
+    //-----------------------------------------------------------------------
+
+    template<class CP>
+    void FFTPoolLossModel<CP>::resetModel() {
+        attachAmount_ = basket_->remainingAttachmentAmount();
+        detachAmount_ = basket_->remainingDetachmentAmount();
+        QL_REQUIRE(detachAmount_ > 0., "null tranche detachment amount");
+        lossUnit_ = detachAmount_ / nBuckets_;
+
+        std::vector<Real> notionals = basket_->remainingNotionals();
+        const std::vector<Real>& recoveries = copula_->recoveries();
+        units_.resize(notionals.size());
+        Size maxUnits = 0;
+        for(Size iName=0; iName<notionals.size(); iName++) {
+            units_[iName] = static_cast<Size>(std::floor(
+                notionals[iName] * (1.-recoveries[iName]) / lossUnit_ + .5));
+            maxUnits += units_[iName];
+        }
+        // the grid has to hold the largest attainable loss
+        fftOrder_ = std::max<Size>(
+            FastFourierTransform::min_order(maxUnits + 1), 1);
+        const Size m = static_cast<Size>(1) << fftOrder_;
+        roots_.resize(m);
+        for(Size t=0; t<m; t++)
+            roots_[t] = std::polar(1., -2. * M_PI * t / m);
+
+        distributions_.clear();
+        copula_->resetBasket(basket_.currentLink());
+    }
+
+    template<class CP>
+    Disposable<std::vector<Real> >
+    FFTPoolLossModel<CP>::conditionalTransforms(
+        const std::vector<std::vector<Real> >& invProbs,
+        const std::vector<Real>& mktFactors) const
+    {
+        const Size m = roots_.size();
+        const Size nFreqs = m/2 + 1;
+        std::vector<Real> result(2 * nFreqs * invProbs.size());
+        std::vector<std::complex<Real> > transform(nFreqs);
+        std::vector<Probability> condProbs;
+        for(Size iDate=0; iDate<invProbs.size(); iDate++) {
+            copula_->conditionalDefaultProbabilitiesInvP(invProbs[iDate],
+                mktFactors, condProbs);
+            std::fill(transform.begin(), transform.end(),
+                      std::complex<Real>(1.));
+            for(Size iName=0; iName<units_.size(); iName++) {
+                const Size k = units_[iName];
+                const Probability p = condProbs[iName];
+                if(k == 0 || p == 0.) continue;
+                // t runs over j*k mod m
+                for(Size j=0, t=0; j<nFreqs; j++, t=(t+k)&(m-1))
+                    transform[j] *= 1. + p * (roots_[t] - 1.);
+            }
+            Real* out = &result[2 * nFreqs * iDate];
+            for(Size j=0; j<nFreqs; j++) {
+                out[2*j] = transform[j].real();
+                out[2*j+1] = transform[j].imag();
+            }
+        }
+        return result;
+    }
+
+    template<class CP>
+    void FFTPoolLossModel<CP>::computeDistributions(
+        const std::vector<Date>& dates) const
+    {
+        std::vector<Date> pending;
+        std::vector<std::vector<Probability> > probs;
+        std::vector<std::vector<Real> > invProbs;
+        for(Size i=0; i<dates.size(); i++) {
+            if(std::find(pending.begin(), pending.end(), dates[i])
+                != pending.end())
+                continue;
+            std::vector<Probability> p =
+                basket_->remainingProbabilities(dates[i]);
+            typename std::map<Date, std::pair<std::vector<Probability>,
+                std::vector<Probability> > >::const_iterator it =
+                    distributions_.find(dates[i]);
+            if(it != distributions_.end() && it->second.first == p)
+                continue;
+            pending.push_back(dates[i]);
+            probs.push_back(p);
+            invProbs.push_back(copula_->inverseRemainingProbabilities(dates[i]));
+        }
+        if(pending.empty())
+            return;
+
+        std::vector<Real> transforms = copula_->integratedExpectedValueV(
+            [&](const std::vector<Real>& v1) {
+                return conditionalTransforms(invProbs, v1);
+            });
+
+        const Size m = roots_.size();
+        const Size nFreqs = m/2 + 1;
+        FastFourierTransform fft(fftOrder_);
+        std::vector<std::complex<Real> > spectrum(m), values(m);
+        for(Size iDate=0; iDate<pending.size(); iDate++) {
+            const Real* in = &transforms[2 * nFreqs * iDate];
+            for(Size j=0; j<nFreqs; j++)
+                spectrum[j] = std::complex<Real>(in[2*j], in[2*j+1]);
+            // transform of a real sequence
+            for(Size j=nFreqs; j<m; j++)
+                spectrum[j] = std::conj(spectrum[m-j]);
+            fft.inverse_transform(spectrum.begin(), spectrum.end(),
+                                  values.begin());
+
+            std::vector<Probability> lossProbs(nBuckets_, 0.);
+            for(Size n=0; n<std::min(nBuckets_, m); n++)
+                lossProbs[n] = std::max(values[n].real() / m, 0.);
+            distributions_[pending[iDate]] =
+                std::make_pair(probs[iDate], lossProbs);
+        }
+    }
+
+    template<class CP>
+    const std::vector<Probability>&
+    FFTPoolLossModel<CP>::lossProbabilities(const Date& d) const {
+        computeDistributions(std::vector<Date>(1, d));
+        return distributions_.find(d)->second.second;
+    }
+
+    template<class CP>
+    Real FFTPoolLossModel<CP>::expectedTrancheLoss(const Date& d) const {
+        const std::vector<Probability>& probs = lossProbabilities(d);
+        Real expectedLoss = 0., cumulated = 0.;
+        for(Size n=0; n<probs.size(); n++) {
+            expectedLoss += probs[n] * trancheLoss(n);
+            cumulated += probs[n];
+        }
+        // losses over the detachment amount
+        return expectedLoss +
+            std::max(1. - cumulated, 0.) * (detachAmount_ - attachAmount_);
+    }
+
+    template<class CP>
+    Probability FFTPoolLossModel<CP>::probOverLoss(const Date& d,
+        Real lossFraction) const
+    {
+        if(lossFraction <= 0.) return 1.;
+        if(lossFraction > 1.) return 0.;
+        const std::vector<Probability>& probs = lossProbabilities(d);
+        Real loss = attachAmount_ +
+            lossFraction * (detachAmount_ - attachAmount_);
+        // first grid loss not below the given one
+        Size nLoss = static_cast<Size>(
+            std::ceil(loss / lossUnit_ - QL_EPSILON * nBuckets_));
+        Probability probBelow = 0.;
+        for(Size n=0; n<std::min(nLoss, probs.size()); n++)
+            probBelow += probs[n];
+        return std::max(1. - probBelow, 0.);
+    }
+
+    template<class CP>
+    Real FFTPoolLossModel<CP>::percentile(const Date& d,
+        Real percentile) const
+    {
+        const std::vector<Probability>& probs = lossProbabilities(d);
+        Probability cumulated = 0.;
+        for(Size n=0; n<probs.size(); n++) {
+            cumulated += probs[n];
+            if(cumulated >= percentile)
+                return trancheLoss(n);
+        }
+        return detachAmount_ - attachAmount_;
+    }
+
+    template<class CP>
+    Real FFTPoolLossModel<CP>::expectedShortfall(const Date& d,
+        Probability percentile) const
+    {
+        QL_REQUIRE(percentile >= 0. && percentile < 1.,
+            "Incorrect percentile value " << percentile);
+        const std::vector<Probability>& probs = lossProbabilities(d);
+        Probability cumulated = 0.;
+        Size n = 0;
+        for(; n<probs.size(); n++) {
+            cumulated += probs[n];
+            if(cumulated >= percentile) break;
+        }
+        if(n == probs.size())
+            return detachAmount_ - attachAmount_;
+        // the tail starts within the percentile loss
+        Real tailLoss = (cumulated - percentile) * trancheLoss(n);
+        for(++n; n<probs.size(); n++) {
+            tailLoss += probs[n] * trancheLoss(n);
+            cumulated += probs[n];
+        }
+        tailLoss +=
+            std::max(1. - cumulated, 0.) * (detachAmount_ - attachAmount_);
+        return tailLoss / (1. - percentile);
+    }
+
+    template<class CP>
+    Disposable<std::map<Real, Probability> >
+    FFTPoolLossModel<CP>::lossDistribution(const Date& d) const {
+        const std::vector<Probability>& probs = lossProbabilities(d);
+        std::map<Real, Probability> distrib;
+        Probability cumulated = 0.;
+        for(Size n=0; n<probs.size(); n++) {
+            cumulated += probs[n];
+            distrib.insert(std::make_pair(n * lossUnit_, cumulated));
+        }
+        return distrib;
+    }
+
+}
+
+#endif
@@ -133,9 +133,7 @@ namespace QuantLib {
                        subtract_from<Real>(1.0));
         std::transform(lgd.begin(), lgd.end(), notionals_.begin(), 
             lgd.begin(), std::multiplies<Real>());
-        std::vector<Real> prob = basket_->remainingProbabilities(d);
-        for(Size iName=0; iName<prob.size(); iName++)
-            prob[iName] = copula_->inverseCumulativeY(prob[iName], iName);
+        std::vector<Real> prob = copula_->inverseRemainingProbabilities(d);
 
         // integrate locally (1 factor). 
         // use explicitly a 1D latent model object? 
@@ -143,12 +141,10 @@ namespace QuantLib {
             detachAmount_);
             //notional_);
         std::vector<Real> mkft(1, min_ + delta_ /2.);
+        std::vector<Probability> conditionalProbs;
         for (Size i = 0; i < nSteps_; i++) {
-            std::vector<Real> conditionalProbs;
-            for(Size iName=0; iName<notionals_.size(); iName++)
-                conditionalProbs.push_back(
-                copula_->conditionalDefaultProbabilityInvP(prob[iName], iName, 
-                    mkft));
+            copula_->conditionalDefaultProbabilitiesInvP(prob, mkft, 
+                conditionalProbs);
             Distribution bld = bucktLDistBuff(lgd, conditionalProbs);
             Real densitydm = delta_ * copula_->density(mkft);
             // also, instead of calling the static method it could be wrapped 
@@ -18,8 +18,6 @@
 */
 
 #include <ql/experimental/credit/pool.hpp>
-#include <ql/functional.hpp>
-#include <iterator>
 
 namespace QuantLib {
 
@@ -27,61 +25,49 @@ namespace QuantLib {
         clear();
     }
 
-    Size Pool::size() const {
-        return names_.size();
-    }
-
     void Pool::clear() {
+        index_.clear();
         data_.clear();
         time_.clear();
         names_.clear();
+        defaultKeys_.clear();
     }
 
     bool Pool::has(const std::string& name) const {
-        return data_.find(name) != data_.end();
+        return index_.find(name) != index_.end();
     }
 
     void Pool::add (const std::string& name, const Issuer& issuer, 
         const DefaultProbKey& contractTrigger) {
         if (!has(name)) {
-            data_[name] = issuer;
-            time_[name] = 0.0;
+            index_[name] = names_.size();
+            data_.push_back(issuer);
+            time_.push_back(0.0);
             names_.push_back(name);
-            defaultKeys_[name] = contractTrigger;
+            defaultKeys_.push_back(contractTrigger);
         }
     }
 
+    Size Pool::index(const std::string& name) const {
+        auto i = index_.find(name);
+        QL_REQUIRE(i != index_.end(), name + " not found");
+        return i->second;
+    }
+
     const Issuer& Pool::get (const std::string& name) const {
-        QL_REQUIRE(has(name), name + " not found");
-        return data_.find(name)->second;
+        return data_[index(name)];
     }
 
     const DefaultProbKey& Pool::defaultKey (const std::string& name) const {
-        QL_REQUIRE(has(name), name + " not found");
-        return defaultKeys_.find(name)->second;
+        return defaultKeys_[index(name)];
     }
 
     Real Pool::getTime (const std::string& name) const {
-        QL_REQUIRE(has(name), name + " not found");
-        return time_.find(name)->second;
+        return time_[index(name)];
     }
 
     void Pool::setTime(const std::string& name, Real time) {
-        time_[name] = time;
-    }
-
-    const std::vector<std::string>& Pool::names() const {
-        return names_;
-    }
-
-    Disposable<std::vector<DefaultProbKey> > Pool::defaultKeys() const {
-        std::vector<DefaultProbKey> defaultKeys;
-        defaultKeys.reserve(defaultKeys_.size());
-        for (const auto & i : defaultKeys_)
-            defaultKeys.push_back(i.second);
-        return defaultKeys;
+        time_[index(name)] = time;
     }
 
 }
-
-
@@ -24,12 +24,16 @@
 #ifndef quantlib_pool_hpp
 #define quantlib_pool_hpp
 
-#include <ql/utilities/disposable.hpp>
 #include <ql/experimental/credit/issuer.hpp>
 #include <map>
 
 namespace QuantLib {
 
+    /*! Issuers are stored in insertion order and can be accessed
+        either by name or by their position in names(), which is the
+        position used by Basket and by the loss and latent models.
+        Positional access avoids the name lookup in inner loops.
+    */
     class Pool {
       public:
         Pool();
@@ -44,18 +48,72 @@ namespace QuantLib {
         void setTime(const std::string& name, Real time);
         Real getTime (const std::string& name) const;
         const std::vector<std::string>& names() const;
-        Disposable<std::vector<DefaultProbKey> > defaultKeys() const;
+        const std::vector<DefaultProbKey>& defaultKeys() const;
+        //! \name Positional access
+        //@{
+        //! position of the name in names()
+        Size index(const std::string& name) const;
+        const Issuer& get(Size i) const;
+        const DefaultProbKey& defaultKey(Size i) const;
+        void setTime(Size i, Real time);
+        Real getTime(Size i) const;
+        //! times of all names, in the order of names()
+        const std::vector<Real>& times() const;
+        //@}
     private:
         // \todo: needs to cehck all defaul TS have the same ref date? here or
         //   where used? e.g. simulations.
-        std::map<std::string,Issuer> data_;
-        std::map<std::string,Real> time_;
+        std::map<std::string, Size> index_;
+        std::vector<Issuer> data_;
+        std::vector<Real> time_;
         std::vector<std::string> names_;
         /*! default events seniority and currency this name enters the basket 
         with. Determines to which event/probability this pool referes to. */
-        std::map<std::string, DefaultProbKey> defaultKeys_;
+        std::vector<DefaultProbKey> defaultKeys_;
     };
 
+    // inline definitions
+
+    inline Size Pool::size() const {
+        return names_.size();
+    }
+
+    inline const std::vector<std::string>& Pool::names() const {
+        return names_;
+    }
+
+    inline const std::vector<DefaultProbKey>& Pool::defaultKeys() const {
+        return defaultKeys_;
+    }
+
+    inline const Issuer& Pool::get(Size i) const {
+        QL_REQUIRE(i < size(), "index " << i << " out of range: pool has "
+                   << size() << " names");
+        return data_[i];
+    }
+
+    inline const DefaultProbKey& Pool::defaultKey(Size i) const {
+        QL_REQUIRE(i < size(), "index " << i << " out of range: pool has "
+                   << size() << " names");
+        return defaultKeys_[i];
+    }
+
+    inline void Pool::setTime(Size i, Real time) {
+        QL_REQUIRE(i < size(), "index " << i << " out of range: pool has "
+                   << size() << " names");
+        time_[i] = time;
+    }
+
+    inline Real Pool::getTime(Size i) const {
+        QL_REQUIRE(i < size(), "index " << i << " out of range: pool has "
+                   << size() << " names");
+        return time_[i];
+    }
+
+    inline const std::vector<Real>& Pool::times() const {
+        return time_;
+    }
+
 }
 
 
@@ -35,6 +35,9 @@
 #include <ql/math/statistics/histogram.hpp>
 #include <ql/math/statistics/riskstatistics.hpp>
 #include <ql/tuple.hpp>
+#include <algorithm>
+#include <map>
+#include <string>
 #include <utility>
 
 /* Intended to replace
@@ -74,10 +77,18 @@ namespace QuantLib {
     Generates the factors and variable samples and determines event threshold
     but it is not responsible for actual event specification; thats the derived
     classes responsibility according to what they model.
-    Derived classes need mainly to implement nextSample (Worker::nextSample in
-    the multithreaded version) to compute the simulation event generated, if
-    any, from the latent variables sample. They also have the accompanying
-    event trait to specify.
+    Derived classes need mainly to implement nextSample to compute the
+    simulation events generated, if any, from the latent variables sample.
+    They also have the accompanying event trait to specify.
+
+    When OpenMP is enabled, the simulations and the statistics run in
+    parallel. The latent variable samples are still drawn serially, in
+    blocks, so that the results do not depend on the number of threads;
+    the events, whose default time inversion dominates the costs, are then
+    computed concurrently and stored in the slot of their simulation.
+    Derived classes' nextSample must therefore be safe to call from several
+    threads; the default probability curves are calculated in initDates
+    before any simulation takes place.
     */
     /* CRTP used for performance to avoid virtual table resolution in the Monte
     Carlo. Not only in sample generation but access; quite an amount of time can
@@ -88,8 +99,7 @@ namespace QuantLib {
     \todo: someone with sound experience on cache misses look into this, the
     statistics will be getting memory in and out of the cpu heavily and it
     might be possible to get performance out of that.
-    \todo: parallelize the statistics computation, things like Var/ESF splits
-    are very expensive.
+    \todo: parallelize the VaR/ESF splits, they are very expensive.
     \todo: consider another design, taking the statistics outside the models.
     */
     template<template <class, class> class derivedRandomLM, class copulaPolicy,
@@ -101,13 +111,34 @@ namespace QuantLib {
         // random generation is performed in this class only.
         typedef typename LatentModel<copulaPolicy>::template FactorSampler<USNG>
             copulaRNG_type;
+        typedef simEvent<derivedRandomLM<copulaPolicy, USNG> > simEvent_type;
     protected:
+        /* Events of a simulation, sorted by date. It is a view on the
+        contiguous event storage of the model, valid until the model is
+        recalculated.
+        */
+        class SimEvents {
+          public:
+            typedef const simEvent_type* const_iterator;
+            SimEvents(const_iterator begin, const_iterator end)
+            : begin_(begin), end_(end) {}
+            Size size() const { return end_ - begin_; }
+            bool empty() const { return begin_ == end_; }
+            const simEvent_type& operator[](Size i) const {
+                return begin_[i];
+            }
+            const_iterator begin() const { return begin_; }
+            const_iterator end() const { return end_; }
+          private:
+            const_iterator begin_, end_;
+        };
+
       RandomLM(Size numFactors, Size numLMVars, copulaPolicy copula, Size nSims, BigNatural seed)
       : seed_(seed), numFactors_(numFactors), numLMVars_(numLMVars), nSims_(nSims),
         copula_(std::move(copula)) {}
 
       void update() override {
-          simsBuffer_.clear();
+          clearSimulations();
           // tell basket to notify instruments, etc, we are invalid
           if (!basket_.empty())
               basket_->notifyObservers();
@@ -122,24 +153,96 @@ namespace QuantLib {
         }
 
         void performSimulations() const {
-            // Next sequence should determine the event and push it into buffer
-            for (Size i = nSims_; i != 0U; i--) {
-                const std::vector<Real>& sample =
-                    copulasRng_->nextSequence().value;
-                static_cast<const derivedRandomLM<copulaPolicy, USNG>* >(
-                    this)->nextSample(sample);
-            // alternatively make call an explicit local method...
+            clearSimulations();
+            simOffsets_.reserve(nSims_ + 1);
+            simOffsets_.push_back(0);
+
+            std::vector<std::vector<Real> > samples;
+            std::vector<std::vector<simEvent_type> > events;
+            std::vector<std::string> errors;
+            for (Size first = 0; first < nSims_; first += simsBlockSize_) {
+                const Size n = std::min<Size>(simsBlockSize_, nSims_ - first);
+
+                // the samples are drawn in sequence...
+                samples.resize(n);
+                for (Size i = 0; i < n; i++)
+                    samples[i] = copulasRng_->nextSequence().value;
+
+                // ...while the events determined by each of them are
+                // independent and can be computed in parallel.
+                events.resize(n);
+                errors.assign(n, std::string());
+                #pragma omp parallel for
+                for (long i = 0; i < (long)n; i++) {
+                    events[i].clear();
+                    try {
+                        static_cast<const derivedRandomLM<copulaPolicy,
+                            USNG>* >(this)->nextSample(samples[i], events[i]);
+                        std::sort(events[i].begin(), events[i].end());
+                    } catch (std::exception& e) {
+                        errors[i] = e.what();
+                    }
+                }
+                for (Size i = 0; i < n; i++) {
+                    QL_REQUIRE(errors[i].empty(),
+                               "simulation #" << first + i + 1 << ": "
+                               << errors[i]);
+                    simEvents_.insert(simEvents_.end(),
+                                      events[i].begin(), events[i].end());
+                    simOffsets_.push_back(simEvents_.size());
+                }
+            }
+
+            // Cumulated portfolio losses along each simulation, so that the
+            // loss at any date is found by locating the last event before it.
+            const Date today = Settings::instance().evaluationDate();
+            simCumulLosses_.resize(simEvents_.size());
+            #pragma omp parallel for
+            for (long iSim = 0; iSim < (long)nSims_; iSim++) {
+                Real cumulLoss = 0.;
+                for (Size j = simOffsets_[iSim]; j < simOffsets_[iSim+1]; j++) {
+                    const simEvent_type& evt = simEvents_[j];
+                    cumulLoss +=
+                        basket_->exposure(evt.nameIdx,
+                            Date(evt.dayFromRef + today.serialNumber())) *
+                                (1.-getEventRecovery(evt));
+                    simCumulLosses_[j] = cumulLoss;
+                }
             }
         }
 
-        /* Method to access simulation results and avoiding a copy of
-        each thread results buffer. PerformCalculations should have been called.
-        Here in the monothread version this method is redundant/trivial but
-        serves to detach the statistics access to the way the simulations are
-        stored.
+        void clearSimulations() const {
+            simEvents_.clear();
+            simOffsets_.clear();
+            simCumulLosses_.clear();
+            expectedTrancheLosses_.clear();
+        }
+
+        /* Method to access simulation results. PerformCalculations should
+        have been called. It serves to detach the statistics access to the
+        way the simulations are stored.
         */
-        const std::vector<simEvent<derivedRandomLM<copulaPolicy, USNG> > >&
-            getSim(const Size iSim) const { return simsBuffer_[iSim]; }
+        SimEvents getSim(const Size iSim) const {
+            const simEvent_type* events = simEvents_.data();
+            return SimEvents(events + simOffsets_[iSim],
+                             events + simOffsets_[iSim+1]);
+        }
+
+        //! Number of events in the simulation before the given day.
+        Size eventsBefore(const Size iSim, Date::serial_type day) const {
+            const SimEvents events = getSim(iSim);
+            return std::partition_point(events.begin(), events.end(),
+                [day](const simEvent_type& evt) {
+                    return static_cast<Date::serial_type>(
+                        evt.dayFromRef) < day;
+                }) - events.begin();
+        }
+
+        //! Portfolio loss in the simulation before the given day.
+        Real lossBefore(const Size iSim, Date::serial_type day) const {
+            const Size n = eventsBefore(iSim, day);
+            return n == 0 ? 0. : simCumulLosses_[simOffsets_[iSim] + n - 1];
+        }
 
         /* Allows statistics to be written generically for fixed and random
         recovery rates. */
@@ -200,6 +303,11 @@ namespace QuantLib {
         virtual Disposable<std::vector<std::vector<Real> > > splitVaRAndError(
             const Date& date, Real loss, Probability confInterval) const;
         //@}
+
+        /*! Losses of the tranche at the given date in each of the
+            simulations; they are computed in parallel.
+        */
+        Disposable<std::vector<Real> > trancheLosses(const Date& d) const;
     public:
       ~RandomLM() override = default;
 
@@ -211,14 +319,25 @@ namespace QuantLib {
 
         const Size nSims_;
 
-        mutable std::vector<std::vector<simEvent<derivedRandomLM<copulaPolicy,
-            USNG > > > > simsBuffer_;
+        /* Events of all the simulations, each sorted by date, stored
+        contiguously; the events of the i-th simulation lie between
+        simOffsets_[i] and simOffsets_[i+1]. Alongside, the portfolio loss
+        cumulated up to each event.
+        */
+        mutable std::vector<simEvent_type> simEvents_;
+        mutable std::vector<Size> simOffsets_;
+        mutable std::vector<Real> simCumulLosses_;
+        // Mean and error estimate of the tranche loss at the dates queried
+        mutable std::map<Date, std::pair<Real, Real> > expectedTrancheLosses_;
 
         mutable copulaPolicy copula_;
         mutable ext::shared_ptr<copulaRNG_type> copulasRng_;
 
         // Maximum time inversion horizon
         static const Size maxHorizon_ = 4050; // over 11 years
+        // Number of latent variable samples drawn before their events
+        //   are computed
+        static const Size simsBlockSize_ = 4096;
         // Inversion probability limits are computed by children in initdates()
     };
 
@@ -239,14 +358,9 @@ namespace QuantLib {
         if(n==0) return 1.;
 
         Real counts = 0.;
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            Size simCount = 0;
-            const std::vector<simEvent<D<C, URNG> > >& events =
-                getSim(iSim);
-            for(Size iEvt=0; iEvt < events.size(); iEvt++)
-                // duck type on the members:
-                if(val > events[iEvt].dayFromRef) simCount++;
-            if(simCount >= n) counts++;
+        #pragma omp parallel for reduction(+:counts)
+        for(long iSim=0; iSim < (long)nSims_; iSim++) {
+            if(eventsBefore(iSim, val) >= n) counts++;
         }
         return counts/nSims_;
         // \todo Provide confidence interval
@@ -269,7 +383,7 @@ namespace QuantLib {
 
         std::vector<Probability> hitsByDate(basketSize, 0.);
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            const SimEvents events = getSim(iSim);
             std::map<unsigned short, unsigned short> namesDefaulting;
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
                 // if event is within time horizon...
@@ -313,8 +427,10 @@ namespace QuantLib {
         //   would distort the simulation results.
         Real expectedDefi = 0.;
         Real expectedDefj = 0.;
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+        #pragma omp parallel for \
+            reduction(+:expectedDefiDefj,expectedDefi,expectedDefj)
+        for(long iSim=0; iSim < (long)nSims_; iSim++) {
+            const SimEvents events = getSim(iSim);
             Real imatch = 0., jmatch = 0.;
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
                 if((val > events[iEvt].dayFromRef) &&
@@ -349,36 +465,19 @@ namespace QuantLib {
         const Date& d, Probability confidencePerc) const
     {
         calculate();
-        Date today = Settings::instance().evaluationDate();
-        Date::serial_type val = d.serialNumber() - today.serialNumber();
-
-        Real attachAmount = basket_->attachmentAmount();
-        Real detachAmount = basket_->detachmentAmount();
-
-        // Real trancheLoss= 0.;
-        GeneralStatistics lossStats;
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
-
-            Real portfSimLoss=0.;
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                // if event is within time horizon...
-                if(val > static_cast<Date::serial_type>(
-					   events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-                    // ...and is contained in the basket.
-                        portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
-                                Date(events[iEvt].dayFromRef +
-                                    today.serialNumber())) *
-                                        (1.-getEventRecovery(events[iEvt]));
-               }
-            }
-            lossStats.add(// d  ates? current losses? realized defaults, not yet
-                std::min(std::max(portfSimLoss - attachAmount, 0.),
-                    detachAmount - attachAmount) );
+        auto cached = expectedTrancheLosses_.find(d);
+        if (cached == expectedTrancheLosses_.end()) {
+            const std::vector<Real> losses = trancheLosses(d);
+
+            GeneralStatistics lossStats;
+            lossStats.reserve(losses.size());
+            for(Size iSim=0; iSim < nSims_; iSim++)
+                lossStats.add(losses[iSim]);
+            cached = expectedTrancheLosses_.insert(std::make_pair(d,
+                std::make_pair(lossStats.mean(),
+                    lossStats.errorEstimate()))).first;
         }
-        return std::make_pair(lossStats.mean(), lossStats.errorEstimate() *
+        return std::make_pair(cached->second.first, cached->second.second *
             InverseCumulativeNormal::standard_value(0.5*(1.+confidencePerc)));
     }
 
@@ -403,40 +502,12 @@ namespace QuantLib {
 
     template<template <class, class> class D, class C, class URNG>
     Histogram RandomLM<D, C, URNG>::computeHistogram(const Date& d) const {
-        std::vector<Real> data;
-        std::set<Real> keys;// attainable loss values
-        keys.insert(0.);
         Date today = Settings::instance().evaluationDate();
-        Date::serial_type val = d.serialNumber() - today.serialNumber();
         // redundant test? should have been tested by the basket caller?
         QL_REQUIRE(d >= today,
             "Requested percentile date must lie after computation date.");
-        calculate();
-
-        Real attachAmount = basket_->attachmentAmount();
-        Real detachAmount = basket_->detachmentAmount();
-
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
 
-            Real portfSimLoss=0.;
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                if(val > static_cast<Date::serial_type>(
-					 events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-          // test needed (here and the others) to reuse simulations:
-          //          if(basket_->pool()->has(copula_->pool()->names()[iName]))
-                        portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
-                                Date(events[iEvt].dayFromRef +
-                                    today.serialNumber())) *
-                                        (1.-getEventRecovery(events[iEvt]));
-                }
-            }
-            data.push_back(std::min(std::max(portfSimLoss - attachAmount, 0.),
-                detachAmount - attachAmount));
-            keys.insert(data.back());
-        }
+        const std::vector<Real> data = trancheLosses(d);
         // avoid using as many points as in the simulation.
         Size nPts = std::min<Size>(data.size(), 150);// fix
         return Histogram(data.begin(), data.end(), nPts);
@@ -452,34 +523,10 @@ namespace QuantLib {
             "Requested percentile date must lie after computation date.");
         calculate();
 
-        Real attachAmount = basket_->attachmentAmount();
-        Real detachAmount = basket_->detachmentAmount();
-
         Date::serial_type val = d.serialNumber() - today.serialNumber();
         if(val <= 0) return 0.;// plus basket realized losses
 
-        //GenericRiskStatistics<GeneralStatistics> statsX;
-        std::vector<Real> losses;
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
-            Real portfSimLoss=0.;
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                if(val > static_cast<Date::serial_type>(
-					  events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-                    // ...and is contained in the basket.
-                    //if(basket_->pool()->has(copula_->pool()->names()[iName]))
-                        portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
-                                Date(events[iEvt].dayFromRef +
-                                    today.serialNumber())) *
-                                        (1.-getEventRecovery(events[iEvt]));
-                }
-            }
-            portfSimLoss = std::min(std::max(portfSimLoss - attachAmount, 0.),
-                detachAmount - attachAmount);
-            losses.push_back(portfSimLoss);
-        }
+        std::vector<Real> losses = trancheLosses(d);
 
         std::sort(losses.begin(), losses.end());
         Real posit = std::ceil(percent * nSims_);
@@ -547,32 +594,7 @@ namespace QuantLib {
             "Incorrect percentile");
         calculate();
 
-        Real attachAmount = basket_->attachmentAmount();
-        Real detachAmount = basket_->detachmentAmount();
-
-        std::vector<Real> rankLosses;
-        Date today = Settings::instance().evaluationDate();
-        Date::serial_type val = d.serialNumber() - today.serialNumber();
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
-            Real portfSimLoss=0.;
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                if(val > static_cast<Date::serial_type>(
-					 events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-                 //   if(basket_->pool()->has(copula_->pool()->names()[iName]))
-                        portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
-                                Date(events[iEvt].dayFromRef +
-                                    today.serialNumber())) *
-                                        (1.-getEventRecovery(events[iEvt]));
-                }
-            }
-            portfSimLoss = std::min(std::max(portfSimLoss - attachAmount, 0.),
-                detachAmount - attachAmount);
-            // update dataset for rank stat:
-            rankLosses.push_back(portfSimLoss);
-        }
+        std::vector<Real> rankLosses = trancheLosses(d);
 
         std::sort(rankLosses.begin(), rankLosses.end());
         Size quantilePosition = static_cast<Size>(floor(nSims_*percentile));
@@ -622,6 +644,27 @@ namespace QuantLib {
     }
 
 
+    template<template <class, class> class D, class C, class URNG>
+    Disposable<std::vector<Real> > RandomLM<D, C, URNG>::trancheLosses(
+        const Date& d) const
+    {
+        calculate();
+
+        const Real attachAmount = basket_->attachmentAmount();
+        const Real detachAmount = basket_->detachmentAmount();
+
+        const Date today = Settings::instance().evaluationDate();
+        const Date::serial_type val = d.serialNumber() - today.serialNumber();
+
+        std::vector<Real> losses(nSims_);
+        #pragma omp parallel for
+        for(long iSim=0; iSim < (long)nSims_; iSim++)
+            losses[iSim] = std::min(std::max(lossBefore(iSim, val)
+                - attachAmount, 0.), detachAmount - attachAmount);
+        return losses;
+    }
+
+
     template<template <class, class> class D, class C, class URNG>
     Disposable<std::vector<Real> > RandomLM<D, C, URNG>::splitVaRLevel(
         const Date& date, Real loss) const
@@ -657,7 +700,7 @@ namespace QuantLib {
         Date::serial_type val = date.serialNumber() - today.serialNumber();
 
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            const SimEvents events = getSim(iSim);
             Real portfSimLoss=0.;
             //std::vector<Real> splitBuffer(numLiveNames_, 0.);
             std::vector<simEvent<D<C, URNG> > > splitEventsBuffer;
@@ -668,7 +711,7 @@ namespace QuantLib {
                     Size iName = events[iEvt].nameIdx;
                 // if(basket_->pool()->has(copula_->pool()->names()[iName])) {
                         portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
+                            basket_->exposure(iName,
                                 Date(events[iEvt].dayFromRef +
                                     today.serialNumber())) *
                                         (1.-getEventRecovery(events[iEvt]));
@@ -694,7 +737,7 @@ namespace QuantLib {
             // allows amortizing (others should be like this)
             // basket_->remainingNotionals(Date(simsBuffer_[i].dayFromRef +
             //      today.serialNumber()))[iName] *
-                        basket_->exposure(basket_->names()[iName],
+                        basket_->exposure(iName,
                             Date(splitEventsBuffer[i].dayFromRef +
                                 today.serialNumber())) *
                                 (1.-getEventRecovery(splitEventsBuffer[i]));
@@ -865,7 +908,8 @@ namespace QuantLib {
         */
         friend class RandomLM< ::QuantLib::RandomDefaultLM, copulaPolicy, USNG>;
     protected:
-        void nextSample(const std::vector<Real>& values) const;
+        void nextSample(const std::vector<Real>& values,
+                        std::vector<defaultSimEvent>& events) const;
         void initDates() const {
             /* Precalculate horizon time default probabilities (used to
               determine if the default took place and subsequently compute its
@@ -876,7 +920,7 @@ namespace QuantLib {
 
             const ext::shared_ptr<Pool>& pool = this->basket_->pool();
             for(Size iName=0; iName < this->basket_->size(); ++iName)//use'live'
-                horizonDefaultPs_.push_back(pool->get(pool->names()[iName]).
+                horizonDefaultPs_.push_back(pool->get(iName).
                     defaultProbability(this->basket_->defaultKeys()[iName])
                         ->defaultProbability(maxHorizonDate, true));
         }
@@ -924,11 +968,10 @@ namespace QuantLib {
 
     template<class C, class URNG>
     void RandomDefaultLM<C, URNG>::nextSample(
-        const std::vector<Real>& values) const
+        const std::vector<Real>& values,
+        std::vector<defaultSimEvent>& events) const
     {
         const ext::shared_ptr<Pool>& pool = this->basket_->pool();
-        // starts with no events
-        this->simsBuffer_.push_back(std::vector<defaultSimEvent> ());
 
         for(Size iName=0; iName<model_->size(); iName++) {
             Real latentVarSample =
@@ -938,7 +981,7 @@ namespace QuantLib {
             // If the default simulated lies before the max date:
             if (horizonDefaultPs_[iName] >= simDefaultProb) {
                 const Handle<DefaultProbabilityTermStructure>& dfts =
-                    pool->get(pool->names()[iName]).// use 'live' names
+                    pool->get(iName).// use 'live' names
                     defaultProbability(this->basket_->defaultKeys()[iName]);
                 // compute and store default time with respect to the
                 //  curve ref date:
@@ -956,8 +999,7 @@ namespace QuantLib {
                                         std::log(1.-simDefaultProb)
                     /std::log(1.-data_.horizonDefaultPs_[iName])));
                    */
-                this->simsBuffer_.back().push_back(defaultSimEvent(iName,
-                    dateSTride));
+                events.push_back(defaultSimEvent(iName, dateSTride));
                //emplace_back
             }
         /* Used to remove sims with no events. Uses less memory, faster
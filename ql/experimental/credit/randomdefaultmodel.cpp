@@ -64,17 +64,16 @@ namespace QuantLib {
         const std::vector<Real>& values = rsg_.nextSequence().value;
         Real a = sqrt(copula_->correlation());
         for (Size j = 0; j < pool_->size(); j++) {
-            const string name = pool_->names()[j];
             const Handle<DefaultProbabilityTermStructure>&
-                dts = pool_->get(name).defaultProbability(defaultKeys_[j]);
+                dts = pool_->get(j).defaultProbability(defaultKeys_[j]);
 
             Real y = a * values[0] + sqrt(1-a*a) * values[j+1];
             Real p = CumulativeNormalDistribution()(y);
 
             if (dts->defaultProbability(tmax) < p)
-                pool_->setTime(name, tmax+1);
+                pool_->setTime(j, tmax+1);
             else
-                pool_->setTime(name, Brent().solve(Root(dts,p),accuracy_,0,1));
+                pool_->setTime(j, Brent().solve(Root(dts,p),accuracy_,0,1));
         }
     }
 
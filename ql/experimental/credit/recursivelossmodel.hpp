@@ -64,10 +64,10 @@ namespace QuantLib {
                              const std::vector<Real>& mktFactor) const;
       Real expectedConditionalLoss(const std::vector<Probability>& pDefDate, //<< never used!!
                                    const std::vector<Real>& mktFactor) const;
-      Disposable<std::vector<Real> > conditionalLossProb(const std::vector<Probability>& pDefDate,
+      // versions using the P-inverse, deprecate the former
+      Disposable<std::vector<Real> > conditionalLossProb(const std::vector<Real>& invpDefDate,
                                                          // const Date& date,
                                                          const std::vector<Real>& mktFactor) const;
-      // versions using the P-inverse, deprecate the former
       Disposable<std::map<Real, Probability> >
       conditionalLossDistribInvP(const std::vector<Real>& pDefDate,
                                  // const Date& date,
@@ -164,12 +164,8 @@ namespace QuantLib {
             });
             */
 
-        std::vector<Probability> uncDefProb = 
-            basket_->remainingProbabilities(date);
-        std::vector<Real> invProb;
-        for(Size i=0; i<uncDefProb.size(); ++i)
-           invProb.push_back(copula_->inverseCumulativeY(uncDefProb[i], i));
-           ///  invProb.push_back(CP::inverseCumulativeY(uncDefProb[i], i));//<-static call
+        std::vector<Real> invProb = 
+            copula_->inverseRemainingProbabilities(date);
         return copula_->integratedExpectedValue(
             [&](const std::vector<Real>& v1) {
                 return expectedConditionalLossInvP(invProb, v1);
@@ -180,11 +176,11 @@ namespace QuantLib {
     inline Disposable<std::vector<Real> > 
     RecursiveLossModel<CP>::lossProbability(const Date& date) const {
 
-        std::vector<Probability> uncDefProb = 
-            basket_->remainingProbabilities(date);
+        std::vector<Real> invProb = 
+            copula_->inverseRemainingProbabilities(date);
         return copula_->integratedExpectedValueV(
             [&](const std::vector<Real>& v1) {
-                return conditionalLossProb(uncDefProb, v1);
+                return conditionalLossProb(invProb, v1);
             });
     }
 
@@ -361,13 +357,15 @@ namespace QuantLib {
         // eq. 10 p.68
         // attainable losses distribution, recursive algorithm
 
+        std::vector<Probability> condProbs;
+        copula_->conditionalDefaultProbabilitiesInvP(invpDefDate, mktFactor,
+            condProbs);
+
         std::map<Real, Probability> pIndepDistrib;
         // K=0
         pIndepDistrib.insert(std::make_pair(0., 1.));
         for(Size iName=0; iName<remainingBsktSize_; ++iName) {
-            Probability pDef =
-                copula_->conditionalDefaultProbabilityInvP(invpDefDate[iName], 
-                    iName, mktFactor);
+            Probability pDef = condProbs[iName];
 
             // iterate on all possible losses in the distribution:
             std::map<Real, Probability> pDistTemp;
@@ -473,12 +471,12 @@ namespace QuantLib {
 
     template<class CP>
     Disposable<std::vector<Real> > RecursiveLossModel<CP>::conditionalLossProb(
-        const std::vector<Probability>& pDefDate, 
+        const std::vector<Real>& invpDefDate, 
         //const Date& date,
         const std::vector<Real>& mktFactor) const 
     {
         std::map<Real, Probability> pIndepDistrib =
-            conditionalLossDistrib(pDefDate, mktFactor);
+            conditionalLossDistribInvP(invpDefDate, mktFactor);
 
         std::vector<Real> results;
         auto distIt = pIndepDistrib.begin();
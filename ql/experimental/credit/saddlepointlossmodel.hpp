@@ -388,10 +388,7 @@ namespace QuantLib {
         const Date& date, Real s) const 
     {
         std::vector<Real> invUncondProbs = 
-            basket_->remainingProbabilities(date);
-        for(Size i=0; i<invUncondProbs.size(); i++)
-            invUncondProbs[i] = 
-            copula_->inverseCumulativeY(invUncondProbs[i], i);
+            copula_->inverseRemainingProbabilities(date);
 
         return copula_->integratedExpectedValue(
             [&](const std::vector<Real>& v1) {
@@ -404,10 +401,7 @@ namespace QuantLib {
         const Date& date, Real s) const 
     {
         std::vector<Real> invUncondProbs = 
-            basket_->remainingProbabilities(date);
-        for(Size i=0; i<invUncondProbs.size(); i++)
-            invUncondProbs[i] = 
-            copula_->inverseCumulativeY(invUncondProbs[i], i);
+            copula_->inverseRemainingProbabilities(date);
 
        return copula_->integratedExpectedValue(
            [&](const std::vector<Real>& v1) {
@@ -420,10 +414,7 @@ namespace QuantLib {
         const Date& date, Real s) const 
     {
         std::vector<Real> invUncondProbs = 
-            basket_->remainingProbabilities(date);
-        for(Size i=0; i<invUncondProbs.size(); i++)
-            invUncondProbs[i] = 
-            copula_->inverseCumulativeY(invUncondProbs[i], i);
+            copula_->inverseRemainingProbabilities(date);
 
         return copula_->integratedExpectedValue(
            [&](const std::vector<Real>& v1) {
@@ -436,10 +427,7 @@ namespace QuantLib {
         const Date& date, Real s) const 
     {
         std::vector<Real> invUncondProbs = 
-            basket_->remainingProbabilities(date);
-        for(Size i=0; i<invUncondProbs.size(); i++)
-            invUncondProbs[i] = 
-            copula_->inverseCumulativeY(invUncondProbs[i], i);
+            copula_->inverseRemainingProbabilities(date);
 
         return copula_->integratedExpectedValue(
            [&](const std::vector<Real>& v1) {
@@ -452,10 +440,7 @@ namespace QuantLib {
         const Date& date, Real s) const 
     {
         std::vector<Real> invUncondProbs = 
-            basket_->remainingProbabilities(date);
-        for(Size i=0; i<invUncondProbs.size(); i++)
-            invUncondProbs[i] = 
-            copula_->inverseCumulativeY(invUncondProbs[i], i);
+            copula_->inverseRemainingProbabilities(date);
 
         return copula_->integratedExpectedValue(
            [&](const std::vector<Real>& v1) {
@@ -473,10 +458,7 @@ namespace QuantLib {
             basket_->detachmentAmount()) return 0.;
 
         std::vector<Real> invUncondProbs = 
-            basket_->remainingProbabilities(d);
-        for(Size i=0; i<invUncondProbs.size(); i++)
-            invUncondProbs[i] = 
-            copula_->inverseCumulativeY(invUncondProbs[i], i);
+            copula_->inverseRemainingProbabilities(d);
 
         return copula_->integratedExpectedValue(
            [&](const std::vector<Real>& v1) {
@@ -488,11 +470,8 @@ namespace QuantLib {
     inline Probability SaddlePointLossModel<CP>::probOverPortfLoss(
         const Date& d, Real loss) const 
     {
-        std::vector<Probability> invUncondProbs = 
-            basket_->remainingProbabilities(d);
-        for(Size i=0; i<invUncondProbs.size(); i++)
-            invUncondProbs[i] = 
-            copula_->inverseCumulativeY(invUncondProbs[i], i);
+        std::vector<Real> invUncondProbs = 
+            copula_->inverseRemainingProbabilities(d);
 
         return copula_->integratedExpectedValue(
            [&](const std::vector<Real>& v1) {
@@ -505,10 +484,7 @@ namespace QuantLib {
         const Date& d) const 
     {
         std::vector<Real> invUncondProbs = 
-            basket_->remainingProbabilities(d);
-        for(Size i=0; i<invUncondProbs.size(); i++)
-            invUncondProbs[i] = 
-            copula_->inverseCumulativeY(invUncondProbs[i], i);
+            copula_->inverseRemainingProbabilities(d);
 
         return copula_->integratedExpectedValue(
            [&](const std::vector<Real>& v1) {
@@ -521,10 +497,7 @@ namespace QuantLib {
         const Date& d, Real loss) const 
     {
         std::vector<Real> invUncondProbs = 
-            basket_->remainingProbabilities(d);
-        for(Size i=0; i<invUncondProbs.size(); i++)
-            invUncondProbs[i] = 
-            copula_->inverseCumulativeY(invUncondProbs[i], i);
+            copula_->inverseRemainingProbabilities(d);
 
         return copula_->integratedExpectedValue(
            [&](const std::vector<Real>& v1) {
@@ -537,10 +510,7 @@ namespace QuantLib {
     SaddlePointLossModel<CP>::splitVaRLevel(const Date& date, Real s) const 
     {
         std::vector<Real> invUncondProbs = 
-            basket_->remainingProbabilities(date);
-        for(Size i=0; i<invUncondProbs.size(); i++)
-            invUncondProbs[i] = 
-            copula_->inverseCumulativeY(invUncondProbs[i], i);
+            copula_->inverseRemainingProbabilities(date);
 
         return copula_->integratedExpectedValueV(
            [&](const std::vector<Real>& v1) {
@@ -572,10 +542,11 @@ namespace QuantLib {
         const Size nNames = remainingNotionals_.size();
         Real sum = 0.;
 
+        std::vector<Probability> condProbs;
+        copula_->conditionalDefaultProbabilitiesInvP(invUncondProbs, 
+            mktFactor, condProbs);
         for(Size iName=0; iName < nNames; iName++) {
-            Probability pBuffer = 
-                copula_->conditionalDefaultProbabilityInvP(
-                    invUncondProbs[iName], iName, mktFactor);
+            Probability pBuffer = condProbs[iName];
             sum += std::log(1. - pBuffer + 
                 pBuffer * std::exp(remainingNotionals_[iName] * 
                 (1.-copula_->conditionalRecoveryInvP(invUncondProbs[iName],
@@ -593,10 +564,11 @@ namespace QuantLib {
         const Size nNames = remainingNotionals_.size();
         Real sum = 0.;
 
+        std::vector<Probability> condProbs;
+        copula_->conditionalDefaultProbabilitiesInvP(invUncondProbs, 
+            mktFactor, condProbs);
         for(Size iName=0; iName < nNames; iName++) {
-            Probability pBuffer = 
-                copula_->conditionalDefaultProbabilityInvP(
-                    invUncondProbs[iName], iName, mktFactor);
+            Probability pBuffer = condProbs[iName];
             // loss in fractional units
             Real lossInDef = remainingNotionals_[iName] * 
                 (1.-copula_->conditionalRecoveryInvP(invUncondProbs[iName], 
@@ -616,10 +588,11 @@ namespace QuantLib {
         const Size nNames = remainingNotionals_.size();
         Real sum = 0.;
 
+        std::vector<Probability> condProbs;
+        copula_->conditionalDefaultProbabilitiesInvP(invUncondProbs, 
+            mktFactor, condProbs);
         for(Size iName=0; iName < nNames; iName++) {
-            Probability pBuffer = 
-                copula_->conditionalDefaultProbabilityInvP(
-                    invUncondProbs[iName], iName, mktFactor);
+            Probability pBuffer = condProbs[iName];
             // loss in fractional units
             Real lossInDef = remainingNotionals_[iName] * 
                 (1.-copula_->conditionalRecoveryInvP(invUncondProbs[iName], 
@@ -641,10 +614,11 @@ namespace QuantLib {
         const Size nNames = remainingNotionals_.size();
         Real sum = 0.;
 
+        std::vector<Probability> condProbs;
+        copula_->conditionalDefaultProbabilitiesInvP(invUncondProbs, 
+            mktFactor, condProbs);
         for(Size iName=0; iName < nNames; iName++) {
-            Probability pBuffer = 
-                copula_->conditionalDefaultProbabilityInvP(
-                    invUncondProbs[iName], iName, mktFactor);
+            Probability pBuffer = condProbs[iName];
             Real lossInDef = remainingNotionals_[iName] * 
                 (1.-copula_->conditionalRecoveryInvP(invUncondProbs[iName], 
                     iName, mktFactor)) / remainingNotional_;
@@ -672,10 +646,11 @@ namespace QuantLib {
         const Size nNames = remainingNotionals_.size();
         Real sum = 0.;
 
+        std::vector<Probability> condProbs;
+        copula_->conditionalDefaultProbabilitiesInvP(invUncondProbs, 
+            mktFactor, condProbs);
         for(Size iName=0; iName < nNames; iName++) {
-            Probability pBuffer = 
-                copula_->conditionalDefaultProbabilityInvP(
-                    invUncondProbs[iName], iName, mktFactor);
+            Probability pBuffer = condProbs[iName];
             Real lossInDef = remainingNotionals_[iName] * 
                 (1.-copula_->conditionalRecoveryInvP(invUncondProbs[iName], 
                     iName, mktFactor)) / remainingNotional_;
@@ -709,10 +684,11 @@ namespace QuantLib {
              deriv2 = 0.,
              deriv3 = 0.,
              deriv4 = 0.;
+        std::vector<Probability> condProbs;
+        copula_->conditionalDefaultProbabilitiesInvP(invUncondProbs, 
+            mktFactor, condProbs);
         for(Size iName=0; iName < nNames; iName++) {
-            Probability pBuffer = 
-                copula_->conditionalDefaultProbabilityInvP(
-                    invUncondProbs[iName], iName, mktFactor);
+            Probability pBuffer = condProbs[iName];
             Real lossInDef = remainingNotionals_[iName] * 
                 (1.-copula_->conditionalRecoveryInvP(invUncondProbs[iName], 
                     iName, mktFactor)) / remainingNotional_;
@@ -750,10 +726,11 @@ namespace QuantLib {
         Real deriv0 = 0.,
              //deriv1 = 0.,
              deriv2 = 0.;
+        std::vector<Probability> condProbs;
+        copula_->conditionalDefaultProbabilitiesInvP(invUncondProbs, 
+            mktFactor, condProbs);
         for(Size iName=0; iName < nNames; iName++) {
-            Probability pBuffer = 
-                copula_->conditionalDefaultProbabilityInvP(
-                    invUncondProbs[iName], iName, mktFactor);
+            Probability pBuffer = condProbs[iName];
             Real lossInDef = remainingNotionals_[iName] * 
                 (1.-copula_->conditionalRecoveryInvP(invUncondProbs[iName], 
                     iName, mktFactor)) / remainingNotional_;
@@ -1140,10 +1117,11 @@ namespace QuantLib {
         Real saddlePt = findSaddle(invUncondProbs, loss / remainingNotional_, 
             mktFactor);
 
+        std::vector<Probability> condProbs;
+        copula_->conditionalDefaultProbabilitiesInvP(invUncondProbs, 
+            mktFactor, condProbs);
         for(Size iName=0; iName<nNames; iName++) {
-            Probability pBuffer = 
-                copula_->conditionalDefaultProbabilityInvP(
-                    invUncondProbs[iName], iName, mktFactor);
+            Probability pBuffer = condProbs[iName];
             Real lossInDef = remainingNotionals_[iName] * 
                 (1.-copula_->conditionalRecoveryInvP(invUncondProbs[iName], 
                     iName, mktFactor));
@@ -1164,9 +1142,11 @@ namespace QuantLib {
         const Size nNames = remainingNotionals_.size();
         Real eloss = 0.;
         /// USE STL.....-------------------
+        std::vector<Probability> condProbs;
+        copula_->conditionalDefaultProbabilitiesInvP(invUncondProbs, 
+            mktFactor, condProbs);
         for(Size iName=0; iName < nNames; iName++) {
-            Probability pBuffer = copula_->conditionalDefaultProbabilityInvP(
-                invUncondProbs[iName], iName, mktFactor);
+            Probability pBuffer = condProbs[iName];
             eloss += pBuffer * remainingNotionals_[iName] *
                 (1.-copula_->conditionalRecoveryInvP(invUncondProbs[iName], 
                     iName, mktFactor));
@@ -1182,9 +1162,11 @@ namespace QuantLib {
         const Size nNames = remainingNotionals_.size();
         Real eloss = 0.;
         /// USE STL.....-------------------
+        std::vector<Probability> condProbs;
+        copula_->conditionalDefaultProbabilitiesInvP(invUncondProbs, 
+            mktFactor, condProbs);
         for(Size iName=0; iName < nNames; iName++) {
-            Probability pBuffer = copula_->conditionalDefaultProbabilityInvP(
-                invUncondProbs[iName], iName, mktFactor);
+            Probability pBuffer = condProbs[iName];
             eloss += 
                 pBuffer * remainingNotionals_[iName] * 
                 (1.-copula_->conditionalRecoveryInvP(invUncondProbs[iName], 
@@ -1209,9 +1191,11 @@ namespace QuantLib {
                     iName, mktFactor))); 
         std::vector<Real> vola(nNames, 0.), mu(nNames, 0.);
         Real volaTot = 0., muTot = 0.;
+        std::vector<Probability> condProbs;
+        copula_->conditionalDefaultProbabilitiesInvP(invUncondProbs, 
+            mktFactor, condProbs);
         for(Size iName=0; iName < nNames; iName++) {
-            Probability pBuffer = copula_->conditionalDefaultProbabilityInvP(
-                invUncondProbs[iName], iName, mktFactor);
+            Probability pBuffer = condProbs[iName];
             mu[iName] = lgds[iName] * pBuffer / remainingNotionals_[iName];
             muTot += lgds[iName] * pBuffer;
             vola[iName] = lgds[iName] * lgds[iName] * pBuffer * (1.-pBuffer) 
@@ -1283,9 +1267,11 @@ namespace QuantLib {
         const Size nNames = remainingNotionals_.size();
 
         /// use stl algorthms
+        std::vector<Probability> condProbs;
+        copula_->conditionalDefaultProbabilitiesInvP(invUncondProbs, 
+            mktFactor, condProbs);
         for(Size iName=0; iName < nNames; iName++) {
-            Probability pBuffer = copula_->conditionalDefaultProbabilityInvP(
-                invUncondProbs[iName], iName, mktFactor);
+            Probability pBuffer = condProbs[iName];
             elCond += pBuffer * remainingNotionals_[iName] * 
                 (1.-copula_->conditionalRecoveryInvP(invUncondProbs[iName],
                     iName, mktFactor));
@@ -1345,10 +1331,7 @@ namespace QuantLib {
         if(lossPerc >= trancheAmount) return trancheAmount;
         //SHOULD CHECK NOW THE OPPOSITE LIMIT ("zero" losses)....
         std::vector<Real> invUncondProbs = 
-            basket_->remainingProbabilities(d);
-        for(Size i=0; i<invUncondProbs.size(); i++)
-            invUncondProbs[i] = 
-                copula_->inverseCumulativeY(invUncondProbs[i], i);
+            copula_->inverseRemainingProbabilities(d);
 
         // Integrate with the tranche or the portfolio according to the limits.
         return copula_->integratedExpectedValue(
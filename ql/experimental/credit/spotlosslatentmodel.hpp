@@ -78,6 +78,11 @@ namespace QuantLib {
         Probability conditionalDefaultProbabilityInvP(Real invCumYProb, 
             Size iName, 
             const std::vector<Real>& m) const;
+        //! Batch version of the above for the first invCumYProbs.size() names
+        void conditionalDefaultProbabilitiesInvP(
+            const std::vector<Real>& invCumYProbs,
+            const std::vector<Real>& m,
+            std::vector<Probability>& condProbs) const;
         /*! Expected conditional spot recovery rate. Conditional on a set of 
         systemic factors and default returns the integrated attainable recovery 
         values. \par
@@ -150,7 +155,7 @@ namespace QuantLib {
     {
         const ext::shared_ptr<Pool>& pool = basket_->pool();
         Probability pDefUncond =
-            pool->get(pool->names()[iName]).
+            pool->get(iName).
             defaultProbability(basket_->defaultKeys()[iName])
               ->defaultProbability(date);
         return conditionalDefaultProbability(pDefUncond, iName, mktFactors);
@@ -196,6 +201,24 @@ namespace QuantLib {
         return res;
     }
 
+    template<class CP>
+    inline void 
+        SpotRecoveryLatentModel<CP>::conditionalDefaultProbabilitiesInvP(
+        const std::vector<Real>& invCumYProbs,
+        const std::vector<Real>& m,
+        std::vector<Probability>& condProbs) const 
+    {
+        const Size nNames = invCumYProbs.size();
+        condProbs.resize(nNames);
+        for(Size iName=0; iName<nNames; iName++)
+            condProbs[iName] = (invCumYProbs[iName] -
+                std::inner_product(this->factorWeights_[iName].begin(),
+                    this->factorWeights_[iName].end(), m.begin(), 0.))
+                / this->idiosyncFctrs_[iName];
+        for(Size iName=0; iName<nNames; iName++)
+            condProbs[iName] = this->cumulativeZ(condProbs[iName]);
+    }
+
     template<class CP>
     inline Real 
         SpotRecoveryLatentModel<CP>::expCondRecovery(const Date& d, 
@@ -208,7 +231,7 @@ namespace QuantLib {
     #endif
         const ext::shared_ptr<Pool>& pool = basket_->pool();
         Probability pDefUncond =
-            pool->get(pool->names()[iName]).
+            pool->get(iName).
             defaultProbability(basket_->defaultKeys()[iName])
               ->defaultProbability(d);
 
@@ -260,7 +283,7 @@ namespace QuantLib {
 
         // retrieve the default probability for this name
         const Handle<DefaultProbabilityTermStructure>& dfts = 
-            pool->get(basket_->names()[iName]).defaultProbability(
+            pool->get(iName).defaultProbability(
                 basket_->defaultKeys()[iName]);
         const Probability pdef = dfts->defaultProbability(d, true);
         // before asking for -\infty
@@ -294,7 +317,7 @@ namespace QuantLib {
     {
         const ext::shared_ptr<Pool>& pool = basket_->pool();
         Probability pDefUncond =
-            pool->get(pool->names()[iName]).
+            pool->get(iName).
             defaultProbability(basket_->defaultKeys()[iName])
               ->defaultProbability(d);
 
@@ -321,7 +344,7 @@ namespace QuantLib {
     {
         const ext::shared_ptr<Pool>& pool = basket_->pool();
         Probability pDefUncond =
-            pool->get(pool->names()[iName]).
+            pool->get(iName).
             defaultProbability(basket_->defaultKeys()[iName])
               ->defaultProbability(d);
 
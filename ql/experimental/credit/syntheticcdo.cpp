@@ -67,13 +67,13 @@ namespace QuantLib {
             calculations this would left me unregistered to some. Not impossible
             to de-register and register when updating but i am dropping it.
 
-            if(!basket->pool()->get(basket->names()[i]).
+            if(!basket->pool()->get(i).
                 defaultedBetween(schedule.dates()[0], today,
                                      basket->pool()->defaultKeys()[i]))
             */
             // registers with the associated curve (issuer and event type)
             // \todo make it possible to access them by name instead of index
-            registerWith(basket->pool()->get(basket->names()[i]).
+            registerWith(basket->pool()->get(i).
                 defaultProbability(basket->pool()->defaultKeys()[i]));
             /* \todo Issuers should be observables/obsrvr and they would in turn
             regiter with the DTS; only we might get updates from curves we do
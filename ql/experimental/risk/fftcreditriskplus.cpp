@@ -0,0 +1,387 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+  This file is part of QuantLib, a free-software/open-source library
+  for financial quantitative analysts and developers - http://quantlib.org/
+
+  QuantLib is free software: you can redistribute it and/or modify it
+  under the terms of the QuantLib license.  You should have received a
+  copy of the license along with this program; if not, please email
+  <quantlib-dev@lists.sf.net>. The license is also available online at
+  <http://quantlib.org/license.shtml>.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/risk/fftcreditriskplus.hpp>
+#include <ql/math/fastfouriertransform.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace QuantLib {
+
+    namespace {
+
+        // probability left in the upper quarter of the grid below
+        // which the wrapped-around tail is deemed negligible
+        const Real tailTolerance = 1.0e-10;
+        const Size maxOrder = 28;
+
+        // log of the generating function of a sector, given the
+        // transform of its weighted default probabilities
+        inline std::complex<Real> sectorLogFactor(
+                               const std::complex<Real>& q, Real mu, Real v) {
+            return v > 0.0 ? -std::log(1.0 - v*(q - mu))/v
+                           : q - mu;
+        }
+
+        // real part of the inverse transform, divided by the grid
+        // size.  Beyond the mode, the values not exceeding the
+        // round-off level seen in the upper quarter of the grid are
+        // set to zero; they would otherwise bias tail expectations.
+        void probabilities(const std::vector<std::complex<Real> >& x,
+                           std::vector<Real>& result) {
+            const Size N = x.size();
+            Real noise = 0.0;
+            for (Size k = N - N / 4; k < N; ++k)
+                noise = std::max(noise, std::fabs(x[k].real()));
+            Size mode = 0;
+            for (Size k = 0; k < N; ++k) {
+                result[k] = x[k].real() / N;
+                if (result[k] > result[mode])
+                    mode = k;
+            }
+            noise /= N;
+            for (Size k = mode + 1; k < N; ++k)
+                if (result[k] <= noise)
+                    result[k] = 0.0;
+        }
+
+    }
+
+    FFTCreditRiskPlus::FFTCreditRiskPlus(
+                std::vector<Real> exposure,
+                std::vector<Real> defaultProbability,
+                std::vector<std::vector<SectorWeight> > sectorWeights,
+                std::vector<Real> relativeDefaultVariance,
+                Real unit,
+                Size gridPoints)
+    : exposure_(std::move(exposure)), pd_(std::move(defaultProbability)),
+      relativeDefaultVariance_(std::move(relativeDefaultVariance)),
+      unit_(unit) {
+
+        m_ = exposure_.size();
+        n_ = relativeDefaultVariance_.size();
+
+        QL_REQUIRE(m_ > 0, "no exposures given");
+        QL_REQUIRE(m_ == pd_.size(), "number of exposures ("
+                                         << m_
+                                         << ") must be equal to number of pds ("
+                                         << pd_.size() << ")");
+        QL_REQUIRE(m_ == sectorWeights.size(),
+                   "number of exposures ("
+                       << m_
+                       << ") must be equal to number of sector weights ("
+                       << sectorWeights.size() << ")");
+        QL_REQUIRE(unit_ > 0.0, "loss unit (" << unit_ << ") must be positive");
+        for (Size j = 0; j < n_; ++j)
+            QL_REQUIRE(relativeDefaultVariance_[j] >= 0.0,
+                       "relative default variance #"
+                           << j << " is negative ("
+                           << relativeDefaultVariance_[j] << ")");
+
+        // store the weights by obligor
+
+        obligorBegin_.reserve(m_ + 1);
+        idiosyncraticWeight_.resize(m_);
+        std::vector<Size> sectorCount(n_, 0);
+        obligorBegin_.push_back(0);
+        for (Size i = 0; i < m_; ++i) {
+            QL_REQUIRE(exposure_[i] >= 0.0, "exposure #"
+                                                << i << " is negative ("
+                                                << exposure_[i] << ")");
+            QL_REQUIRE(pd_[i] > 0.0, "pd #" << i << " is not positive ("
+                                            << pd_[i] << ")");
+            Real sum = 0.0;
+            for (const auto& w : sectorWeights[i]) {
+                QL_REQUIRE(w.first < n_, "sector (" << w.first
+                                                    << ") of exposure #" << i
+                                                    << " is out of range 0..."
+                                                    << (n_ - 1));
+                QL_REQUIRE(w.second >= 0.0, "sector weight of exposure #"
+                                                << i << " is negative ("
+                                                << w.second << ")");
+                if (w.second == 0.0)
+                    continue;
+                sectorOf_.push_back(w.first);
+                weight_.push_back(w.second);
+                obligorOf_.push_back(i);
+                ++sectorCount[w.first];
+                sum += w.second;
+            }
+            QL_REQUIRE(sum <= 1.0 + 1.0e-12, "sector weights of exposure #"
+                                                 << i << " add up to " << sum
+                                                 << ", more than one");
+            idiosyncraticWeight_[i] = std::max(1.0 - sum, 0.0);
+            obligorBegin_.push_back(weight_.size());
+        }
+
+        // and their positions by sector
+
+        sectorBegin_.resize(n_ + 1, 0);
+        for (Size j = 0; j < n_; ++j)
+            sectorBegin_[j + 1] = sectorBegin_[j] + sectorCount[j];
+        sectorEntries_.resize(weight_.size());
+        std::vector<Size> next(sectorBegin_.begin(), sectorBegin_.end() - 1);
+        for (Size k = 0; k < weight_.size(); ++k)
+            sectorEntries_[next[sectorOf_[k]]++] = k;
+
+        // exposure bands and adjusted pds, as in CreditRiskPlus
+
+        units_.resize(m_);
+        adjustedPd_.resize(m_);
+        unsigned long maxUnits = 0;
+        Real mean = 0.0, variance = 0.0;
+        for (Size i = 0; i < m_; ++i) {
+            auto exUnit = (unsigned long)(std::floor(0.5 + exposure_[i] / unit_));
+            if (exposure_[i] > 0 && exUnit == 0)
+                exUnit = 1;
+            units_[i] = exUnit;
+            maxUnits = std::max(maxUnits, exUnit);
+            adjustedPd_[i] = exposure_[i] > 0.0
+                                 ? exposure_[i] * pd_[i] / (exUnit * unit_)
+                                 : 0.0;
+            mean += adjustedPd_[i] * exUnit;
+            variance += adjustedPd_[i] * exUnit * exUnit;
+        }
+
+        // portfolio figures
+
+        exposureSum_ = 0.0;
+        el_ = 0.0;
+        ul_ = 0.0;
+        sectorPdSum_.resize(n_, 0.0);
+        std::vector<Real> sectorEl(n_, 0.0), sectorUnits(n_, 0.0);
+        for (Size i = 0; i < m_; ++i) {
+            exposureSum_ += exposure_[i];
+            el_ += pd_[i] * exposure_[i];
+            ul_ += pd_[i] * exposure_[i] * exposure_[i];
+            for (Size k = obligorBegin_[i]; k < obligorBegin_[i + 1]; ++k) {
+                sectorPdSum_[sectorOf_[k]] += weight_[k] * adjustedPd_[i];
+                sectorEl[sectorOf_[k]] += weight_[k] * pd_[i] * exposure_[i];
+                sectorUnits[sectorOf_[k]] +=
+                    weight_[k] * adjustedPd_[i] * units_[i];
+            }
+        }
+        for (Size j = 0; j < n_; ++j) {
+            ul_ += relativeDefaultVariance_[j] * sectorEl[j] * sectorEl[j];
+            variance += relativeDefaultVariance_[j] * sectorUnits[j] *
+                        sectorUnits[j];
+        }
+        ul_ = std::sqrt(ul_);
+
+        // grid size
+
+        if (gridPoints != 0) {
+            order_ = std::max<Size>(
+                FastFourierTransform::min_order(gridPoints), 1);
+            QL_REQUIRE((Size(1) << order_) > maxUnits,
+                       "grid of " << (Size(1) << order_)
+                                  << " points does not cover the largest"
+                                     " exposure (" << maxUnits << " units)");
+            computeDistribution();
+        } else {
+            Real size = std::max<Real>(maxUnits + 1.0,
+                                       mean + 10.0 * std::sqrt(variance));
+            order_ = std::max<Size>(
+                FastFourierTransform::min_order(Size(std::ceil(size))), 1);
+            while (computeDistribution() >= tailTolerance) {
+                QL_REQUIRE(order_ < maxOrder,
+                           "loss distribution not contained in a grid of "
+                               << loss_.size() << " points");
+                ++order_;
+            }
+        }
+    }
+
+    void FFTCreditRiskPlus::sectorTransform(
+                              Size sector,
+                              const FastFourierTransform& fft,
+                              std::vector<std::complex<Real> >& buffer,
+                              std::vector<std::complex<Real> >& result) const {
+        std::fill(buffer.begin(), buffer.end(), std::complex<Real>(0.0));
+        for (Size k = sectorBegin_[sector]; k < sectorBegin_[sector + 1];
+             ++k) {
+            const Size e = sectorEntries_[k];
+            const Size i = obligorOf_[e];
+            buffer[units_[i]] += weight_[e] * adjustedPd_[i];
+        }
+        fft.transform(buffer.begin(), buffer.end(), result.begin());
+    }
+
+    Real FFTCreditRiskPlus::computeDistribution() {
+        const Size N = Size(1) << order_;
+        const FastFourierTransform fft(order_);
+
+        // idiosyncratic part
+        std::vector<std::complex<Real> > buffer(N, 0.0), logG(N);
+        Real idiosyncraticPdSum = 0.0;
+        for (Size i = 0; i < m_; ++i) {
+            Real p = idiosyncraticWeight_[i] * adjustedPd_[i];
+            buffer[units_[i]] += p;
+            idiosyncraticPdSum += p;
+        }
+        fft.transform(buffer.begin(), buffer.end(), logG.begin());
+        for (Size k = 0; k < N; ++k)
+            logG[k] -= idiosyncraticPdSum;
+
+        // sectors; they are split in a fixed number of contiguous
+        // blocks, each summing the contributions of its sectors to
+        // the log of the generating function.  The partial sums are
+        // then added in order, so that the result doesn't depend on
+        // the number of threads or on their scheduling.
+        const Size blocks = std::min<Size>(n_, 8);
+        std::vector<std::vector<std::complex<Real> > > partial(blocks);
+        #pragma omp parallel
+        {
+            std::vector<std::complex<Real> > q(N), qHat(N);
+            #pragma omp for schedule(dynamic)
+            for (long b = 0; b < (long)blocks; ++b) {
+                std::vector<std::complex<Real> >& sum = partial[b];
+                sum.assign(N, 0.0);
+                for (Size j = (b * n_) / blocks; j < ((b + 1) * n_) / blocks;
+                     ++j) {
+                    if (sectorBegin_[j] == sectorBegin_[j + 1])
+                        continue;
+                    sectorTransform(j, fft, q, qHat);
+                    for (Size k = 0; k < N; ++k)
+                        sum[k] += sectorLogFactor(qHat[k], sectorPdSum_[j],
+                                                  relativeDefaultVariance_[j]);
+                }
+            }
+        }
+        for (Size b = 0; b < blocks; ++b)
+            for (Size k = 0; k < N; ++k)
+                logG[k] += partial[b][k];
+
+        transform_.resize(N);
+        for (Size k = 0; k < N; ++k)
+            transform_[k] = std::exp(logG[k]);
+
+        fft.inverse_transform(transform_.begin(), transform_.end(),
+                              buffer.begin());
+        Real upperQuarter = 0.0;
+        for (Size k = N - N / 4; k < N; ++k)
+            upperQuarter += buffer[k].real() / N;
+
+        loss_.resize(N);
+        probabilities(buffer, loss_);
+        return upperQuarter;
+    }
+
+    Size FFTCreditRiskPlus::quantileIndex(Real p) const {
+        QL_REQUIRE(p >= 0.0 && p <= 1.0,
+                   "probability (" << p << ") must be in [0,1]");
+        Real sum = 0.0;
+        for (Size k = 0; k < loss_.size(); ++k) {
+            sum += loss_[k];
+            if (sum >= p)
+                return k;
+        }
+        return loss_.size() - 1;
+    }
+
+    Real FFTCreditRiskPlus::lossQuantile(Real p) const {
+        return quantileIndex(p) * unit_;
+    }
+
+    Real FFTCreditRiskPlus::expectedShortfall(Real p) const {
+        Real tail = 0.0, loss = 0.0;
+        for (Size k = quantileIndex(p); k < loss_.size(); ++k) {
+            tail += loss_[k];
+            loss += k * loss_[k];
+        }
+        return loss / tail * unit_;
+    }
+
+    std::vector<Real>
+    FFTCreditRiskPlus::valueAtRiskContributions(Real p) const {
+        return contributions(p, false);
+    }
+
+    std::vector<Real>
+    FFTCreditRiskPlus::expectedShortfallContributions(Real p) const {
+        return contributions(p, true);
+    }
+
+    std::vector<Real> FFTCreditRiskPlus::contributions(Real p,
+                                                       bool shortfall) const {
+        const Size N = loss_.size();
+        const FastFourierTransform fft(order_);
+        const Size level = quantileIndex(p);
+
+        // E[L_i 1{L = l}] = nu_i p_i sum_s w_is P_s(L = l - nu_i), where
+        // P_0 is the loss distribution and P_s the one in which the
+        // shape of sector s is increased by one; the same holds for
+        // the events {L >= l} with the tail probabilities instead.
+        std::vector<Real> base(loss_);
+        if (shortfall)
+            for (Size k = N - 1; k > 0; --k)
+                base[k - 1] += base[k];
+        const Real denominator = base[level];
+        QL_REQUIRE(denominator > 0.0,
+                   "null probability for the loss quantile at " << p);
+
+        std::vector<Real> sectorTerm(weight_.size(), 0.0);
+        #pragma omp parallel
+        {
+            std::vector<std::complex<Real> > q(N), qHat(N);
+            std::vector<Real> shifted(N);
+            #pragma omp for
+            for (long j = 0; j < (long)n_; ++j) {
+                if (sectorBegin_[j] == sectorBegin_[j + 1])
+                    continue;
+                sectorTransform(j, fft, q, qHat);
+                const Real v = relativeDefaultVariance_[j];
+                for (Size k = 0; k < N; ++k)
+                    qHat[k] = transform_[k] /
+                              (1.0 - v * (qHat[k] - sectorPdSum_[j]));
+                fft.inverse_transform(qHat.begin(), qHat.end(), q.begin());
+                probabilities(q, shifted);
+                if (shortfall)
+                    for (Size k = N - 1; k > 0; --k)
+                        shifted[k - 1] += shifted[k];
+
+                for (Size k = sectorBegin_[j]; k < sectorBegin_[j + 1]; ++k) {
+                    const Size e = sectorEntries_[k];
+                    const unsigned long nu = units_[obligorOf_[e]];
+                    Real probability;
+                    if (nu <= level)
+                        probability = shifted[level - nu];
+                    else
+                        probability = shortfall ? 1.0 : 0.0;
+                    sectorTerm[e] = weight_[e] * probability;
+                }
+            }
+        }
+
+        std::vector<Real> result(m_);
+        #pragma omp parallel for
+        for (long i = 0; i < (long)m_; ++i) {
+            const unsigned long nu = units_[i];
+            Real probability;
+            if (nu <= level)
+                probability = base[level - nu];
+            else
+                probability = shortfall ? 1.0 : 0.0;
+            Real sum = idiosyncraticWeight_[i] * probability;
+            for (Size k = obligorBegin_[i]; k < obligorBegin_[i + 1]; ++k)
+                sum += sectorTerm[k];
+            result[i] = nu * unit_ * adjustedPd_[i] * sum / denominator;
+        }
+        return result;
+    }
+
+}
@@ -0,0 +1,146 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+  This file is part of QuantLib, a free-software/open-source library
+  for financial quantitative analysts and developers - http://quantlib.org/
+
+  QuantLib is free software: you can redistribute it and/or modify it
+  under the terms of the QuantLib license.  You should have received a
+  copy of the license along with this program; if not, please email
+  <quantlib-dev@lists.sf.net>. The license is also available online at
+  <http://quantlib.org/license.shtml>.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fftcreditriskplus.hpp
+    \brief Multi-sector CreditRisk+ model solved by Fourier inversion
+*/
+
+#ifndef quantlib_fft_creditriskplus_hpp
+#define quantlib_fft_creditriskplus_hpp
+
+#include <ql/qldefines.hpp>
+#include <ql/types.hpp>
+#include <complex>
+#include <utility>
+#include <vector>
+
+namespace QuantLib {
+
+    class FastFourierTransform;
+
+    /*! CreditRisk+ model with independent, gamma distributed sector
+      variables of unit mean, as described in [1].  Each obligor can
+      be allocated to several sectors through sparse weights; the
+      part of its default probability not allocated to any sector is
+      idiosyncratic.
+
+      Measured in multiples \f$ \nu_i \f$ of the loss unit, the loss
+      has the probability generating function
+      \f[
+          G(z) = \exp\Big(\sum_i w_{i0}\, p_i (z^{\nu_i}-1)\Big)
+                 \prod_s \big(1 - \sigma_s^2 (Q_s(z) - Q_s(1))\big)
+                                                  ^{-1/\sigma_s^2},
+          \qquad Q_s(z) = \sum_i w_{is}\, p_i z^{\nu_i},
+      \f]
+      where \f$ \sigma_s^2 \f$ is the relative default variance of
+      sector \f$ s \f$.  Instead of running a recursion over every
+      loss level, \f$ G \f$ is evaluated at the \f$ N \f$-th roots of
+      unity with one FFT per sector and the distribution is recovered
+      with an inverse FFT.  The cost is \f$ O(S N \log N) \f$ plus the
+      number of non-zero weights, and the memory is \f$ O(N) \f$ per
+      thread.  Unless given, \f$ N \f$ is doubled until the
+      probability of the upper quarter of the grid is negligible, so
+      that the tail wrapped around by the transform can be ignored.
+
+      Risk contributions to value at risk and expected shortfall
+      follow [2]: the contribution of an obligor involves the loss
+      distributions in which the shape parameter of one of its
+      sectors is increased by one.  These are computed sector by
+      sector, in parallel when OpenMP is enabled.
+
+      As in CreditRiskPlus, exposures are rounded to multiples of the
+      loss unit and the default probabilities are adjusted so as to
+      preserve the expected loss.  With a single sector and full
+      weights the model reduces to CreditRiskPlus with one sector.
+
+      [1] Credit Suisse First Boston, CreditRisk+: A Credit Risk
+          Management Framework, 1997
+      [2] H. Haaf and D. Tasche, Calculating value-at-risk
+          contributions in CreditRisk+, GARP Risk Review 7, 2002
+
+      \test the loss distribution is checked against CreditRiskPlus
+            for a single sector, and the risk contributions are
+            checked to add up to the portfolio figures.
+    */
+    class FFTCreditRiskPlus {
+      public:
+        //! sector index and weight of an obligor
+        typedef std::pair<Size, Real> SectorWeight;
+
+        /*! \param sectorWeights  for each obligor, its non-zero sector
+                                  weights, adding up to at most one
+            \param gridPoints     number of loss levels; it is rounded
+                                  up to a power of two, and chosen
+                                  automatically if zero
+        */
+        FFTCreditRiskPlus(std::vector<Real> exposure,
+                          std::vector<Real> defaultProbability,
+                          std::vector<std::vector<SectorWeight> > sectorWeights,
+                          std::vector<Real> relativeDefaultVariance,
+                          Real unit,
+                          Size gridPoints = 0);
+
+        //! probabilities of the loss levels, in multiples of the unit
+        const std::vector<Real>& loss() const { return loss_; }
+
+        Real exposure() const { return exposureSum_; }
+        Real expectedLoss() const { return el_; }
+        Real unexpectedLoss() const { return ul_; }
+
+        //! smallest multiple of the unit whose cumulative probability is at least p
+        Real lossQuantile(Real p) const;
+        //! expected loss beyond lossQuantile(p), included
+        Real expectedShortfall(Real p) const;
+
+        //! contributions of the obligors to lossQuantile(p)
+        std::vector<Real> valueAtRiskContributions(Real p) const;
+        //! contributions of the obligors to expectedShortfall(p)
+        std::vector<Real> expectedShortfallContributions(Real p) const;
+
+      private:
+        // returns the probability of the upper quarter of the grid
+        Real computeDistribution();
+        void sectorTransform(Size sector,
+                             const FastFourierTransform& fft,
+                             std::vector<std::complex<Real> >& buffer,
+                             std::vector<std::complex<Real> >& result) const;
+        Size quantileIndex(Real p) const;
+        std::vector<Real> contributions(Real p, bool shortfall) const;
+
+        std::vector<Real> exposure_, pd_;
+        std::vector<Real> relativeDefaultVariance_;
+        Real unit_;
+        Size n_, m_; // number of sectors, obligors
+
+        // sector weights by obligor, plus their positions by sector
+        std::vector<Size> obligorBegin_, sectorOf_, obligorOf_;
+        std::vector<Real> weight_, idiosyncraticWeight_;
+        std::vector<Size> sectorBegin_, sectorEntries_;
+
+        std::vector<unsigned long> units_;
+        std::vector<Real> adjustedPd_, sectorPdSum_;
+
+        Size order_;
+        std::vector<std::complex<Real> > transform_;
+        std::vector<Real> loss_;
+
+        Real exposureSum_, el_, ul_;
+    };
+
+}
+
+#endif
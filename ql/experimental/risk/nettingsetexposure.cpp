@@ -0,0 +1,339 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+  This file is part of QuantLib, a free-software/open-source library
+  for financial quantitative analysts and developers - http://quantlib.org/
+
+  QuantLib is free software: you can redistribute it and/or modify it
+  under the terms of the QuantLib license.  You should have received a
+  copy of the license along with this program; if not, please email
+  <quantlib-dev@lists.sf.net>. The license is also available online at
+  <http://quantlib.org/license.shtml>.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/risk/nettingsetexposure.hpp>
+#include <ql/cashflows/iborcoupon.hpp>
+#include <ql/math/randomnumbers/rngtraits.hpp>
+#include <ql/math/statistics/generalstatistics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+
+namespace QuantLib {
+
+    namespace {
+
+        // zero bonds needed by the cash flows, identified by their
+        // maturity and forwarding curve (null for the model curve)
+        class BondRegistry {
+          public:
+            Size index(Time T, const Handle<YieldTermStructure>& curve) {
+                std::pair<Time, const YieldTermStructure*> key(
+                    T, curve.empty() ? nullptr : curve.currentLink().get());
+                auto i = indices_.find(key);
+                if (i != indices_.end())
+                    return i->second;
+                Size n = maturities.size();
+                indices_[key] = n;
+                maturities.push_back(T);
+                curves.push_back(curve);
+                return n;
+            }
+            std::vector<Time> maturities;
+            std::vector<Handle<YieldTermStructure> > curves;
+          private:
+            std::map<std::pair<Time, const YieldTermStructure*>, Size> indices_;
+        };
+
+        // the simulation relies on the model being log-affine in the
+        // state, as Gsr is; other models, e.g. MarkovFunctional, are not
+        void checkLogAffine(Real logValueAtMinusOne, Real a, Real b,
+                            const char* what, Time t) {
+            QL_REQUIRE(std::fabs(logValueAtMinusOne - (a - b)) <= 1.0e-8,
+                       what << " at time " << t << " is not log-affine "
+                       "in the model state (log-value at y=-1 is "
+                       << logValueAtMinusOne << " instead of " << a - b
+                       << ")");
+        }
+
+    }
+
+    NettingSetExposure::NettingSetExposure(
+                        ext::shared_ptr<Gaussian1dModel> model,
+                        std::vector<ext::shared_ptr<VanillaSwap> > swaps,
+                        std::vector<Date> exposureDates,
+                        Size samples,
+                        BigNatural seed)
+    : model_(std::move(model)), swaps_(std::move(swaps)),
+      dates_(std::move(exposureDates)), samples_(samples) {
+
+        QL_REQUIRE(model_, "no model given");
+        QL_REQUIRE(!swaps_.empty(), "no swaps given");
+        QL_REQUIRE(!dates_.empty(), "no exposure dates given");
+        QL_REQUIRE(samples_ > 0, "at least one sample is required");
+
+        const Handle<YieldTermStructure>& curve = model_->termStructure();
+        const Date today = curve->referenceDate();
+        QL_REQUIRE(dates_.front() > today,
+                   "exposure dates (" << dates_.front()
+                   << ") must follow the reference date (" << today << ")");
+        for (Size k = 1; k < dates_.size(); ++k)
+            QL_REQUIRE(dates_[k] > dates_[k-1],
+                       "exposure dates must be sorted and unique");
+        times_.resize(dates_.size());
+        for (Size k = 0; k < dates_.size(); ++k)
+            times_[k] = curve->timeFromReference(dates_[k]);
+        const Time horizon = times_.back();
+
+        // flatten the cash flows of the netting set
+        BondRegistry bonds;
+        std::vector<Size> payBond, startBond, endBond;
+        std::vector<Time> payTime, fixingTime;
+        // amount, or nominal times accrual for floating coupons
+        std::vector<Real> amount, gearing, spread, spanningTime;
+        std::vector<bool> floating;
+
+        for (auto& swap : swaps_) {
+            QL_REQUIRE(swap, "null swap given");
+            for (Size j = 0; j < 2; ++j) {
+                const Real sign = swap->payer(j) ? -1.0 : 1.0;
+                for (const auto& cf : swap->leg(j)) {
+                    if (cf->hasOccurred(today, false))
+                        continue;
+                    const Time T = curve->timeFromReference(cf->date());
+                    ext::shared_ptr<IborCoupon> coupon =
+                        ext::dynamic_pointer_cast<IborCoupon>(cf);
+                    if (coupon != nullptr && coupon->fixingDate() > today) {
+                        const ext::shared_ptr<IborIndex>& index =
+                            coupon->iborIndex();
+                        Date valueDate = index->valueDate(coupon->fixingDate());
+                        Date endDate = coupon->fixingEndDate();
+                        const Handle<YieldTermStructure>& forwarding =
+                            index->forwardingTermStructure();
+                        Handle<YieldTermStructure> fwd =
+                            forwarding.empty() ||
+                            forwarding.currentLink() == curve.currentLink() ?
+                            Handle<YieldTermStructure>() : forwarding;
+                        floating.push_back(true);
+                        fixingTime.push_back(
+                            curve->timeFromReference(coupon->fixingDate()));
+                        startBond.push_back(bonds.index(
+                            curve->timeFromReference(valueDate), fwd));
+                        endBond.push_back(bonds.index(
+                            curve->timeFromReference(endDate), fwd));
+                        spanningTime.push_back(
+                            index->dayCounter().yearFraction(valueDate, endDate));
+                        amount.push_back(sign * coupon->nominal() *
+                                         coupon->accrualPeriod());
+                        gearing.push_back(coupon->gearing());
+                        spread.push_back(coupon->spread());
+                    } else {
+                        floating.push_back(false);
+                        fixingTime.push_back(Null<Time>());
+                        startBond.push_back(Null<Size>());
+                        endBond.push_back(Null<Size>());
+                        spanningTime.push_back(Null<Real>());
+                        amount.push_back(sign * cf->amount());
+                        gearing.push_back(Null<Real>());
+                        spread.push_back(Null<Real>());
+                    }
+                    payTime.push_back(T);
+                    payBond.push_back(
+                        bonds.index(T, Handle<YieldTermStructure>()));
+                }
+            }
+        }
+        const Size flows = payTime.size();
+        const Size nBonds = bonds.maturities.size();
+
+        // simulation grid: exposure times plus the fixing times up to
+        // the last of them; each fixing is recorded at its grid time
+        std::vector<Time> grid(times_);
+        for (Size i = 0; i < flows; ++i)
+            if (floating[i] && fixingTime[i] <= horizon)
+                grid.push_back(fixingTime[i]);
+        std::sort(grid.begin(), grid.end());
+        grid.erase(std::unique(grid.begin(), grid.end()), grid.end());
+        const Size steps = grid.size();
+
+        std::vector<Size> fixingStep(flows, Null<Size>());
+        for (Size i = 0; i < flows; ++i)
+            if (floating[i] && fixingTime[i] <= horizon)
+                fixingStep[i] = std::lower_bound(grid.begin(), grid.end(),
+                                                 fixingTime[i]) - grid.begin();
+        std::vector<Size> exposureStep(dates_.size());
+        for (Size k = 0; k < dates_.size(); ++k)
+            exposureStep[k] = std::lower_bound(grid.begin(), grid.end(),
+                                               times_[k]) - grid.begin();
+
+        // log-affine coefficients, in the state x, of the transition,
+        // of the zero bonds and of the numeraire at each grid time;
+        // they are fitted at y=0 and y=1 and checked at y=-1
+        ext::shared_ptr<StochasticProcess1D> process = model_->stateProcess();
+        QL_REQUIRE(process, "model provides no state process");
+        const Real x0 = process->x0();
+        std::vector<Real> drift(steps), reversion(steps), diffusion(steps);
+        Matrix bond0(steps, nBonds, 0.0), bond1(steps, nBonds, 0.0);
+        std::vector<Real> numeraire0(steps), numeraire1(steps);
+        const Real initialNumeraire = model_->numeraire(0.0);
+        for (Size k = 0; k < steps; ++k) {
+            const Time t0 = k == 0 ? 0.0 : grid[k-1], t = grid[k];
+            drift[k] = process->expectation(t0, 0.0, t - t0);
+            reversion[k] = process->expectation(t0, 1.0, t - t0) - drift[k];
+            diffusion[k] = process->stdDeviation(t0, 0.0, t - t0);
+
+            // y is the standardized state used by the model interface
+            const Real mean = process->expectation(0.0, x0, t);
+            const Real stdDev = process->stdDeviation(0.0, x0, t);
+            QL_REQUIRE(stdDev > 0.0, "degenerate state at time " << t);
+            for (Size m = 0; m < nBonds; ++m) {
+                if (bonds.maturities[m] <= t)
+                    continue;
+                Real a = std::log(model_->zerobond(bonds.maturities[m], t,
+                                                   0.0, bonds.curves[m]));
+                Real b = std::log(model_->zerobond(bonds.maturities[m], t,
+                                                   1.0, bonds.curves[m])) - a;
+                checkLogAffine(std::log(model_->zerobond(bonds.maturities[m],
+                                                         t, -1.0,
+                                                         bonds.curves[m])),
+                               a, b, "zero bond", t);
+                bond0[k][m] = a - b * mean / stdDev;
+                bond1[k][m] = b / stdDev;
+            }
+            Real a = std::log(model_->numeraire(t, 0.0));
+            Real b = std::log(model_->numeraire(t, 1.0)) - a;
+            checkLogAffine(std::log(model_->numeraire(t, -1.0)), a, b,
+                           "numeraire", t);
+            numeraire0[k] = a - b * mean / stdDev;
+            numeraire1[k] = b / stdDev;
+        }
+
+        // the variates are drawn upfront so that the results don't
+        // depend on the number of threads
+        Matrix variates(samples_, steps);
+        PseudoRandom::rsg_type rsg =
+            PseudoRandom::make_sequence_generator(steps, seed);
+        for (Size p = 0; p < samples_; ++p) {
+            const std::vector<Real>& z = rsg.nextSequence().value;
+            std::copy(z.begin(), z.end(), variates.row_begin(p));
+        }
+
+        values_ = Matrix(dates_.size(), samples_);
+        deflators_ = Matrix(dates_.size(), samples_);
+
+        #pragma omp parallel
+        {
+            std::vector<Real> discount(nBonds), fixing(flows);
+
+            #pragma omp for
+            for (long p = 0; p < long(samples_); ++p) {
+                Real x = x0;
+                Size e = 0;
+                for (Size k = 0; k < steps && e < dates_.size(); ++k) {
+                    x = drift[k] + reversion[k] * x
+                        + diffusion[k] * variates[p][k];
+                    for (Size m = 0; m < nBonds; ++m)
+                        discount[m] = std::exp(bond0[k][m] + bond1[k][m] * x);
+
+                    for (Size i = 0; i < flows; ++i)
+                        if (fixingStep[i] == k)
+                            fixing[i] = (discount[startBond[i]] /
+                                         discount[endBond[i]] - 1.0) /
+                                        spanningTime[i];
+
+                    if (exposureStep[e] != k)
+                        continue;
+
+                    const Time t = grid[k];
+                    Real value = 0.0;
+                    for (Size i = 0; i < flows; ++i) {
+                        if (payTime[i] <= t)
+                            continue;
+                        Real flow = amount[i];
+                        if (floating[i]) {
+                            Rate rate = fixingTime[i] <= t ?
+                                fixing[i] :
+                                (discount[startBond[i]] /
+                                 discount[endBond[i]] - 1.0) / spanningTime[i];
+                            flow *= gearing[i] * rate + spread[i];
+                        }
+                        value += flow * discount[payBond[i]];
+                    }
+                    values_[e][p] = value;
+                    deflators_[e][p] = initialNumeraire /
+                        std::exp(numeraire0[k] + numeraire1[k] * x);
+                    ++e;
+                }
+            }
+        }
+    }
+
+    std::vector<Real> NettingSetExposure::expectedExposure(Real sign) const {
+        std::vector<Real> result(dates_.size(), 0.0);
+        for (Size k = 0; k < dates_.size(); ++k) {
+            Real sum = 0.0;
+            for (Size p = 0; p < samples_; ++p)
+                sum += std::max(sign * values_[k][p], 0.0) * deflators_[k][p];
+            result[k] = sum / samples_;
+        }
+        return result;
+    }
+
+    std::vector<Real> NettingSetExposure::expectedPositiveExposure() const {
+        return expectedExposure(1.0);
+    }
+
+    std::vector<Real> NettingSetExposure::expectedNegativeExposure() const {
+        return expectedExposure(-1.0);
+    }
+
+    std::vector<Real>
+    NettingSetExposure::potentialFutureExposure(Real percentile) const {
+        QL_REQUIRE(percentile > 0.0 && percentile <= 1.0,
+                   "percentile (" << percentile << ") must be in (0.0, 1.0]");
+        std::vector<Real> result(dates_.size());
+        for (Size k = 0; k < dates_.size(); ++k) {
+            GeneralStatistics exposure;
+            exposure.reserve(samples_);
+            for (Size p = 0; p < samples_; ++p)
+                exposure.add(std::max(values_[k][p], 0.0));
+            result[k] = exposure.percentile(percentile);
+        }
+        return result;
+    }
+
+    Real NettingSetExposure::adjustment(
+                        const std::vector<Real>& exposure,
+                        const Handle<DefaultProbabilityTermStructure>& dts,
+                        Real recoveryRate) const {
+        QL_REQUIRE(!dts.empty(), "no default term structure given");
+        Real result = 0.0;
+        Probability previous = 0.0;
+        for (Size k = 0; k < dates_.size(); ++k) {
+            Probability current = dts->defaultProbability(dates_[k]);
+            result += exposure[k] * (current - previous);
+            previous = current;
+        }
+        return (1.0 - recoveryRate) * result;
+    }
+
+    Real NettingSetExposure::cva(
+                        const Handle<DefaultProbabilityTermStructure>& ctptyDTS,
+                        Real ctptyRecoveryRate) const {
+        return adjustment(expectedPositiveExposure(), ctptyDTS,
+                          ctptyRecoveryRate);
+    }
+
+    Real NettingSetExposure::dva(
+                        const Handle<DefaultProbabilityTermStructure>& invstDTS,
+                        Real invstRecoveryRate) const {
+        return adjustment(expectedNegativeExposure(), invstDTS,
+                          invstRecoveryRate);
+    }
+
+}
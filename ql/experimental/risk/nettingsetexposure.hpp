@@ -0,0 +1,108 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+  This file is part of QuantLib, a free-software/open-source library
+  for financial quantitative analysts and developers - http://quantlib.org/
+
+  QuantLib is free software: you can redistribute it and/or modify it
+  under the terms of the QuantLib license.  You should have received a
+  copy of the license along with this program; if not, please email
+  <quantlib-dev@lists.sf.net>. The license is also available online at
+  <http://quantlib.org/license.shtml>.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file nettingsetexposure.hpp
+    \brief Monte Carlo exposure of a netting set of swaps
+*/
+
+#ifndef quantlib_netting_set_exposure_hpp
+#define quantlib_netting_set_exposure_hpp
+
+#include <ql/handle.hpp>
+#include <ql/instruments/vanillaswap.hpp>
+#include <ql/math/matrix.hpp>
+#include <ql/models/shortrate/onefactormodels/gaussian1dmodel.hpp>
+#include <ql/termstructures/defaulttermstructure.hpp>
+
+namespace QuantLib {
+
+    /*! Simulates the state of a Gaussian one-factor model, e.g. Gsr
+      (or a Hull-White model expressed as a Gsr), on a grid made of
+      the exposure dates and of the fixing dates of the floating
+      coupons, and values the netted swaps on each path and exposure
+      date in closed form.
+
+      The transition of the state process, the zero bonds and the
+      numeraire of the model must be log-affine in the state, as is
+      the case for Gsr; this is checked at each grid time, so that
+      models such as MarkovFunctional are rejected.  The coefficients
+      are calculated once per grid time, so that the paths, which are
+      run in parallel when OpenMP is enabled, only involve
+      arithmetic.  Unfixed floating coupons are valued on their
+      forward rates, fixed ones on the rate fixed on the path.
+
+      Nothing is streamed: the normal variates (samples times grid
+      times) are drawn upfront so that results don't depend on the
+      number of threads, and the netted values and deflators
+      (samples times exposure dates each) are kept for every date
+      and path, which makes percentiles exact.  The memory needed is
+      therefore about \f$ 8 N (G + 2E) \f$ bytes for \f$ N \f$
+      samples, \f$ G \f$ grid times and \f$ E \f$ exposure dates.
+
+      Expected exposures are discounted with the model numeraire,
+      potential future exposures are percentiles of the undiscounted
+      positive exposure.  CVA and DVA are obtained by weighting the
+      expected exposures at each date with the default probability
+      since the previous one.  Collateral is not considered, nor is
+      wrong way risk.
+
+      \test the expected exposure of a single swap is checked against
+            the prices of the corresponding European swaptions, and
+            offsetting swaps are checked to net to zero.
+    */
+    class NettingSetExposure {
+      public:
+        NettingSetExposure(ext::shared_ptr<Gaussian1dModel> model,
+                           std::vector<ext::shared_ptr<VanillaSwap> > swaps,
+                           std::vector<Date> exposureDates,
+                           Size samples,
+                           BigNatural seed = 42);
+
+        const std::vector<Date>& dates() const { return dates_; }
+        const std::vector<Time>& times() const { return times_; }
+        //! netted values, one row per date and one column per path
+        const Matrix& values() const { return values_; }
+
+        //! discounted expected positive exposures
+        std::vector<Real> expectedPositiveExposure() const;
+        //! discounted expected negative exposures, as positive numbers
+        std::vector<Real> expectedNegativeExposure() const;
+        //! percentiles of the positive exposures, e.g. 0.95
+        std::vector<Real> potentialFutureExposure(Real percentile) const;
+
+        Real cva(const Handle<DefaultProbabilityTermStructure>& ctptyDTS,
+                 Real ctptyRecoveryRate) const;
+        Real dva(const Handle<DefaultProbabilityTermStructure>& invstDTS,
+                 Real invstRecoveryRate) const;
+
+      private:
+        std::vector<Real> expectedExposure(Real sign) const;
+        Real adjustment(const std::vector<Real>& exposure,
+                        const Handle<DefaultProbabilityTermStructure>& dts,
+                        Real recoveryRate) const;
+
+        ext::shared_ptr<Gaussian1dModel> model_;
+        std::vector<ext::shared_ptr<VanillaSwap> > swaps_;
+        std::vector<Date> dates_;
+        std::vector<Time> times_;
+        Size samples_;
+        Matrix values_, deflators_;
+    };
+
+}
+
+#endif
@@ -0,0 +1,196 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+  This file is part of QuantLib, a free-software/open-source library
+  for financial quantitative analysts and developers - http://quantlib.org/
+
+  QuantLib is free software: you can redistribute it and/or modify it
+  under the terms of the QuantLib license.  You should have received a
+  copy of the license along with this program; if not, please email
+  <quantlib-dev@lists.sf.net>. The license is also available online at
+  <http://quantlib.org/license.shtml>.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/risk/scenarioanalysis.hpp>
+#include <ql/instrument.hpp>
+#include <ql/math/matrixutilities/pseudosqrt.hpp>
+#include <ql/math/randomnumbers/rngtraits.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <numeric>
+
+using std::vector;
+
+namespace QuantLib {
+
+    Matrix historicalScenarios(const vector<TimeSeries<Real> >& histories,
+                               Size horizon,
+                               bool relative) {
+        QL_REQUIRE(!histories.empty(), "no histories given");
+        QL_REQUIRE(horizon > 0, "null horizon");
+        Size n = histories.size();
+
+        vector<vector<Real> > values;
+        vector<Real> v(n);
+        for (const auto& observation : histories[0]) {
+            v[0] = observation.second;
+            bool complete = (v[0] != Null<Real>());
+            for (Size i=1; i<n && complete; ++i) {
+                v[i] = histories[i][observation.first];
+                complete = (v[i] != Null<Real>());
+            }
+            if (complete)
+                values.push_back(v);
+        }
+        QL_REQUIRE(values.size() > horizon,
+                   values.size() << " common observations given, "
+                   "at least " << horizon+1 << " required");
+
+        Matrix scenarios(values.size()-horizon, n);
+        for (Size k=0; k<scenarios.rows(); ++k) {
+            const vector<Real>& from = values[k];
+            const vector<Real>& to = values[k+horizon];
+            for (Size i=0; i<n; ++i) {
+                if (relative) {
+                    QL_REQUIRE(from[i] != 0.0,
+                               "null value in history #" << i+1);
+                    scenarios[k][i] = to[i]/from[i] - 1.0;
+                } else {
+                    scenarios[k][i] = to[i] - from[i];
+                }
+            }
+        }
+        return scenarios;
+    }
+
+    Matrix simulatedScenarios(const Matrix& covariance,
+                              Size samples,
+                              BigNatural seed) {
+        QL_REQUIRE(covariance.rows() == covariance.columns(),
+                   "covariance matrix not square");
+        QL_REQUIRE(covariance.rows() > 0, "empty covariance matrix");
+        Size n = covariance.rows();
+
+        Matrix root = pseudoSqrt(covariance, SalvagingAlgorithm::Spectral);
+        PseudoRandom::rsg_type rsg =
+            PseudoRandom::make_sequence_generator(n, seed);
+
+        Matrix scenarios(samples, n);
+        for (Size k=0; k<samples; ++k) {
+            const vector<Real>& z = rsg.nextSequence().value;
+            for (Size i=0; i<n; ++i)
+                scenarios[k][i] =
+                    std::inner_product(z.begin(), z.end(),
+                                       root.row_begin(i), Real(0.0));
+        }
+        return scenarios;
+    }
+
+    namespace {
+
+        void revalueScenarios(const SensitivityGraph& graph,
+                              const vector<Real>& quantities,
+                              Real referenceNpv,
+                              const Matrix& scenarios,
+                              Size begin, Size end,
+                              bool relative,
+                              GeneralStatistics& pnl) {
+            const vector<Handle<SimpleQuote> >& quotes = graph.quotes;
+            Size n = quotes.size();
+
+            vector<Real> quoteValues(n, Null<Real>());
+            for (Size i=0; i<n; ++i)
+                if (quotes[i]->isValid())
+                    quoteValues[i] = quotes[i]->value();
+
+            pnl.reserve(end-begin);
+            try {
+                for (Size k=begin; k<end; ++k) {
+                    for (Size i=0; i<n; ++i) {
+                        if (quoteValues[i] == Null<Real>())
+                            continue;
+                        Real shift = scenarios[k][i];
+                        if (relative)
+                            shift *= quoteValues[i];
+                        quotes[i]->setValue(quoteValues[i]+shift);
+                    }
+                    pnl.add(aggregateNPV(graph.instruments, quantities)
+                            - referenceNpv);
+                }
+            } catch (...) {
+                for (Size i=0; i<n; ++i)
+                    if (quoteValues[i] != Null<Real>())
+                        quotes[i]->setValue(quoteValues[i]);
+                throw;
+            }
+            for (Size i=0; i<n; ++i)
+                if (quoteValues[i] != Null<Real>())
+                    quotes[i]->setValue(quoteValues[i]);
+
+            // sorting in parallel speeds up the percentiles
+            pnl.sort();
+        }
+
+    }
+
+    void scenarioRevaluation(GeneralStatistics& pnl,
+                             const ext::function<SensitivityGraph()>& factory,
+                             Size graphs,
+                             const Matrix& scenarios,
+                             const vector<Real>& quantities,
+                             bool relative) {
+        vector<SensitivityGraph> g = buildSensitivityGraphs(factory, graphs);
+        QL_REQUIRE(g[0].quotes.size() == scenarios.columns(),
+                   "graphs have " << g[0].quotes.size()
+                   << " quotes, instead of " << scenarios.columns());
+        vector<Real> referenceNpv(graphs);
+        for (Size k=0; k<graphs; ++k)
+            referenceNpv[k] = aggregateNPV(g[k].instruments, quantities);
+
+        Size m = scenarios.rows();
+        vector<GeneralStatistics> blocks(graphs);
+        forEachSensitivityGraph(graphs, [&](Size k) {
+            revalueScenarios(g[k], quantities, referenceNpv[k],
+                             scenarios, (k*m)/graphs, ((k+1)*m)/graphs,
+                             relative, blocks[k]);
+        });
+
+        for (Size k=0; k<graphs; ++k)
+            pnl.merge(blocks[k]);
+    }
+
+    void deltaGammaRevaluation(GeneralStatistics& pnl,
+                               const vector<Real>& delta,
+                               const vector<Real>& gamma,
+                               const Matrix& scenarios,
+                               const vector<Real>& levels) {
+        Size n = delta.size();
+        QL_REQUIRE(scenarios.columns() == n,
+                   "dimension mismatch between scenarios ("
+                   << scenarios.columns() << ") and deltas (" << n << ")");
+        QL_REQUIRE(gamma.empty() || gamma.size() == n,
+                   "dimension mismatch between deltas (" << n
+                   << ") and gammas (" << gamma.size() << ")");
+        QL_REQUIRE(levels.empty() || levels.size() == n,
+                   "dimension mismatch between deltas (" << n
+                   << ") and levels (" << levels.size() << ")");
+
+        pnl.reserve(pnl.samples() + scenarios.rows());
+        for (Size k=0; k<scenarios.rows(); ++k) {
+            Real result = 0.0;
+            for (Size i=0; i<n; ++i) {
+                Real shift = scenarios[k][i];
+                if (!levels.empty())
+                    shift *= levels[i];
+                result += delta[i]*shift;
+                if (!gamma.empty())
+                    result += 0.5*gamma[i]*shift*shift;
+            }
+            pnl.add(result);
+        }
+    }
+
+}
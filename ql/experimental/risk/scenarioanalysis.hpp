@@ -0,0 +1,94 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+  This file is part of QuantLib, a free-software/open-source library
+  for financial quantitative analysts and developers - http://quantlib.org/
+
+  QuantLib is free software: you can redistribute it and/or modify it
+  under the terms of the QuantLib license.  You should have received a
+  copy of the license along with this program; if not, please email
+  <quantlib-dev@lists.sf.net>. The license is also available online at
+  <http://quantlib.org/license.shtml>.
+
+  This program is distributed in the hope that it will be useful, but WITHOUT
+  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file scenarioanalysis.hpp
+    \brief scenario generation and revaluation for value-at-risk
+*/
+
+#ifndef quantlib_scenario_analysis_hpp
+#define quantlib_scenario_analysis_hpp
+
+#include <ql/experimental/risk/sensitivityanalysis.hpp>
+#include <ql/math/statistics/generalstatistics.hpp>
+#include <ql/timeseries.hpp>
+
+namespace QuantLib {
+
+    //! quote changes observed in the past
+    /*! returns a matrix with one row per scenario and one column per
+        quote.  Only the dates on which every history has a value are
+        used; each scenario is the change between one of them and the
+        one \c horizon observations later, either absolute or
+        relative, i.e., \f$ x(t_{k+h})/x(t_k)-1 \f$.  Scenarios
+        overlap when the horizon is longer than one observation.
+    */
+    Matrix historicalScenarios(const std::vector<TimeSeries<Real> >& histories,
+                               Size horizon = 1,
+                               bool relative = false);
+
+    //! normally distributed quote changes
+    /*! returns a matrix with one row per scenario and one column per
+        quote; the changes have null mean and the given covariance,
+        e.g., estimated from historical scenarios.
+    */
+    Matrix simulatedScenarios(const Matrix& covariance,
+                              Size samples,
+                              BigNatural seed = 42);
+
+    //! full revaluation of a portfolio under the given scenarios
+    /*! The profit and loss of the weighted instruments under each
+        scenario is added to the given statistics, e.g., a
+        RiskStatistics from which value at risk and expected
+        shortfall can be read.  The scenarios are applied to the
+        quotes as absolute or relative changes.
+
+        The graphs are built by buildSensitivityGraphs() and the
+        scenarios are split in as many contiguous blocks, each
+        revalued on its own graph by forEachSensitivityGraph().  Each
+        block streams its results into its own data set, which is
+        sorted and then merged into the statistics in order.
+
+        Empty quantities vector is considered as unit vector.
+    */
+    void scenarioRevaluation(GeneralStatistics& pnl,
+                             const ext::function<SensitivityGraph()>& factory,
+                             Size graphs,
+                             const Matrix& scenarios,
+                             const std::vector<Real>& quantities,
+                             bool relative = false);
+
+    //! delta-gamma approximation of the scenario profit and loss
+    /*! The profit and loss under each scenario is approximated as
+        \f$ \sum_i \delta_i \Delta x_i + \frac{1}{2} \gamma_i \Delta x_i^2 \f$
+        and added to the given statistics.  The portfolio deltas and
+        gammas can be obtained by weighting the columns of the
+        matrices returned by bucketSensitivities with the quantities
+        of the instruments.
+
+        If quote levels are given, the scenarios are taken as changes
+        relative to them; otherwise, as absolute changes.
+    */
+    void deltaGammaRevaluation(GeneralStatistics& pnl,
+                               const std::vector<Real>& delta,
+                               const std::vector<Real>& gamma,
+                               const Matrix& scenarios,
+                               const std::vector<Real>& levels =
+                                                        std::vector<Real>());
+
+}
+
+#endif
@@ -20,6 +20,7 @@
 #include <ql/experimental/risk/sensitivityanalysis.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/instrument.hpp>
+#include <string>
 
 using std::vector;
 using std::pair;
@@ -344,4 +345,188 @@ namespace QuantLib {
         return result;
     }
 
+    namespace {
+
+        class NotificationFlag : public Observer {
+          public:
+            explicit NotificationFlag(const ext::shared_ptr<Observable>& o)
+            : notified(false) {
+                registerWith(o);
+            }
+            void update() override { notified = true; }
+            bool notified;
+        };
+
+        void bumpQuotes(const SensitivityGraph& graph,
+                        const vector<Real>& referenceNpv,
+                        Size begin, Size end,
+                        Real shift,
+                        SensitivityAnalysis type,
+                        Matrix& delta,
+                        Matrix& gamma) {
+            const vector<Handle<SimpleQuote> >& quotes = graph.quotes;
+            const vector<ext::shared_ptr<Instrument> >& instr =
+                graph.instruments;
+            Size m = instr.size();
+
+            vector<ext::shared_ptr<NotificationFlag> > flags(m);
+            for (Size j=0; j<m; ++j)
+                flags[j] = ext::make_shared<NotificationFlag>(instr[j]);
+
+            vector<Size> affected;
+            vector<Real> npv;
+            affected.reserve(m);
+            npv.reserve(m);
+            for (Size i=begin; i<end; ++i) {
+                if (!quotes[i]->isValid()) continue;
+                Real quoteValue = quotes[i]->value();
+
+                try {
+                    for (Size j=0; j<m; ++j)
+                        flags[j]->notified = false;
+                    quotes[i]->setValue(quoteValue+shift);
+                    affected.clear();
+                    for (Size j=0; j<m; ++j)
+                        if (flags[j]->notified)
+                            affected.push_back(j);
+
+                    npv.resize(affected.size());
+                    for (Size k=0; k<affected.size(); ++k)
+                        npv[k] = instr[affected[k]]->NPV();
+                    switch (type) {
+                      case OneSide:
+                        for (Size k=0; k<affected.size(); ++k) {
+                            Size j = affected[k];
+                            delta[i][j] = (npv[k]-referenceNpv[j])/shift;
+                        }
+                        break;
+                      case Centered:
+                        quotes[i]->setValue(quoteValue-shift);
+                        for (Size k=0; k<affected.size(); ++k) {
+                            Size j = affected[k];
+                            Real npv2 = instr[j]->NPV();
+                            delta[i][j] = (npv[k]-npv2)/(2.0*shift);
+                            gamma[i][j] = (npv[k]-2.0*referenceNpv[j]+npv2)
+                                        / (shift*shift);
+                        }
+                        break;
+                      default:
+                        QL_FAIL("unknown SensitivityAnalysis (" <<
+                                Integer(type) << ")");
+                    }
+
+                    quotes[i]->setValue(quoteValue);
+                    // lazy objects only forward notifications when
+                    // calculated, so the next tweak would go unnoticed
+                    for (Size k=0; k<affected.size(); ++k)
+                        instr[affected[k]]->NPV();
+                } catch (...) {
+                    quotes[i]->setValue(quoteValue);
+                    throw;
+                }
+            }
+        }
+
+        pair<Matrix, Matrix> emptySensitivities(Size n, Size m,
+                                                SensitivityAnalysis type) {
+            Real gamma = (type == OneSide ? Real(Null<Real>()) : 0.0);
+            return pair<Matrix, Matrix>(Matrix(n, m, 0.0),
+                                        Matrix(n, m, gamma));
+        }
+
+        vector<Real> referenceValues(const SensitivityGraph& graph) {
+            vector<Real> npv(graph.instruments.size());
+            for (Size j=0; j<npv.size(); ++j)
+                npv[j] = graph.instruments[j]->NPV();
+            return npv;
+        }
+
+    }
+
+    vector<SensitivityGraph>
+    buildSensitivityGraphs(const ext::function<SensitivityGraph()>& factory,
+                           Size graphs) {
+        QL_REQUIRE(graphs>0, "at least one graph required");
+
+        vector<SensitivityGraph> g(graphs);
+        for (Size k=0; k<graphs; ++k) {
+            g[k] = factory();
+            QL_REQUIRE(g[k].quotes.size() == g[0].quotes.size() &&
+                       g[k].instruments.size() == g[0].instruments.size(),
+                       "graph #" << k+1 << " has " << g[k].quotes.size()
+                       << " quotes and " << g[k].instruments.size()
+                       << " instruments, instead of " << g[0].quotes.size()
+                       << " and " << g[0].instruments.size());
+        }
+        return g;
+    }
+
+    void forEachSensitivityGraph(Size graphs,
+                                 const ext::function<void(Size)>& f) {
+        vector<std::string> messages(graphs);
+        #pragma omp parallel for schedule(dynamic)
+        for (long k=0; k<(long)graphs; ++k) {
+            try {
+                f(k);
+            } catch (std::exception& e) {
+                messages[k] = e.what();
+            }
+        }
+        for (Size k=0; k<graphs; ++k)
+            QL_REQUIRE(messages[k].empty(),
+                       "graph #" << k+1 << ": " << messages[k]);
+    }
+
+    pair<Matrix, Matrix>
+    bucketSensitivities(const vector<Handle<SimpleQuote> >& quotes,
+                        const vector<ext::shared_ptr<Instrument> >& instr,
+                        Real shift,
+                        SensitivityAnalysis type) {
+        QL_REQUIRE(!quotes.empty(), "empty SimpleQuote vector");
+        QL_REQUIRE(shift!=0.0, "zero shift not allowed");
+        QL_REQUIRE(ObservableSettings::instance().updatesEnabled(),
+                   "notifications must be enabled");
+
+        pair<Matrix, Matrix> result =
+            emptySensitivities(quotes.size(), instr.size(), type);
+        if (instr.empty()) return result;
+
+        SensitivityGraph graph;
+        graph.quotes = quotes;
+        graph.instruments = instr;
+        bumpQuotes(graph, referenceValues(graph), 0, quotes.size(),
+                   shift, type, result.first, result.second);
+        return result;
+    }
+
+    pair<Matrix, Matrix>
+    bucketSensitivities(const ext::function<SensitivityGraph()>& factory,
+                        Size graphs,
+                        Real shift,
+                        SensitivityAnalysis type) {
+        QL_REQUIRE(graphs>0, "at least one graph required");
+        QL_REQUIRE(shift!=0.0, "zero shift not allowed");
+        QL_REQUIRE(ObservableSettings::instance().updatesEnabled(),
+                   "notifications must be enabled");
+
+        vector<SensitivityGraph> g = buildSensitivityGraphs(factory, graphs);
+        vector<vector<Real> > referenceNpv(graphs);
+        for (Size k=0; k<graphs; ++k)
+            referenceNpv[k] = referenceValues(g[k]);
+
+        Size n = g[0].quotes.size();
+        QL_REQUIRE(n>0, "empty SimpleQuote vector");
+        pair<Matrix, Matrix> result =
+            emptySensitivities(n, g[0].instruments.size(), type);
+        if (g[0].instruments.empty()) return result;
+
+        forEachSensitivityGraph(graphs, [&](Size k) {
+            bumpQuotes(g[k], referenceNpv[k], (k*n)/graphs,
+                       ((k+1)*n)/graphs, shift, type,
+                       result.first, result.second);
+        });
+
+        return result;
+    }
+
 }
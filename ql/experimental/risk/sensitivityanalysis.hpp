@@ -27,12 +27,13 @@
 #include <ql/types.hpp>
 #include <ql/utilities/null.hpp>
 #include <ql/shared_ptr.hpp>
+#include <ql/functional.hpp>
+#include <ql/handle.hpp>
+#include <ql/math/matrix.hpp>
 #include <vector>
 
 namespace QuantLib {
 
-    template <class T>
-    class Handle;
     class Quote;
     class SimpleQuote;
     class Instrument;
@@ -173,6 +174,67 @@ namespace QuantLib {
                    Real shift = 0.0001,
                    SensitivityAnalysis type = Centered);
 
+    //! quotes and the instruments depending on them
+    /*! The instruments of a graph must not share any observable or
+        lazy object (curves, indexes, engines) with those of another
+        graph; only the evaluation date and the fixings are shared.
+    */
+    struct SensitivityGraph {
+        std::vector<Handle<SimpleQuote> > quotes;
+        std::vector<ext::shared_ptr<Instrument> > instruments;
+    };
+
+    //! builds the given number of graphs
+    /*! The factory is called serially, so that the graphs can
+        register with the evaluation date and other singletons.  The
+        graphs must have the same numbers of quotes and instruments.
+
+        \warning pricing an instrument must not register observers
+                 with, or modify, anything shared between the graphs.
+    */
+    std::vector<SensitivityGraph>
+    buildSensitivityGraphs(const ext::function<SensitivityGraph()>& factory,
+                           Size graphs);
+
+    //! calls the given function on the index of each graph
+    /*! The calls are made in parallel when OpenMP is enabled.  An
+        exception thrown for a graph doesn't stop the others; it is
+        rethrown, with the index of the first failing graph, after
+        all of them were processed.
+    */
+    void forEachSensitivityGraph(Size graphs,
+                                 const ext::function<void(Size)>& f);
+
+    //! bucket sensitivities of each instrument to each SimpleQuote
+    /*! returns a pair of first and second derivative matrices, with
+        one row per quote and one column per instrument, calculated as
+        prescribed by SensitivityAnalysis. Second derivatives are null
+        for OneSide analysis.
+
+        The quotes are tweaked one by one separately.  The observer
+        graph is used to find the instruments notified by a tweak:
+        only these are revalued, and the others get zero sensitivity.
+        For this reason, notifications must not be disabled.
+    */
+    std::pair<Matrix, Matrix>
+    bucketSensitivities(const std::vector<Handle<SimpleQuote> >& quotes,
+                        const std::vector<ext::shared_ptr<Instrument> >&,
+                        Real shift = 0.0001,
+                        SensitivityAnalysis type = Centered);
+
+    //! bucket sensitivities on isolated copies of the object graph
+    /*! As above; the graphs are built by buildSensitivityGraphs()
+        with the same quotes and instruments in the same order, and
+        are valued once before tweaking.  The quotes are then split
+        in as many contiguous blocks, each tweaked on its own graph
+        by forEachSensitivityGraph().
+    */
+    std::pair<Matrix, Matrix>
+    bucketSensitivities(const ext::function<SensitivityGraph()>& factory,
+                        Size graphs,
+                        Real shift = 0.0001,
+                        SensitivityAnalysis type = Centered);
+
 }
 
 #endif
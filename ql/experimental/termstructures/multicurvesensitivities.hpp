@@ -54,6 +54,12 @@ constructions, e.g. ZeroYield, Discountfactors or ForwardRates) and the the \f$(
 quoted par rates.
 
 
+When constructed with the \c ImplicitFunction method, the bumping and re-stripping of the curves is
+avoided: the sensitivities \f$ \partial q_i / \partial z_j \f$ of the rates implied by the helpers of all
+curves to all node values are computed on the already stripped curves by
+PiecewiseYieldCurve::impliedQuoteSensitivities, and the resulting matrix is inverted (implicit function
+theorem). This requires a single bootstrap of each curve.
+
 \note It's the users job to provide all curves that <em>influence</em> the implied rates.
 
     \ingroup yieldtermstructures
@@ -64,11 +70,15 @@ private:
   typedef std::map< std::string, Handle< YieldTermStructure > > curvespec;
 
 public:
+  enum Method { Bumping, ImplicitFunction };
+
   //! Multi curve sensitivties
   /*! @param curves std::map of string (curve name) and handle to piecewiseyieldcurve
+      @param method whether to bump and re-strip the curves or to use the implicit function theorem
   */
 
-  explicit MultiCurveSensitivities(curvespec curves) : curves_(std::move(curves)) {
+  explicit MultiCurveSensitivities(curvespec curves, Method method = Bumping)
+  : method_(method), curves_(std::move(curves)) {
       for (curvespec::const_iterator it = curves_.begin(); it != curves_.end(); ++it)
           registerWith((*it).second);
       for (curvespec::const_iterator it = curves_.begin(); it != curves_.end(); ++it) {
@@ -77,6 +87,7 @@ public:
                   it->second.currentLink());
           QL_REQUIRE(curve != nullptr, "Couldn't cast curvename: " << it->first);
           for (auto& instrument : curve->instruments_) {
+              allHelpers_.push_back(instrument);
               allQuotes_.push_back(instrument->quote());
               std::stringstream tmp;
               tmp << QuantLib::io::iso_date(instrument->latestRelevantDate());
@@ -95,9 +106,13 @@ private:
   void performCalculations() const override;
   //@}
   // methods
+  void calculateByBumping() const;
+  void calculateByImplicitFunction() const;
   std::vector< Real > allZeros() const;
   std::vector< std::pair< Date, Real > > allNodes() const;
+  Method method_;
   mutable std::vector< Rate > origZeros_;
+  std::vector< ext::shared_ptr< RateHelper > > allHelpers_;
   std::vector< Handle< Quote > > allQuotes_;
   std::vector< std::pair< Date, Real > > origNodes_;
   mutable Matrix sensi_, invSensi_;
@@ -106,6 +121,13 @@ private:
 };
 
 inline void MultiCurveSensitivities::performCalculations() const {
+  if (method_ == ImplicitFunction)
+      calculateByImplicitFunction();
+  else
+      calculateByBumping();
+}
+
+inline void MultiCurveSensitivities::calculateByBumping() const {
   std::vector< Rate > sensiVector;
   origZeros_ = allZeros();
   for (const auto& allQuote : allQuotes_) {
@@ -129,6 +151,29 @@ inline void MultiCurveSensitivities::performCalculations() const {
   invSensi_ = inverse(sensi_);
 }
 
+inline void MultiCurveSensitivities::calculateByImplicitFunction() const {
+  origZeros_ = allZeros();
+  Size n = origZeros_.size();
+  QL_REQUIRE(allHelpers_.size() == n,
+             "number of quotes (" << allHelpers_.size() << ") differs from number of nodes (" << n << ")");
+  // dq_i/dz_j, with i running over the quotes and j over the nodes of all curves
+  Matrix dqdz(n, n);
+  Size j = 0;
+  for (const auto& it : curves_) {
+      ext::shared_ptr<PiecewiseYieldCurve<ZeroYield, Linear> > curve =
+          ext::dynamic_pointer_cast<PiecewiseYieldCurve<ZeroYield, Linear> >(
+              it.second.currentLink());
+      Matrix block = curve->impliedQuoteSensitivities(allHelpers_);
+      QL_REQUIRE(j + block.columns() <= n, "more nodes than quotes in curve " << it.first);
+      for (Size i = 0; i < n; ++i)
+          std::copy(block.row_begin(i), block.row_end(i), dqdz.row_begin(i) + j);
+      j += block.columns();
+  }
+  // same layout as the bumped sensitivities, i.e., dz_j/dq_i in row i and column j
+  invSensi_ = transpose(dqdz);
+  sensi_ = inverse(invSensi_);
+}
+
 inline Matrix MultiCurveSensitivities::sensitivities() const {
   calculate();
   return sensi_;
@@ -21,16 +21,38 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/experimental/variancegamma/fftengine.hpp>
 #include <ql/math/fastfouriertransform.hpp>
 #include <ql/math/interpolations/linearinterpolation.hpp>
+#include <ql/utilities/null.hpp>
+#include <algorithm>
 #include <complex>
 #include <utility>
 
 namespace QuantLib {
 
     FFTEngine::FFTEngine(ext::shared_ptr<StochasticProcess1D> process, Real logStrikeSpacing)
-    : process_(std::move(process)), lambda_(logStrikeSpacing) {
+    : process_(std::move(process)), lambda_(logStrikeSpacing),
+      gridPoints_(0), eta_(Null<Real>()),
+      maxEta_(Null<Real>()) {
         registerWith(process_);
     }
 
+    FFTEngine::FFTEngine(Real logStrikeSpacing)
+    : lambda_(logStrikeSpacing), gridPoints_(0), eta_(Null<Real>()),
+      maxEta_(Null<Real>()) {}
+
+    void FFTEngine::enableFractionalFFT(Size gridPoints,
+                                        Real integrationSpacing) {
+        QL_REQUIRE(gridPoints > 1, "at least two grid points required");
+        QL_REQUIRE(integrationSpacing > 0.0,
+                   "positive integration spacing required");
+        gridPoints_ = gridPoints;
+        eta_ = integrationSpacing;
+        resultMap_.clear();
+    }
+
+    Real FFTEngine::spotPrice() const {
+        return process_->x0();
+    }
+
     void FFTEngine::calculate() const
     {
         QL_REQUIRE(arguments_.exercise->type() == Exercise::European,
@@ -71,6 +93,8 @@ namespace QuantLib {
         optionList.push_back(option);
 
         ext::shared_ptr<FFTEngine> tempEngine(clone().release());
+        if (eta_ != Null<Real>())
+            tempEngine->enableFractionalFFT(gridPoints_, eta_);
         tempEngine->precalculate(optionList);
         option->setPricingEngine(tempEngine);
         results_.value = option->NPV();
@@ -105,22 +129,40 @@ namespace QuantLib {
         {
             Date expiryDate = payIt->first;
 
-            // Calculate n large enough for maximum strike, and round up to a power of 2
-            Real maxStrike = 0.0;
+            Real maxStrike = 0.0, minStrike = QL_MAX_REAL;
             for (const auto& payoff : payIt->second) {
-                if (payoff->strike() > maxStrike)
-                    maxStrike = payoff->strike();
+                maxStrike = std::max(maxStrike, payoff->strike());
+                minStrike = std::min(minStrike, payoff->strike());
+            }
+
+            Size n, log2_n = 0;
+            Real eta, center = 0.0;
+            if (eta_ == Null<Real>()) {
+                // Calculate n large enough for maximum strike, and round up to a power of 2
+                Real nR = 2.0 * (std::log(maxStrike) + lambda_) / lambda_;
+                // and for the integration spacing not to exceed its bound
+                if (maxEta_ != Null<Real>())
+                    nR = std::max(nR, 2.0 * M_PI / (lambda_ * maxEta_));
+                log2_n = (static_cast<Size>((std::log(nR) / std::log(2.0))) + 1);
+                n = static_cast<std::size_t>(1) << log2_n;
+
+                // Grid spacing (equation 23)
+                eta = 2.0 * M_PI / (lambda_ * n);
+            } else {
+                // the grid is centered on the strikes and must cover them
+                n = gridPoints_;
+                eta = eta_;
+                center = 0.5 * (std::log(maxStrike) + std::log(minStrike));
+                QL_REQUIRE(n * lambda_ / 2.0 - lambda_
+                               > 0.5 * (std::log(maxStrike) - std::log(minStrike)),
+                           "log-strike grid (" << n << " points, spacing "
+                           << lambda_ << ") too small for strikes between "
+                           << minStrike << " and " << maxStrike);
             }
-            Real nR = 2.0 * (std::log(maxStrike) + lambda_) / lambda_;
-      Size log2_n = (static_cast<Size>((std::log(nR) / std::log(2.0))) + 1);
-            Size n = static_cast<std::size_t>(1) << log2_n;
 
             // Strike range (equation 19,20)
             Real b = n * lambda_ / 2.0;
 
-            // Grid spacing (equation 23)
-            Real eta = 2.0 * M_PI / (lambda_ * n);
-
             // Discount factor
             Real df = discountFactor(expiryDate);
             Real div = dividendYield(expiryDate);
@@ -140,13 +182,18 @@ namespace QuantLib {
                 std::complex<Real> psi = df * complexFourierTransform(v_j - (alpha + 1)* i1);
                 psi = psi / (alpha*alpha + alpha - v_j*v_j + i1 * (2 * alpha + 1.0) * v_j);
 
-                fti[i] = std::exp(i1 * b * v_j)  * sw * psi;
+                fti[i] = std::exp(i1 * (b - center) * v_j)  * sw * psi;
             }
 
             // Perform fft
             std::vector<std::complex<Real> > results(n);
-            FastFourierTransform fft(log2_n);
-            fft.transform(fti.begin(), fti.end(), results.begin());
+            if (eta_ == Null<Real>()) {
+                FastFourierTransform fft(log2_n);
+                fft.transform(fti.begin(), fti.end(), results.begin());
+            } else {
+                FractionalFourierTransform frft(n, eta * lambda_ / (2.0 * M_PI));
+                frft.transform(fti.begin(), fti.end(), results.begin());
+            }
 
             // Call prices
             std::vector<Real> prices, strikes;
@@ -154,7 +201,7 @@ namespace QuantLib {
             strikes.resize(n);
             for (Size i=0; i<n; i++)
             {
-                Real k_u = -b + lambda_ * i;
+                Real k_u = center - b + lambda_ * i;
                 prices[i] = (std::exp(-alpha * k_u) / M_PI) * results[i].real();
                 strikes[i] = std::exp(k_u);
             }
@@ -168,7 +215,7 @@ namespace QuantLib {
                     resultMap_[expiryDate][payoff] = callPrice;
                     break;
                 case Option::Put:
-                    resultMap_[expiryDate][payoff] = callPrice - process_->x0() * div + payoff->strike() * df;
+                    resultMap_[expiryDate][payoff] = callPrice - spotPrice() * div + payoff->strike() * df;
                     break;
                 default:
                     QL_FAIL("Invalid option type");
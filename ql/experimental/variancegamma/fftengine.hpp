@@ -38,10 +38,24 @@ namespace QuantLib {
         you should collect all the options you wish to price in a list and call 
         the engine's precalculate method before calling the NPV method of the option.
 
+        By default, the spacing of the integration grid is tied to the
+        log-strike spacing through \f$ \eta \lambda = 2\pi/n \f$,
+        with \f$ n \f$ a power of two; derived engines can bound the
+        integration spacing, in which case \f$ n \f$ is increased
+        accordingly.  Calling enableFractionalFFT()
+        uses a fractional FFT instead, so that the number of points
+        and the integration spacing can be chosen independently of the
+        strike spacing; the log-strike grid is then centered on the
+        strikes to be priced.
+
         References:
         Carr, P. and D. B. Madan (1998),
         "Option Valuation using the fast Fourier transform,"
         Journal of Computational Finance, 2, 61-73.
+
+        Chourdakis, K. (2004),
+        "Option pricing using the fractional FFT,"
+        Journal of Computational Finance, 8, 1-18.
     */
 
     class FFTEngine :
@@ -52,21 +66,31 @@ namespace QuantLib {
       void update() override;
 
       void precalculate(const std::vector<ext::shared_ptr<Instrument> >& optionList);
+
+      //! use a fractional FFT with the given grid size and integration spacing
+      void enableFractionalFFT(Size gridPoints, Real integrationSpacing);
         #if defined(QL_USE_STD_UNIQUE_PTR)
         virtual std::unique_ptr<FFTEngine> clone() const = 0;
         #else
         virtual std::auto_ptr<FFTEngine> clone() const = 0;
         #endif
     protected:
+        //! for engines driven by a model rather than by a 1-D process
+        explicit FFTEngine(Real logStrikeSpacing);
+
         virtual void precalculateExpiry(Date d) = 0;
         virtual std::complex<Real> complexFourierTransform(std::complex<Real> u) const = 0;
         virtual Real discountFactor(Date d) const = 0;
         virtual Real dividendYield(Date d) const = 0;
+        virtual Real spotPrice() const;
         void calculateUncached(const ext::shared_ptr<StrikedTypePayoff>& payoff,
                                const ext::shared_ptr<Exercise>& exercise) const;
 
         ext::shared_ptr<StochasticProcess1D> process_;
         Real lambda_;   // Log strike spacing
+        Size gridPoints_;   // fractional FFT only
+        Real eta_;   // integration spacing, fractional FFT only
+        Real maxEta_;   // upper bound on the integration spacing, power-of-two FFT only
 
     private:
         typedef std::map<ext::shared_ptr<StrikedTypePayoff>, Real> PayoffResultMap;
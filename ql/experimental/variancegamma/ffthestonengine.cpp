@@ -0,0 +1,144 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/variancegamma/ffthestonengine.hpp>
+#include <ql/auto_ptr.hpp>
+#include <ql/math/comparison.hpp>
+#include <ql/pricingengines/vanilla/batesengine.hpp>
+
+namespace QuantLib {
+
+    FFTHestonEngine::FFTHestonEngine(
+        const ext::shared_ptr<HestonModel>& model,
+        Real logStrikeSpacing, Real maxEta)
+    : FFTEngine(logStrikeSpacing), model_(model),
+      hestonEngine_(ext::make_shared<AnalyticHestonEngine>(model)) {
+        maxEta_ = maxEta;
+        registerWith(model_);
+    }
+
+    QL_UNIQUE_OR_AUTO_PTR<FFTEngine> FFTHestonEngine::clone() const {
+        return QL_UNIQUE_OR_AUTO_PTR<FFTEngine>(
+                               new FFTHestonEngine(model_, lambda_, maxEta_));
+    }
+
+    void FFTHestonEngine::precalculateExpiry(Date d) {
+        const ext::shared_ptr<HestonProcess>& process = model_->process();
+
+        dividendDiscount_ = process->dividendYield()->discount(d);
+        riskFreeDiscount_ = process->riskFreeRate()->discount(d);
+        t_ = process->time(d);
+    }
+
+    std::complex<Real> FFTHestonEngine::complexFourierTransform(
+                                                std::complex<Real> u) const {
+        const std::complex<Real> i1(0, 1);
+        const Real fwd = spotPrice()*dividendDiscount_/riskFreeDiscount_;
+
+        return std::exp(i1*u*std::log(fwd) + addOnTerm(u, t_))
+            * hestonEngine_->chF(u, t_);
+    }
+
+    std::complex<Real> FFTHestonEngine::addOnTerm(
+                                const std::complex<Real>&, Time) const {
+        return std::complex<Real>(0.0, 0.0);
+    }
+
+    Real FFTHestonEngine::discountFactor(Date d) const {
+        return model_->process()->riskFreeRate()->discount(d);
+    }
+
+    Real FFTHestonEngine::dividendYield(Date d) const {
+        return model_->process()->dividendYield()->discount(d);
+    }
+
+    Real FFTHestonEngine::spotPrice() const {
+        return model_->process()->s0()->value();
+    }
+
+
+    FFTBatesEngine::FFTBatesEngine(
+        const ext::shared_ptr<BatesModel>& model,
+        Real logStrikeSpacing, Real maxEta)
+    : FFTHestonEngine(model, logStrikeSpacing, maxEta) {}
+
+    QL_UNIQUE_OR_AUTO_PTR<FFTEngine> FFTBatesEngine::clone() const {
+        return QL_UNIQUE_OR_AUTO_PTR<FFTEngine>(
+            new FFTBatesEngine(
+                ext::dynamic_pointer_cast<BatesModel>(model_), lambda_,
+                maxEta_));
+    }
+
+    std::complex<Real> FFTBatesEngine::addOnTerm(
+                                const std::complex<Real>& u, Time t) const {
+        const ext::shared_ptr<BatesModel> batesModel =
+            ext::dynamic_pointer_cast<BatesModel>(model_);
+
+        return BatesEngine::jumpTerm(std::complex<Real>(0, 1)*u, t,
+                                     batesModel->lambda(),
+                                     batesModel->nu(),
+                                     batesModel->delta());
+    }
+
+
+    FFTPTDHestonEngine::FFTPTDHestonEngine(
+        const ext::shared_ptr<PiecewiseTimeDependentHestonModel>& model,
+        Real logStrikeSpacing, Real maxEta)
+    : FFTEngine(logStrikeSpacing), model_(model),
+      hestonEngine_(ext::make_shared<AnalyticPTDHestonEngine>(model)) {
+        maxEta_ = maxEta;
+        registerWith(model_);
+    }
+
+    QL_UNIQUE_OR_AUTO_PTR<FFTEngine> FFTPTDHestonEngine::clone() const {
+        return QL_UNIQUE_OR_AUTO_PTR<FFTEngine>(
+                           new FFTPTDHestonEngine(model_, lambda_, maxEta_));
+    }
+
+    void FFTPTDHestonEngine::precalculateExpiry(Date d) {
+        dividendDiscount_ = model_->dividendYield()->discount(d);
+        riskFreeDiscount_ = model_->riskFreeRate()->discount(d);
+        t_ = model_->riskFreeRate()->dayCounter().yearFraction(
+                                    model_->riskFreeRate()->referenceDate(), d);
+
+        QL_REQUIRE(t_ < model_->timeGrid().back() ||
+                       close_enough(t_, model_->timeGrid().back()),
+                   "maturity (" << t_ << ") is too large, time grid is bounded by "
+                                << model_->timeGrid().back());
+    }
+
+    std::complex<Real> FFTPTDHestonEngine::complexFourierTransform(
+                                                std::complex<Real> u) const {
+        const std::complex<Real> i1(0, 1);
+        const Real fwd = spotPrice()*dividendDiscount_/riskFreeDiscount_;
+
+        return std::exp(i1*u*std::log(fwd)) * hestonEngine_->chF(u, t_);
+    }
+
+    Real FFTPTDHestonEngine::discountFactor(Date d) const {
+        return model_->riskFreeRate()->discount(d);
+    }
+
+    Real FFTPTDHestonEngine::dividendYield(Date d) const {
+        return model_->dividendYield()->discount(d);
+    }
+
+    Real FFTPTDHestonEngine::spotPrice() const {
+        return model_->s0();
+    }
+
+}
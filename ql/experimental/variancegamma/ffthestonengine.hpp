@@ -0,0 +1,140 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file ffthestonengine.hpp
+    \brief FFT engines for vanilla options under Heston-type models
+*/
+
+#ifndef quantlib_fft_heston_engine_hpp
+#define quantlib_fft_heston_engine_hpp
+
+#include <ql/experimental/variancegamma/fftengine.hpp>
+#include <ql/models/equity/batesmodel.hpp>
+#include <ql/models/equity/piecewisetimedependenthestonmodel.hpp>
+#include <ql/pricingengines/vanilla/analytichestonengine.hpp>
+#include <ql/pricingengines/vanilla/analyticptdhestonengine.hpp>
+
+namespace QuantLib {
+
+    //! FFT engine for vanilla options under the Heston model
+    /*! The characteristic function is the one of the
+        AnalyticHestonEngine; all the options with the same expiry
+        passed to precalculate() are priced in a single transform.
+
+        With a power-of-two transform, the spacing of the integration
+        grid is bounded by maxEta, since the Simpson rule needs a
+        finer grid than the one implied by the strike range for short
+        maturities; pass Null<Real>() to use the latter.
+
+        \ingroup vanillaengines
+
+        \test the correctness of the returned values is tested by
+              comparison with the analytic Heston engine.
+    */
+    class FFTHestonEngine : public FFTEngine {
+      public:
+        explicit FFTHestonEngine(const ext::shared_ptr<HestonModel>& model,
+                                 Real logStrikeSpacing = 0.001,
+                                 Real maxEta = 0.1);
+        #if defined(QL_USE_STD_UNIQUE_PTR)
+        std::unique_ptr<FFTEngine> clone() const override;
+        #else
+        virtual std::auto_ptr<FFTEngine> clone() const;
+        #endif
+      protected:
+        void precalculateExpiry(Date d) override;
+        std::complex<Real> complexFourierTransform(std::complex<Real> u) const override;
+        Real discountFactor(Date d) const override;
+        Real dividendYield(Date d) const override;
+        Real spotPrice() const override;
+
+        //! log of an additional factor of the characteristic function
+        virtual std::complex<Real> addOnTerm(const std::complex<Real>& u,
+                                             Time t) const;
+
+        ext::shared_ptr<HestonModel> model_;
+
+      private:
+        ext::shared_ptr<AnalyticHestonEngine> hestonEngine_;
+        DiscountFactor dividendDiscount_;
+        DiscountFactor riskFreeDiscount_;
+        Time t_;
+    };
+
+
+    //! FFT engine for vanilla options under the Bates model
+    /*! \ingroup vanillaengines
+
+        \test the correctness of the returned values is tested by
+              comparison with the analytic Bates engine.
+    */
+    class FFTBatesEngine : public FFTHestonEngine {
+      public:
+        explicit FFTBatesEngine(const ext::shared_ptr<BatesModel>& model,
+                                Real logStrikeSpacing = 0.001,
+                                Real maxEta = 0.1);
+        #if defined(QL_USE_STD_UNIQUE_PTR)
+        std::unique_ptr<FFTEngine> clone() const override;
+        #else
+        virtual std::auto_ptr<FFTEngine> clone() const;
+        #endif
+      protected:
+        std::complex<Real> addOnTerm(const std::complex<Real>& u,
+                                     Time t) const override;
+    };
+
+
+    //! FFT engine for vanilla options under the piecewise time-dependent Heston model
+    /*! The integration spacing is bounded by maxEta as in
+        FFTHestonEngine.
+
+        \ingroup vanillaengines
+
+        \test the correctness of the returned values is tested by
+              comparison with the analytic piecewise time-dependent
+              Heston engine.
+    */
+    class FFTPTDHestonEngine : public FFTEngine {
+      public:
+        explicit FFTPTDHestonEngine(
+            const ext::shared_ptr<PiecewiseTimeDependentHestonModel>& model,
+            Real logStrikeSpacing = 0.001,
+            Real maxEta = 0.1);
+        #if defined(QL_USE_STD_UNIQUE_PTR)
+        std::unique_ptr<FFTEngine> clone() const override;
+        #else
+        virtual std::auto_ptr<FFTEngine> clone() const;
+        #endif
+      protected:
+        void precalculateExpiry(Date d) override;
+        std::complex<Real> complexFourierTransform(std::complex<Real> u) const override;
+        Real discountFactor(Date d) const override;
+        Real dividendYield(Date d) const override;
+        Real spotPrice() const override;
+
+      private:
+        ext::shared_ptr<PiecewiseTimeDependentHestonModel> model_;
+        ext::shared_ptr<AnalyticPTDHestonEngine> hestonEngine_;
+        DiscountFactor dividendDiscount_;
+        DiscountFactor riskFreeDiscount_;
+        Time t_;
+    };
+
+}
+
+
+#endif
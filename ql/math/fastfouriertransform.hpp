@@ -29,6 +29,7 @@
 
 #include <ql/errors.hpp>
 #include <ql/types.hpp>
+#include <complex>
 #include <vector>
 #include <iterator>
 
@@ -120,6 +121,77 @@ namespace QuantLib {
         }
     };
 
+
+    //! Fractional Fourier transform of arbitrary length
+    /*! Calculates
+        \f[
+            y_k = \sum_{j=0}^{n-1} x_j e^{-2 \pi i \alpha j k},
+            \qquad k = 0, \dots, n-1
+        \f]
+        for any size \f$ n \f$ using Bluestein's chirp-z algorithm,
+        i.e., as a convolution evaluated with power-of-two FFTs of
+        size at least \f$ 2n-1 \f$.  For \f$ \alpha = 1/n \f$ this is
+        the discrete Fourier transform of a sequence whose length is
+        not a power of two.
+
+        References:
+        D. H. Bailey and P. N. Swarztrauber (1991), "The fractional
+        Fourier transform and applications", SIAM Review, 33, 389-404.
+    */
+    class FractionalFourierTransform {
+      public:
+        FractionalFourierTransform(std::size_t n, Real alpha)
+        : n_(n), fft_(FastFourierTransform::min_order(n > 1 ? 2*n-1 : 2)),
+          chirp_(n), kernel_(fft_.output_size()) {
+            QL_REQUIRE(n > 0, "null transform size");
+
+            const std::size_t m = fft_.output_size();
+            for (std::size_t j = 0; j < n; ++j) {
+                // j*j is exact in double precision for any sensible n
+                const Real phase = M_PI*alpha*Real(j)*Real(j);
+                chirp_[j] = std::complex<Real>(std::cos(phase), -std::sin(phase));
+            }
+
+            std::vector<std::complex<Real> > b(m, std::complex<Real>(0.0));
+            b[0] = std::conj(chirp_[0]);
+            for (std::size_t j = 1; j < n; ++j)
+                b[j] = b[m-j] = std::conj(chirp_[j]);
+            fft_.transform(b.begin(), b.end(), kernel_.begin());
+        }
+
+        //! The size of the input and output sequences
+        std::size_t size() const { return n_; }
+
+        //! Fractional transform.
+        /*! The output sequence must be allocated by the user */
+        template<typename InputIterator, typename RandomAccessIterator>
+        void transform(InputIterator inBegin, InputIterator inEnd,
+                       RandomAccessIterator out) const {
+            const std::size_t m = fft_.output_size();
+
+            std::vector<std::complex<Real> > a(m, std::complex<Real>(0.0));
+            std::size_t j = 0;
+            for (; inBegin != inEnd; ++j, ++inBegin) {
+                QL_REQUIRE(j < n_, "too many input values");
+                a[j] = std::complex<Real>(*inBegin)*chirp_[j];
+            }
+
+            std::vector<std::complex<Real> > fa(m);
+            fft_.transform(a.begin(), a.end(), fa.begin());
+            for (std::size_t k = 0; k < m; ++k)
+                fa[k] *= kernel_[k];
+            fft_.inverse_transform(fa.begin(), fa.end(), a.begin());
+
+            for (std::size_t k = 0; k < n_; ++k)
+                *(out + k) = chirp_[k]*a[k]/Real(m);
+        }
+
+      private:
+        std::size_t n_;
+        FastFourierTransform fft_;
+        std::vector<std::complex<Real> > chirp_, kernel_;
+    };
+
 }
 
 #endif
@@ -31,6 +31,7 @@
 #include <ql/errors.hpp>
 #include <vector>
 #include <algorithm>
+#include <cmath>
 
 namespace QuantLib {
 
@@ -65,6 +66,18 @@ namespace QuantLib {
             virtual std::vector<Real> yValues() const = 0;
             virtual bool isInRange(Real) const = 0;
             virtual Real value(Real) const = 0;
+            /*! Same as value(x), but the position of x is looked up
+                starting from the interval index passed as hint; the
+                latter is updated with the actual position of x.
+                The default implementation ignores the hint. */
+            virtual Real hintedValue(Real x, Size&) const {
+                return value(x);
+            }
+            /*! Checks whether the abscissae are evenly spaced, so
+                that the lookups can compute intervals directly, and
+                returns whether they can.  The default implementation
+                does nothing and returns false. */
+            virtual bool checkUniformity() { return false; }
             virtual Real primitive(Real) const = 0;
             virtual Real derivative(Real) const = 0;
             virtual Real secondDerivative(Real) const = 0;
@@ -79,7 +92,8 @@ namespace QuantLib {
           public:
             templateImpl(const I1& xBegin, const I1& xEnd, const I2& yBegin,
                          const int requiredPoints = 2)
-            : xBegin_(xBegin), xEnd_(xEnd), yBegin_(yBegin) {
+            : xBegin_(xBegin), xEnd_(xEnd), yBegin_(yBegin),
+              inverseSpacing_(0.0) {
                 QL_REQUIRE(static_cast<int>(xEnd_-xBegin_) >= requiredPoints,
                            "not enough points to interpolate: at least " <<
                            requiredPoints <<
@@ -110,11 +124,67 @@ namespace QuantLib {
                     return 0;
                 else if (x > *(xEnd_-1))
                     return xEnd_-xBegin_-2;
-                else
-                    return std::upper_bound(xBegin_,xEnd_-1,x)-xBegin_-1;
+                if (inverseSpacing_ != 0.0 && x >= *xBegin_) {
+                    // evenly spaced abscissae: the interval can be
+                    // computed directly, up to rounding errors
+                    Size n = xEnd_-xBegin_-2;
+                    Size i = std::min<Size>(
+                        static_cast<Size>((x - *xBegin_)*inverseSpacing_), n);
+                    if (brackets(i, x))
+                        return i;
+                    else if (i > 0 && brackets(i-1, x))
+                        return i-1;
+                    else if (i < n && brackets(i+1, x))
+                        return i+1;
+                }
+                return std::upper_bound(xBegin_,xEnd_-1,x)-xBegin_-1;
+            }
+            /*! Same as locate(x), but the given interval and the one
+                following it are checked first; this makes sequences of
+                increasing points cheap to locate.  The hint is set to
+                the returned value. */
+            Size locate(Real x, Size& hint) const {
+                Size n = xEnd_-xBegin_-1;
+                if (hint < n && x >= *xBegin_ && x <= *(xEnd_-1)) {
+                    if (brackets(hint, x))
+                        return hint;
+                    else if (hint+1 < n && brackets(hint+1, x))
+                        return ++hint;
+                }
+                return hint = locate(x);
             }
+          public:
+            /*! If the abscissae are evenly spaced, locate() computes
+                the interval directly instead of performing a binary
+                search.  If the abscissae change afterwards, the
+                result of locate() is still correct but might require
+                a binary search.
+            */
+            bool checkUniformity() override {
+                inverseSpacing_ = 0.0;
+                Size n = xEnd_-xBegin_;
+                if (n < 3)
+                    return false;
+                Real h = (*(xEnd_-1) - *xBegin_)/(n-1);
+                if (!(h > 0.0))
+                    return false;
+                for (Size i=1; i<n; ++i) {
+                    if (std::fabs(xBegin_[i]-xBegin_[i-1]-h) > 1.0e-10*h)
+                        return false;
+                }
+                inverseSpacing_ = 1.0/h;
+                return true;
+            }
+          protected:
             I1 xBegin_, xEnd_;
             I2 yBegin_;
+          private:
+            // whether x lies in the i-th interval as defined by locate()
+            bool brackets(Size i, Real x) const {
+                return xBegin_[i] <= x &&
+                    (i+2 == Size(xEnd_-xBegin_) || x < xBegin_[i+1]);
+            }
+            Real inverseSpacing_;
         };
 
         Interpolation() = default;
@@ -124,6 +194,41 @@ namespace QuantLib {
             checkRange(x,allowExtrapolation);
             return impl_->value(x);
         }
+        /*! Interpolated value at x; the search for the position of x
+            starts from the given hint, which is updated so that it can
+            be passed to the next call.  This is faster when looking up
+            a sequence of nearby or increasing points.  The hint should
+            be initialized to 0 before the first call.
+        */
+        Real operator()(Real x, Size& hint,
+                        bool allowExtrapolation = false) const {
+            checkRange(x,allowExtrapolation);
+            return impl_->hintedValue(x, hint);
+        }
+        /*! Interpolated values at the n points starting at x, which
+            are written to the n locations starting at y.  The points
+            needn't be sorted, but the lookup is faster if they are.
+        */
+        void operator()(const Real* x, Real* y, Size n,
+                        bool allowExtrapolation = false) const {
+            for (Size i=0; i<n; ++i)
+                checkRange(x[i],allowExtrapolation);
+            Size hint = 0;
+            for (Size i=0; i<n; ++i)
+                y[i] = impl_->hintedValue(x[i], hint);
+        }
+        /*! Checks whether the abscissae are evenly spaced; if so,
+            later lookups compute the position of a point directly
+            instead of searching for it.  The check costs a pass over
+            the abscissae, and is worth it for large grids that are
+            interpolated at many points.  If the abscissae change,
+            lookups stay correct but may go back to searching until
+            the check is repeated.  Returns whether the lookups
+            were enabled to compute the positions directly.
+        */
+        bool checkUniformity() {
+            return impl_->checkUniformity();
+        }
         Real primitive(Real x, bool allowExtrapolation = false) const {
             checkRange(x,allowExtrapolation);
             return impl_->primitive(x);
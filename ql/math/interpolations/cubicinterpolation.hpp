@@ -760,6 +760,11 @@ namespace QuantLib {
                 Real dx_ = x-this->xBegin_[j];
                 return this->yBegin_[j] + dx_*(a_[j] + dx_*(b_[j] + dx_*c_[j]));
             }
+            Real hintedValue(Real x, Size& hint) const override {
+                Size j = this->locate(x, hint);
+                Real dx_ = x-this->xBegin_[j];
+                return this->yBegin_[j] + dx_*(a_[j] + dx_*(b_[j] + dx_*c_[j]));
+            }
             Real primitive(Real x) const override {
                 Size j = this->locate(x);
                 Real dx_ = x-this->xBegin_[j];
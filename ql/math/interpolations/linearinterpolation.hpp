@@ -89,6 +89,10 @@ namespace QuantLib {
                 Size i = this->locate(x);
                 return this->yBegin_[i] + (x-this->xBegin_[i])*s_[i];
             }
+            Real hintedValue(Real x, Size& hint) const override {
+                Size i = this->locate(x, hint);
+                return this->yBegin_[i] + (x-this->xBegin_[i])*s_[i];
+            }
             Real primitive(Real x) const override {
                 Size i = this->locate(x);
                 Real dx = x-this->xBegin_[i];
@@ -169,6 +169,12 @@ namespace QuantLib {
                 add(*begin, *wbegin);
         }
 
+        //! adds the data of another set, e.g., collected by another thread
+        /*! If both sets are sorted, the result is sorted as well,
+            so that percentiles require no further sorting.
+        */
+        void merge(const GeneralStatistics& other);
+
         //! resets the data to a null set
         void reset();
 
@@ -226,6 +232,18 @@ namespace QuantLib {
         sorted_ = false;
     }
 
+    inline void GeneralStatistics::merge(const GeneralStatistics& other) {
+        QL_REQUIRE(&other != this, "cannot merge a data set with itself");
+        Size n = samples_.size();
+        samples_.insert(samples_.end(),
+                        other.samples_.begin(), other.samples_.end());
+        if (sorted_ && other.sorted_)
+            std::inplace_merge(samples_.begin(), samples_.begin()+n,
+                               samples_.end());
+        else
+            sorted_ = false;
+    }
+
     inline void GeneralStatistics::reset() {
         samples_ = std::vector<std::pair<Real,Real> >();
         sorted_ = true;
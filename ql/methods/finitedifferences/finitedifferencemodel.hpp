@@ -27,7 +27,10 @@
 #include <ql/methods/finitedifferences/boundarycondition.hpp>
 #include <ql/methods/finitedifferences/operatortraits.hpp>
 #include <ql/methods/finitedifferences/stepcondition.hpp>
+#include <algorithm>
+#include <cmath>
 #include <utility>
+#include <vector>
 
 namespace QuantLib {
 
@@ -82,12 +85,141 @@ namespace QuantLib {
                       const condition_type& condition) {
             rollbackImpl(a,from,to,steps,&condition);
         }
+        /*! solves the problem between the given times for several
+            arrays at once, applying the corresponding condition (if
+            not null) to each of them at every step.  At each time
+            step the evolver is applied to all the arrays in turn,
+            so that the operator is set up for the step only once.
+            \warning being this a rollback, <tt>from</tt> must be a later
+                     time than <tt>to</tt>.
+        */
+        void rollback(std::vector<array_type>& a,
+                      Time from,
+                      Time to,
+                      Size steps,
+                      const std::vector<const condition_type*>& conditions) {
+            QL_REQUIRE(a.size() == conditions.size(),
+                       "number of arrays (" << a.size()
+                       << ") and conditions (" << conditions.size()
+                       << ") differ");
+            rollbackImpl(a,from,to,steps,conditions);
+        }
+        /*! solves the problem between the given times, choosing the
+            step sizes by step doubling: each step is compared with two
+            steps of half the size, and it is accepted if their
+            difference, relative to the maximum norm of the solution,
+            is below the given tolerance.  The next step size is then
+            scaled according to the local error of a method of the
+            given order.  Stopping times are always hit, and the
+            condition is applied after each step.
+
+            The rollback starts at \c t with the given step size and
+            stops at \c to or after \c maxSteps accepted steps; \c t
+            and \c step are then set to the time reached and to the
+            size proposed for the next step, so that the rollback can
+            be continued, e.g., with another scheme.  Returns the
+            number of accepted steps.
+            \warning being this a rollback, <tt>t</tt> must be a later
+                     time than <tt>to</tt>.
+        */
+        Size adaptiveRollback(array_type& a,
+                              Time& t,
+                              Time to,
+                              Real tolerance,
+                              Time& step,
+                              Size order,
+                              const condition_type& condition,
+                              Size maxSteps = QL_MAX_INTEGER) {
+
+            const Time from = t;
+            QL_REQUIRE(from >= to,
+                       "trying to roll back from " << from << " to " << to);
+            QL_REQUIRE(tolerance > 0.0, "positive tolerance required");
+            QL_REQUIRE(step > 0.0, "positive initial step required");
+            QL_REQUIRE(order > 0, "positive order required");
+
+            const Time minStep = std::max(from-to, 1.0)*1e-8;
+            const Real exponent = 1.0/(order+1.0);
+
+            if(!stoppingTimes_.empty() && stoppingTimes_.back() == from)
+                condition.applyTo(a,from);
+
+            Size accepted = 0;
+            while (t > to && accepted < maxSteps) {
+                // don't step over the next stopping time
+                Time next = std::max(t-step, to);
+                for (Integer j = static_cast<Integer>(stoppingTimes_.size())-1;
+                     j >= 0; --j) {
+                    if (next < stoppingTimes_[j] && stoppingTimes_[j] < t) {
+                        next = stoppingTimes_[j];
+                        break;
+                    }
+                }
+                if (std::fabs(to-next) < std::sqrt(QL_EPSILON)) next = to;
+                const Time h = t-next;
+
+                array_type full(a);
+                evolver_.setStep(h);
+                evolver_.step(full,t);
+                condition.applyTo(full,next);
+
+                array_type half(a);
+                evolver_.setStep(0.5*h);
+                evolver_.step(half,t);
+                condition.applyTo(half,t-0.5*h);
+                evolver_.step(half,t-0.5*h);
+                condition.applyTo(half,next);
+
+                Real error = 0.0, norm = 0.0;
+                for (Size i=0; i<half.size(); ++i) {
+                    error = std::max(error, std::fabs(half[i]-full[i]));
+                    norm = std::max(norm, std::fabs(half[i]));
+                }
+                error /= std::max(norm, QL_EPSILON);
+
+                const Real factor = (error > 0.0)
+                    ? 0.9*std::pow(tolerance/error, exponent)
+                    : 2.0;
+
+                if (error <= tolerance || h <= minStep) {
+                    a.swap(half);
+                    t = next;
+                    ++accepted;
+                    step = h*std::min(2.0, std::max(0.2, factor));
+                } else {
+                    step = std::max(minStep, h*std::max(0.2, factor));
+                }
+            }
+            return accepted;
+        }
       private:
-        void rollbackImpl(array_type& a,
+        void step(array_type& a, Time t) {
+            evolver_.step(a,t);
+        }
+        void step(std::vector<array_type>& a, Time t) {
+            for (Size i=0; i<a.size(); ++i)
+                evolver_.step(a[i],t);
+        }
+        static void applyCondition(array_type& a,
+                                   const condition_type* condition,
+                                   Time t) {
+            if (condition)
+                condition->applyTo(a,t);
+        }
+        static void applyCondition(
+                          std::vector<array_type>& a,
+                          const std::vector<const condition_type*>& conditions,
+                          Time t) {
+            for (Size i=0; i<a.size(); ++i)
+                applyCondition(a[i],conditions[i],t);
+        }
+
+        template <class Arrays, class Conditions>
+        void rollbackImpl(Arrays& a,
                           Time from,
                           Time to,
                           Size steps,
-                          const condition_type* condition) {
+                          const Conditions& condition) {
 
             QL_REQUIRE(from >= to,
                        "trying to roll back from " << from << " to " << to);
@@ -96,8 +228,7 @@ namespace QuantLib {
             evolver_.setStep(dt);
 
             if(!stoppingTimes_.empty() && stoppingTimes_.back() == from) {
-                if (condition)
-                    condition->applyTo(a,from);
+                applyCondition(a,condition,from);
             }
             for (Size i=0; i<steps; ++i, t -= dt) {
                 Time now = t;
@@ -114,9 +245,8 @@ namespace QuantLib {
 
                         // perform a small step to stoppingTimes_[j]...
                         evolver_.setStep(now-stoppingTimes_[j]);
-                        evolver_.step(a,now);
-                        if (condition)
-                            condition->applyTo(a,stoppingTimes_[j]);
+                        step(a,now);
+                        applyCondition(a,condition,stoppingTimes_[j]);
                         // ...and continue the cycle
                         now = stoppingTimes_[j];
                     }
@@ -127,9 +257,8 @@ namespace QuantLib {
                     // complete the big one...
                     if (now > next) {
                         evolver_.setStep(now - next);
-                        evolver_.step(a,now);
-                        if (condition)
-                            condition->applyTo(a,next);
+                        step(a,now);
+                        applyCondition(a,condition,next);
                     }
                     // ...and in any case, we have to reset the
                     // evolver to the default step.
@@ -137,9 +266,8 @@ namespace QuantLib {
                 } else {
                     // if we didn't, the evolver is already set to the
                     // default step, which is ok for us.
-                    evolver_.step(a,now);
-                    if (condition)
-                        condition->applyTo(a, next);
+                    step(a,now);
+                    applyCondition(a,condition,next);
                 }
             }
         }
@@ -186,6 +186,7 @@ namespace QuantLib {
         }
 
         LinearInterpolation odeSolution(x.begin(), x.end(), y.begin());
+        odeSolution.checkUniformity();
 
         // ensure required points are part of the grid
         std::vector<std::pair<Real, Real> > w(1, std::make_pair(0.0, 0.0));
@@ -214,8 +215,11 @@ namespace QuantLib {
         }
         LinearInterpolation transform(u.begin(), u.end(), z.begin());
 
+        // both lookups move forward along the grids
+        Size transformHint = 0, odeHint = 0;
         for (Size i=0; i < size; ++i) {
-            locations_[i] = odeSolution(transform(i*dx));
+            locations_[i] = odeSolution(transform(i*dx, transformHint),
+                                        odeHint);
         }
 
         for (Size i=0; i < size-1; ++i) {
@@ -25,6 +25,8 @@
 #include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
+#include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
 #include <utility>
 
 namespace QuantLib {
@@ -46,9 +48,21 @@ namespace QuantLib {
       dxMap_(FirstDerivativeOp(direction, mesher)), dxxMap_(SecondDerivativeOp(direction, mesher)),
       mapT_(direction, mesher), strike_(strike),
       illegalLocalVolOverwrite_(illegalLocalVolOverwrite), direction_(direction),
-      quantoHelper_(std::move(quantoHelper)) {}
+      quantoHelper_(std::move(quantoHelper)),
+      constantCoefficients_(
+          !localVol && !quantoHelper_
+          && ext::dynamic_pointer_cast<FlatForward>(rTS_) != nullptr
+          && ext::dynamic_pointer_cast<FlatForward>(qTS_) != nullptr
+          && ext::dynamic_pointer_cast<BlackConstantVol>(volTS_) != nullptr),
+      r_(Null<Real>()), q_(Null<Real>()), v_(Null<Real>()) {}
 
     void FdmBlackScholesOp::setTime(Time t1, Time t2) {
+        if (constantCoefficients_) {
+            // fixed interval, see TripleBandFactorisation
+            t1 = 0.0;
+            t2 = 1.0;
+        }
+
         const Rate r = rTS_->forwardRate(t1, t2, Continuous).rate();
         const Rate q = qTS_->forwardRate(t1, t2, Continuous).rate();
 
@@ -88,6 +102,12 @@ namespace QuantLib {
             const Real v
                 = volTS_->blackForwardVariance(t1, t2, strike_)/(t2-t1);
 
+            if (constantCoefficients_ && r == r_ && q == q_ && v == v_)
+                return;
+            r_ = r;
+            q_ = q;
+            v_ = v;
+
             if (quantoHelper_ != nullptr) {
                 mapT_.axpyb(
                     Array(1, r - q - 0.5*v)
@@ -102,6 +122,7 @@ namespace QuantLib {
                     Array(1, -r));
             }
         }
+        factorisation_.reset();
     }
 
     Size FdmBlackScholesOp::size() const { return 1U; }
@@ -128,7 +149,7 @@ namespace QuantLib {
     Disposable<Array> FdmBlackScholesOp::solve_splitting(Size direction,
                                                 const Array& r, Real dt) const {
         if (direction == direction_)
-            return mapT_.solve_splitting(r, dt, 1.0);
+            return mapT_.solve_splitting(r, dt, 1.0, factorisation_);
         else {
             Array retVal(r);
             return retVal;
@@ -35,6 +35,12 @@
 
 namespace QuantLib {
 
+    /*! With flat rate and dividend curves, a constant volatility and
+        no quanto adjustment the coefficients don't depend on time.
+        The operator is then only rebuilt by setTime() when the
+        market data change, and the factorisation of the implicit
+        systems is kept across time steps.
+    */
     class FdmBlackScholesOp : public FdmLinearOpComposite {
       public:
         FdmBlackScholesOp(
@@ -71,6 +77,9 @@ namespace QuantLib {
         const Real illegalLocalVolOverwrite_;
         const Size direction_;
         const ext::shared_ptr<FdmQuantoHelper> quantoHelper_;
+        const bool constantCoefficients_;
+        Real r_, q_, v_;
+        mutable TripleBandFactorisation factorisation_;
     };
 }
 
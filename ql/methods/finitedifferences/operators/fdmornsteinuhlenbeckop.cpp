@@ -26,7 +26,7 @@
 #include <ql/methods/finitedifferences/operators/fdmornsteinuhlenbeckop.hpp>
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
 #include <ql/processes/ornsteinuhlenbeckprocess.hpp>
-#include <ql/termstructures/yieldtermstructure.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
 #include <utility>
 
 namespace QuantLib {
@@ -37,7 +37,9 @@ namespace QuantLib {
         ext::shared_ptr<YieldTermStructure> rTS,
         Size direction)
     : mesher_(mesher), process_(std::move(process)), rTS_(std::move(rTS)), direction_(direction),
-      m_(direction, mesher), mapX_(direction, mesher) {
+      m_(direction, mesher), mapX_(direction, mesher),
+      flatRate_(ext::dynamic_pointer_cast<FlatForward>(rTS_) != nullptr),
+      r_(Null<Real>()) {
 
         const ext::shared_ptr<FdmLinearOpLayout> layout=mesher_->layout();
 
@@ -61,9 +63,19 @@ namespace QuantLib {
     }
 
     void FdmOrnsteinUhlenbeckOp::setTime(Time t1, Time t2) {
+        if (flatRate_) {
+            // fixed interval, see TripleBandFactorisation
+            t1 = 0.0;
+            t2 = 1.0;
+        }
         const Rate r = rTS_->forwardRate(t1, t2, Continuous).rate();
 
+        if (flatRate_ && r == r_)
+            return;
+        r_ = r;
+
         mapX_.axpyb(Array(), m_, m_, Array(1, -r));
+        factorisation_.reset();
     }
 
     Disposable<Array> FdmOrnsteinUhlenbeckOp::apply(const Array& r) const {
@@ -93,7 +105,7 @@ namespace QuantLib {
         Size direction, const Array& r, Real a) const {
 
         if (direction == direction_) {
-            return mapX_.solve_splitting(r, a, 1.0);
+            return mapX_.solve_splitting(r, a, 1.0, factorisation_);
         }
         else {
             Array retVal(r);
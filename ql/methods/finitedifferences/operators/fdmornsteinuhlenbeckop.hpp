@@ -36,6 +36,10 @@ namespace QuantLib {
     class YieldTermStructure;
     class OrnsteinUhlenbeckProcess;
 
+    /*! With a flat rate curve the operator is only rebuilt by
+        setTime() when the rate changes, and the factorisation of
+        the implicit systems is kept across time steps.
+    */
     class FdmOrnsteinUhlenbeckOp : public FdmLinearOpComposite {
       public:
         FdmOrnsteinUhlenbeckOp(const ext::shared_ptr<FdmMesher>& mesher,
@@ -63,6 +67,9 @@ namespace QuantLib {
         const Size direction_;
 
         TripleBandLinearOp m_, mapX_;
+        const bool flatRate_;
+        Real r_;
+        mutable TripleBandFactorisation factorisation_;
     };
 
 }
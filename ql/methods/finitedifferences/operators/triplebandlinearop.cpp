@@ -279,8 +279,15 @@ namespace QuantLib {
 
     Disposable<Array>
     TripleBandLinearOp::solve_splitting(const Array& r, Real a, Real b) const {
+        TripleBandFactorisation f;
+        return solve_splitting(r, a, b, f);
+    }
+
+    Disposable<Array> TripleBandLinearOp::solve_splitting(
+        const Array& r, Real a, Real b, TripleBandFactorisation& f) const {
         const ext::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
-        QL_REQUIRE(r.size() == layout->size(), "inconsistent size of rhs");
+        const Size n = layout->size();
+        QL_REQUIRE(r.size() == n, "inconsistent size of rhs");
 
 #ifdef QL_EXTRA_SAFETY_CHECKS
         for (FdmLinearOpIterator iter = layout->begin();
@@ -293,35 +300,48 @@ namespace QuantLib {
         }
 #endif
 
-        Array retVal(r.size()), tmp(r.size());
-
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
         const Real* uptr = upper_.get();
 
-        // Thomson algorithm to solve a tridiagonal system.
-        // Example code taken from Tridiagonalopertor and
-        // changed to fit for the triple band operator.
-        Size rim1 = reverseIndex_[0];
-        Real bet=1.0/(a*dptr[rim1]+b);
-        QL_REQUIRE(bet != 0.0, "division by zero");
-        retVal[reverseIndex_[0]] = r[rim1]*bet;
+        if (f.a_ != a || f.b_ != b || f.bet_.size() != n) {
+            f.reset();
+            f.bet_.resize(n);
+            f.tmp_.resize(n);
+
+            // Thomson algorithm to solve a tridiagonal system.
+            // Example code taken from Tridiagonalopertor and
+            // changed to fit for the triple band operator.
+            Size rim1 = reverseIndex_[0];
+            Real bet=1.0/(a*dptr[rim1]+b);
+            QL_REQUIRE(bet != 0.0, "division by zero");
+            f.bet_[0] = bet;
+
+            for (Size j=1; j<=n-1; j++){
+                const Size ri = reverseIndex_[j];
+                f.tmp_[j] = a*uptr[rim1]*bet;
+
+                bet=b+a*(dptr[ri]-f.tmp_[j]*lptr[ri]);
+                QL_ENSURE(bet != 0.0, "division by zero");
+                bet=1.0/bet;
+                f.bet_[j] = bet;
+                rim1 = ri;
+            }
+            f.a_ = a;
+            f.b_ = b;
+        }
 
-        for (Size j=1; j<=layout->size()-1; j++){
+        Array retVal(n);
+        Size rim1 = reverseIndex_[0];
+        retVal[rim1] = r[rim1]*f.bet_[0];
+        for (Size j=1; j<=n-1; j++){
             const Size ri = reverseIndex_[j];
-            tmp[j] = a*uptr[rim1]*bet;
-
-            bet=b+a*(dptr[ri]-tmp[j]*lptr[ri]);
-            QL_ENSURE(bet != 0.0, "division by zero");
-            bet=1.0/bet;
-
-            retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*bet;
+            retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*f.bet_[j];
             rim1 = ri;
         }
-        // cannot be j>=0 with Size j
-        for (Size j=layout->size()-2; j>0; --j)
-            retVal[reverseIndex_[j]] -= tmp[j+1]*retVal[reverseIndex_[j+1]];
-        retVal[reverseIndex_[0]] -= tmp[1]*retVal[reverseIndex_[1]];
+        for (Size j=n-2; j>0; --j)
+            retVal[reverseIndex_[j]] -= f.tmp_[j+1]*retVal[reverseIndex_[j+1]];
+        retVal[reverseIndex_[0]] -= f.tmp_[1]*retVal[reverseIndex_[1]];
 
         return retVal;
     }
@@ -28,12 +28,34 @@
 #define quantlib_triple_band_linear_op_hpp
 
 #include <ql/methods/finitedifferences/operators/fdmlinearop.hpp>
+#include <ql/utilities/null.hpp>
 #include <boost/shared_array.hpp>
 
 namespace QuantLib {
 
     class FdmMesher;
-    
+
+    //! stored factorisation of a triple band system
+    /*! Holds the pivots of the Thomas algorithm for the system
+        \f$ (a L + b) x = r \f$, so that further systems with the same
+        operator \f$ L \f$ and coefficients can skip the elimination.
+        The owner of the operator must call reset() whenever the
+        operator changes.  Operators with constant coefficients should
+        evaluate them on a fixed time interval in setTime(), since
+        round-off in e.g. forward rates over different intervals would
+        otherwise change the operator, and reset the factorisation,
+        at every step.
+    */
+    class TripleBandFactorisation {
+      public:
+        TripleBandFactorisation() : a_(Null<Real>()), b_(Null<Real>()) {}
+        void reset() { a_ = b_ = Null<Real>(); }
+      private:
+        friend class TripleBandLinearOp;
+        Real a_, b_;
+        Array bet_, tmp_;
+    };
+
     class TripleBandLinearOp : public FdmLinearOp {
       public:
         TripleBandLinearOp(Size direction,
@@ -53,6 +75,12 @@ namespace QuantLib {
         Disposable<Array> apply(const Array& r) const override;
         Disposable<Array> solve_splitting(const Array& r, Real a,
                                           Real b = 1.0) const;
+        /*! same as above, but the factorisation of the system is
+            taken from the given one if it was stored for the same
+            a and b, and stored into it otherwise.
+        */
+        Disposable<Array> solve_splitting(const Array& r, Real a, Real b,
+                                          TripleBandFactorisation& f) const;
 
         Disposable<TripleBandLinearOp> mult(const Array& u) const;
         // interpret u as the diagonal of a diagonal matrix, multiplied on LHS
@@ -35,6 +35,8 @@
 #include <ql/methods/finitedifferences/schemes/trbdf2scheme.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
+#include <ql/utilities/null.hpp>
+#include <list>
 #include <utility>
 
 
@@ -89,112 +91,301 @@ namespace QuantLib {
                          std::list<std::vector<Time> >(), FdmStepConditionComposite::Conditions())),
       schemeDesc_(schemeDesc) {}
 
-    void FdmBackwardSolver::rollback(FdmBackwardSolver::array_type& rhs, 
-                                     Time from, Time to,
-                                     Size steps, Size dampingSteps) {
+    namespace {
 
-        const Time deltaT = from - to;
-        const Size allSteps = steps + dampingSteps;
-        const Time dampingTo = from - (deltaT*dampingSteps)/allSteps;
+        typedef FdmBackwardSolver::array_type array_type;
+        typedef StepCondition<array_type> condition_type;
 
-        if ((dampingSteps != 0U) && schemeDesc_.type != FdmSchemeDesc::ImplicitEulerType) {
-            ImplicitEulerScheme implicitEvolver(map_, bcSet_);    
-            FiniteDifferenceModel<ImplicitEulerScheme> 
-                    dampingModel(implicitEvolver, condition_->stoppingTimes());
-            dampingModel.rollback(rhs, from, dampingTo, 
-                                  dampingSteps, *condition_);
-        }
+        /* Forwards to the given operator, skipping the set-up when
+           setTime is called again with the same times.  This is the
+           case when several arrays are stepped in turn. */
+        class FdmSharedTimeOp : public FdmLinearOpComposite {
+          public:
+            explicit FdmSharedTimeOp(ext::shared_ptr<FdmLinearOpComposite> op)
+            : op_(std::move(op)), t1_(Null<Time>()), t2_(Null<Time>()) {}
 
-        switch (schemeDesc_.type) {
-          case FdmSchemeDesc::HundsdorferType:
-            {
-                HundsdorferScheme hsEvolver(schemeDesc_.theta, schemeDesc_.mu, 
-                                            map_, bcSet_);
-                FiniteDifferenceModel<HundsdorferScheme> 
-                               hsModel(hsEvolver, condition_->stoppingTimes());
-                hsModel.rollback(rhs, dampingTo, to, steps, *condition_);
+            Size size() const override { return op_->size(); }
+            void setTime(Time t1, Time t2) override {
+                if (t1 != t1_ || t2 != t2_) {
+                    op_->setTime(t1, t2);
+                    t1_ = t1;
+                    t2_ = t2;
+                }
+            }
+            Disposable<Array> apply(const Array& r) const override {
+                return op_->apply(r);
+            }
+            Disposable<Array> apply_mixed(const Array& r) const override {
+                return op_->apply_mixed(r);
+            }
+            Disposable<Array> apply_direction(Size direction,
+                                              const Array& r) const override {
+                return op_->apply_direction(direction, r);
+            }
+            Disposable<Array> solve_splitting(Size direction,
+                                              const Array& r,
+                                              Real s) const override {
+                return op_->solve_splitting(direction, r, s);
+            }
+            Disposable<Array> preconditioner(const Array& r,
+                                             Real s) const override {
+                return op_->preconditioner(r, s);
+            }
+#if !defined(QL_NO_UBLAS_SUPPORT)
+            Disposable<std::vector<SparseMatrix> >
+            toMatrixDecomp() const override {
+                return op_->toMatrixDecomp();
             }
-            break;
-          case FdmSchemeDesc::DouglasType:
-            {
-                DouglasScheme dsEvolver(schemeDesc_.theta, map_, bcSet_);
-                FiniteDifferenceModel<DouglasScheme> 
-                               dsModel(dsEvolver, condition_->stoppingTimes());
-                dsModel.rollback(rhs, dampingTo, to, steps, *condition_);
+            Disposable<SparseMatrix> toMatrix() const override {
+                return op_->toMatrix();
             }
-            break;
-          case FdmSchemeDesc::CrankNicolsonType:
-            {
-              CrankNicolsonScheme cnEvolver(schemeDesc_.theta, map_, bcSet_);
-              FiniteDifferenceModel<CrankNicolsonScheme>
-                             cnModel(cnEvolver, condition_->stoppingTimes());
-              cnModel.rollback(rhs, dampingTo, to, steps, *condition_);
+#endif
+          private:
+            const ext::shared_ptr<FdmLinearOpComposite> op_;
+            Time t1_, t2_;
+        };
 
+        // rolls back with the given number of uniform steps
+        struct UniformSteps {
+            // the damping steps take the same share of the interval
+            // as they would in a uniform grid with the other steps
+            template <class Model, class Arrays, class Conditions>
+            Time damp(Model& model, Arrays& rhs,
+                      Time from, Time to, Size steps, Size dampingSteps,
+                      const Conditions& condition) const {
+                const Time dampingTo =
+                    from - ((from-to)*dampingSteps)/(steps+dampingSteps);
+                model.rollback(rhs, from, dampingTo, dampingSteps, condition);
+                return dampingTo;
             }
-            break;
-          case FdmSchemeDesc::CraigSneydType:
-            {
-                CraigSneydScheme csEvolver(schemeDesc_.theta, schemeDesc_.mu, 
-                                           map_, bcSet_);
-                FiniteDifferenceModel<CraigSneydScheme> 
-                               csModel(csEvolver, condition_->stoppingTimes());
-                csModel.rollback(rhs, dampingTo, to, steps, *condition_);
+            template <class Model, class Arrays, class Conditions>
+            void operator()(Model& model, Arrays& rhs,
+                            Time from, Time to, Size steps, Size,
+                            const Conditions& condition) const {
+                model.rollback(rhs, from, to, steps, condition);
             }
-            break;
-          case FdmSchemeDesc::ModifiedCraigSneydType:
-            {
-                ModifiedCraigSneydScheme csEvolver(schemeDesc_.theta, 
-                                                   schemeDesc_.mu,
-                                                   map_, bcSet_);
-                FiniteDifferenceModel<ModifiedCraigSneydScheme> 
-                              mcsModel(csEvolver, condition_->stoppingTimes());
-                mcsModel.rollback(rhs, dampingTo, to, steps, *condition_);
+        };
+
+        // rolls back with adaptive steps, starting from uniform ones
+        struct AdaptiveSteps {
+            explicit AdaptiveSteps(Real tolerance)
+            : tolerance(tolerance), step(Null<Time>()), accepted(0) {}
+            // the damping steps are the first accepted ones, so that
+            // the controller chooses their size as well
+            template <class Model>
+            Time damp(Model& model, array_type& rhs,
+                      Time from, Time to, Size steps, Size dampingSteps,
+                      const condition_type& condition) {
+                Time t = from;
+                step = (from-to)/steps;
+                accepted += model.adaptiveRollback(
+                    rhs, t, to, tolerance, step, 1, condition, dampingSteps);
+                return t;
             }
-            break;
-          case FdmSchemeDesc::ImplicitEulerType:
-            {
-                ImplicitEulerScheme implicitEvolver(map_, bcSet_);
-                FiniteDifferenceModel<ImplicitEulerScheme> 
-                   implicitModel(implicitEvolver, condition_->stoppingTimes());
-                implicitModel.rollback(rhs, from, to, allSteps, *condition_);
+            template <class Model>
+            void operator()(Model& model, array_type& rhs,
+                            Time from, Time to, Size steps, Size order,
+                            const condition_type& condition) {
+                if (step == Null<Time>())
+                    step = (from-to)/steps;
+                accepted += model.adaptiveRollback(
+                    rhs, from, to, tolerance, step, order, condition);
             }
-            break;
-          case FdmSchemeDesc::ExplicitEulerType:
-            {
-                ExplicitEulerScheme explicitEvolver(map_, bcSet_);
-                FiniteDifferenceModel<ExplicitEulerScheme> 
-                   explicitModel(explicitEvolver, condition_->stoppingTimes());
-                explicitModel.rollback(rhs, dampingTo, to, steps, *condition_);
+            Real tolerance;
+            Time step;
+            Size accepted;
+        };
+
+        template <class Arrays, class Conditions, class Roller>
+        void rollbackWithScheme(
+                        const FdmSchemeDesc& schemeDesc,
+                        const ext::shared_ptr<FdmLinearOpComposite>& map,
+                        const FdmBoundaryConditionSet& bcSet,
+                        const std::vector<Time>& stoppingTimes,
+                        const Conditions& condition,
+                        Arrays& rhs,
+                        Time from, Time to,
+                        Size steps, Size dampingSteps,
+                        Roller& roll) {
+
+            const Size allSteps = steps + dampingSteps;
+            Time dampingTo = from;
+
+            if ((dampingSteps != 0U) && schemeDesc.type != FdmSchemeDesc::ImplicitEulerType) {
+                ImplicitEulerScheme implicitEvolver(map, bcSet);    
+                FiniteDifferenceModel<ImplicitEulerScheme> 
+                        dampingModel(implicitEvolver, stoppingTimes);
+                dampingTo = roll.damp(dampingModel, rhs, from, to,
+                                      steps, dampingSteps, condition);
             }
-            break;
-          case FdmSchemeDesc::MethodOfLinesType:
-            {
-                MethodOfLinesScheme methodOfLines(
-                    schemeDesc_.theta, schemeDesc_.mu, map_, bcSet_);
-                FiniteDifferenceModel<MethodOfLinesScheme>
-                   molModel(methodOfLines, condition_->stoppingTimes());
-                molModel.rollback(rhs, dampingTo, to, steps, *condition_);
+
+            // order of the scheme, as used for the error control
+            const bool firstOrder =
+                schemeDesc.type == FdmSchemeDesc::ImplicitEulerType
+                || schemeDesc.type == FdmSchemeDesc::ExplicitEulerType
+                || ((schemeDesc.type == FdmSchemeDesc::DouglasType
+                     || schemeDesc.type == FdmSchemeDesc::CrankNicolsonType)
+                    && schemeDesc.theta != 0.5);
+            const Size order = firstOrder ? 1 : 2;
+
+            switch (schemeDesc.type) {
+              case FdmSchemeDesc::HundsdorferType:
+                {
+                    HundsdorferScheme hsEvolver(schemeDesc.theta, schemeDesc.mu, 
+                                                map, bcSet);
+                    FiniteDifferenceModel<HundsdorferScheme> 
+                                   hsModel(hsEvolver, stoppingTimes);
+                    roll(hsModel, rhs, dampingTo, to, steps, order, condition);
+                }
+                break;
+              case FdmSchemeDesc::DouglasType:
+                {
+                    DouglasScheme dsEvolver(schemeDesc.theta, map, bcSet);
+                    FiniteDifferenceModel<DouglasScheme> 
+                                   dsModel(dsEvolver, stoppingTimes);
+                    roll(dsModel, rhs, dampingTo, to, steps, order, condition);
+                }
+                break;
+              case FdmSchemeDesc::CrankNicolsonType:
+                {
+                  CrankNicolsonScheme cnEvolver(schemeDesc.theta, map, bcSet);
+                  FiniteDifferenceModel<CrankNicolsonScheme>
+                                 cnModel(cnEvolver, stoppingTimes);
+                  roll(cnModel, rhs, dampingTo, to, steps, order, condition);
+
+                }
+                break;
+              case FdmSchemeDesc::CraigSneydType:
+                {
+                    CraigSneydScheme csEvolver(schemeDesc.theta, schemeDesc.mu, 
+                                               map, bcSet);
+                    FiniteDifferenceModel<CraigSneydScheme> 
+                                   csModel(csEvolver, stoppingTimes);
+                    roll(csModel, rhs, dampingTo, to, steps, order, condition);
+                }
+                break;
+              case FdmSchemeDesc::ModifiedCraigSneydType:
+                {
+                    ModifiedCraigSneydScheme csEvolver(schemeDesc.theta, 
+                                                       schemeDesc.mu,
+                                                       map, bcSet);
+                    FiniteDifferenceModel<ModifiedCraigSneydScheme> 
+                                  mcsModel(csEvolver, stoppingTimes);
+                    roll(mcsModel, rhs, dampingTo, to, steps, order, condition);
+                }
+                break;
+              case FdmSchemeDesc::ImplicitEulerType:
+                {
+                    ImplicitEulerScheme implicitEvolver(map, bcSet);
+                    FiniteDifferenceModel<ImplicitEulerScheme> 
+                       implicitModel(implicitEvolver, stoppingTimes);
+                    roll(implicitModel, rhs, from, to, allSteps,
+                         order, condition);
+                }
+                break;
+              case FdmSchemeDesc::ExplicitEulerType:
+                {
+                    ExplicitEulerScheme explicitEvolver(map, bcSet);
+                    FiniteDifferenceModel<ExplicitEulerScheme> 
+                       explicitModel(explicitEvolver, stoppingTimes);
+                    roll(explicitModel, rhs, dampingTo, to, steps, order, condition);
+                }
+                break;
+              case FdmSchemeDesc::MethodOfLinesType:
+                {
+                    MethodOfLinesScheme methodOfLines(
+                        schemeDesc.theta, schemeDesc.mu, map, bcSet);
+                    FiniteDifferenceModel<MethodOfLinesScheme>
+                       molModel(methodOfLines, stoppingTimes);
+                    roll(molModel, rhs, dampingTo, to, steps, order, condition);
+                }
+                break;
+              case FdmSchemeDesc::TrBDF2Type:
+                {
+                    const FdmSchemeDesc trDesc
+                        = FdmSchemeDesc::CraigSneyd();
+
+                    const ext::shared_ptr<CraigSneydScheme> hsEvolver(
+                        ext::make_shared<CraigSneydScheme>(
+                            trDesc.theta, trDesc.mu, map, bcSet));
+
+                    TrBDF2Scheme<CraigSneydScheme> trBDF2(
+                        schemeDesc.theta, map, hsEvolver, bcSet,schemeDesc.mu);
+
+                    FiniteDifferenceModel<TrBDF2Scheme<CraigSneydScheme> >
+                       trBDF2Model(trBDF2, stoppingTimes);
+                    roll(trBDF2Model, rhs, dampingTo, to, steps, order, condition);
+                }
+                break;
+              default:
+                QL_FAIL("Unknown scheme type");
             }
-            break;
-          case FdmSchemeDesc::TrBDF2Type:
-            {
-                const FdmSchemeDesc trDesc
-                    = FdmSchemeDesc::CraigSneyd();
-
-                const ext::shared_ptr<CraigSneydScheme> hsEvolver(
-                    ext::make_shared<CraigSneydScheme>(
-                        trDesc.theta, trDesc.mu, map_, bcSet_));
-
-                TrBDF2Scheme<CraigSneydScheme> trBDF2(
-                    schemeDesc_.theta, map_, hsEvolver, bcSet_,schemeDesc_.mu);
-
-                FiniteDifferenceModel<TrBDF2Scheme<CraigSneydScheme> >
-                   trBDF2Model(trBDF2, condition_->stoppingTimes());
-                trBDF2Model.rollback(rhs, dampingTo, to, steps, *condition_);
+        }
+
+    }
+
+    void FdmBackwardSolver::rollback(FdmBackwardSolver::array_type& rhs, 
+                                     Time from, Time to,
+                                     Size steps, Size dampingSteps) {
+        UniformSteps roll;
+        rollbackWithScheme(schemeDesc_, map_, bcSet_,
+                           condition_->stoppingTimes(), *condition_,
+                           rhs, from, to, steps, dampingSteps, roll);
+    }
+
+    void FdmBackwardSolver::rollback(
+        std::vector<FdmBackwardSolver::array_type>& a,
+        const std::vector<ext::shared_ptr<FdmStepConditionComposite> >&
+                                                                conditions,
+        Time from, Time to,
+        Size steps, Size dampingSteps) {
+
+        QL_REQUIRE(a.size() == conditions.size(),
+                   "number of arrays (" << a.size()
+                   << ") and conditions (" << conditions.size()
+                   << ") differ");
+
+        // each array gets the condition of the solver joined with its own
+        std::list<std::vector<Time> > stoppingTimes(
+                                            1, condition_->stoppingTimes());
+        std::vector<ext::shared_ptr<FdmStepConditionComposite> > joined;
+        std::vector<const condition_type*> c(a.size(), condition_.get());
+        for (Size i=0; i < a.size(); ++i) {
+            if (conditions[i] != nullptr) {
+                std::list<std::vector<Time> > times;
+                times.push_back(condition_->stoppingTimes());
+                times.push_back(conditions[i]->stoppingTimes());
+                FdmStepConditionComposite::Conditions cs;
+                cs.push_back(condition_);
+                cs.push_back(conditions[i]);
+                joined.push_back(
+                    ext::make_shared<FdmStepConditionComposite>(times, cs));
+                c[i] = joined.back().get();
+                stoppingTimes.push_back(conditions[i]->stoppingTimes());
             }
-            break;
-          default:
-            QL_FAIL("Unknown scheme type");
         }
+        const FdmStepConditionComposite all(
+            stoppingTimes, FdmStepConditionComposite::Conditions());
+
+        UniformSteps roll;
+        rollbackWithScheme(schemeDesc_,
+                           ext::make_shared<FdmSharedTimeOp>(map_),
+                           bcSet_, all.stoppingTimes(), c,
+                           a, from, to, steps, dampingSteps, roll);
+    }
+
+    Size FdmBackwardSolver::adaptiveRollback(
+        FdmBackwardSolver::array_type& rhs,
+        Time from, Time to,
+        Real tolerance, Size initialSteps, Size dampingSteps) {
+
+        QL_REQUIRE(initialSteps > 0, "at least one initial step required");
+
+        AdaptiveSteps roll(tolerance);
+        rollbackWithScheme(schemeDesc_, map_, bcSet_,
+                           condition_->stoppingTimes(), *condition_,
+                           rhs, from, to, initialSteps, dampingSteps, roll);
+
+        return roll.accepted;
     }
 }
@@ -26,6 +26,7 @@
 #define quantlib_fdm_backward_solver_hpp
 
 #include <ql/methods/finitedifferences/utilities/fdmboundaryconditionset.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -71,6 +72,38 @@ namespace QuantLib {
                       Time from, Time to,
                       Size steps, Size dampingSteps);
 
+        /*! Rolls back several arrays sharing the mesher and the
+            operator, e.g., the payoffs of an option chain.  At each
+            time step the operator is set up once and applied to all
+            the arrays; conditions[i] (which can be null) is applied
+            to a[i] in addition to the condition of the solver.  All
+            the arrays are stepped through the stopping times of all
+            the conditions.
+        */
+        void rollback(std::vector<array_type>& a,
+                      const std::vector<ext::shared_ptr<
+                          FdmStepConditionComposite> >& conditions,
+                      Time from, Time to,
+                      Size steps, Size dampingSteps);
+
+        /*! Rolls back with step sizes chosen by an error controller
+            instead of a fixed grid.  Each step is compared with two
+            steps of half the size and accepted if their difference,
+            relative to the maximum norm of the solution, is below the
+            given tolerance; the next step is then scaled according to
+            the estimated local error.  The stopping times of the
+            condition are always hit.  The controller starts from the
+            step size given by initialSteps; the first dampingSteps
+            accepted steps use the implicit Euler scheme, so that the
+            length of the damping phase is chosen by the controller as
+            well.  Returns the number of accepted steps, damping steps
+            included.
+        */
+        Size adaptiveRollback(array_type& a,
+                              Time from, Time to,
+                              Real tolerance,
+                              Size initialSteps, Size dampingSteps);
+
       protected:
         const ext::shared_ptr<FdmLinearOpComposite> map_;
         const FdmBoundaryConditionSet bcSet_;
@@ -0,0 +1,79 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmrichardsonextrapolation.cpp
+*/
+
+#include <ql/errors.hpp>
+#include <ql/math/richardsonextrapolation.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmrichardsonextrapolation.hpp>
+#include <cmath>
+#include <utility>
+
+namespace QuantLib {
+
+    FdmRichardsonExtrapolation::FdmRichardsonExtrapolation(
+        Pricer pricer, Real order)
+    : pricer_(std::move(pricer)), order_(order), refinement_(0) {
+        QL_REQUIRE(order_ == Null<Real>() || order_ > 0.0,
+                   "positive order of convergence required");
+    }
+
+    Real FdmRichardsonExtrapolation::price(Size refinement) const {
+        auto i = prices_.find(refinement);
+        if (i != prices_.end())
+            return i->second;
+        const Real p = pricer_(refinement);
+        prices_[refinement] = p;
+        return p;
+    }
+
+    // extrapolation using the grids with factors up to refinement
+    Real FdmRichardsonExtrapolation::extrapolate(Size refinement) const {
+        const auto f = [this](Real h) -> Real {
+            return price(Size(std::lround(1.0/h)));
+        };
+
+        refinement_ = refinement;
+        if (order_ != Null<Real>())
+            return RichardsonExtrapolation(f, 2.0/refinement, order_)(2.0);
+        else
+            return RichardsonExtrapolation(f, 4.0/refinement)(4.0, 2.0);
+    }
+
+    Real FdmRichardsonExtrapolation::operator()(Real tolerance,
+                                                Size maxRefinements) const {
+        QL_REQUIRE(tolerance > 0.0, "positive tolerance required");
+
+        // the first extrapolation needs two or three grids
+        Size refinement = (order_ != Null<Real>()) ? 2 : 4;
+        Real previous = extrapolate(refinement), change = 0.0;
+        for (Size i=0; i < maxRefinements; ++i) {
+            refinement *= 2;
+            const Real current = extrapolate(refinement);
+            change = std::fabs(current - previous);
+            if (change < tolerance)
+                return current;
+            previous = current;
+        }
+
+        QL_FAIL("tolerance " << tolerance << " not reached after "
+                << maxRefinements << " refinements (last change: "
+                << change << ")");
+    }
+
+}
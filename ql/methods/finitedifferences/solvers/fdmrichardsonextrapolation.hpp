@@ -0,0 +1,73 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmrichardsonextrapolation.hpp
+    \brief Richardson extrapolation of finite-difference prices
+*/
+
+#ifndef quantlib_fdm_richardson_extrapolation_hpp
+#define quantlib_fdm_richardson_extrapolation_hpp
+
+#include <ql/types.hpp>
+#include <ql/functional.hpp>
+#include <ql/utilities/null.hpp>
+#include <map>
+
+namespace QuantLib {
+
+    //! Richardson extrapolation of finite-difference prices
+    /*! The pricer returns the price calculated with all the grid
+        sizes, time steps included, multiplied by the given factor.
+        The grids are refined by doubling the factor, starting from
+        one, and the prices on successive grids are extrapolated
+        with the RichardsonExtrapolation class until two successive
+        extrapolated values agree within the given tolerance.
+
+        If the order of convergence is not known, it is estimated
+        from three successive grids.  Prices already calculated are
+        cached, so that each grid is only priced once.
+    */
+    class FdmRichardsonExtrapolation {
+      public:
+        typedef ext::function<Real (Size)> Pricer;
+
+        /*! \param pricer returns the price for the given refinement
+            \param order if known, the order of convergence
+        */
+        explicit FdmRichardsonExtrapolation(Pricer pricer,
+                                            Real order = Null<Real>());
+
+        //! extrapolated price
+        Real operator()(Real tolerance, Size maxRefinements = 6) const;
+
+        //! finest refinement factor used by the last extrapolation
+        Size refinement() const { return refinement_; }
+        //! price for the given refinement (cached)
+        Real price(Size refinement) const;
+
+      private:
+        Real extrapolate(Size refinement) const;
+
+        const Pricer pricer_;
+        const Real order_;
+        mutable std::map<Size, Real> prices_;
+        mutable Size refinement_;
+    };
+
+}
+
+#endif
@@ -0,0 +1,111 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmsparsegridcombination.cpp
+*/
+
+#include <ql/errors.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmsparsegridcombination.hpp>
+#include <string>
+#include <utility>
+
+namespace QuantLib {
+
+    namespace {
+
+        // appends all the levels l with l_i >= 1 and |l|_1 == sum
+        void addLevels(std::vector<Size>& l, Size i, Size sum,
+                       std::vector<std::vector<Size> >& levels) {
+            if (i == l.size()-1) {
+                l[i] = sum;
+                levels.push_back(l);
+            } else {
+                const Size remaining = l.size()-1-i;
+                for (Size k=1; k + remaining <= sum; ++k) {
+                    l[i] = k;
+                    addLevels(l, i+1, sum-k, levels);
+                }
+            }
+        }
+
+    }
+
+    FdmSparseGridCombination::FdmSparseGridCombination(
+        Pricer pricer, Size dimensions)
+    : pricer_(std::move(pricer)), dimensions_(dimensions) {
+        QL_REQUIRE(dimensions_ > 0, "at least one dimension required");
+    }
+
+    void FdmSparseGridCombination::subgrids(
+        Size level,
+        std::vector<std::vector<Size> >& levels,
+        std::vector<Real>& coefficients) const {
+
+        QL_REQUIRE(level > 0, "positive level required");
+
+        levels.clear();
+        coefficients.clear();
+
+        const Size d = dimensions_;
+        std::vector<Size> l(d);
+        Real binomial = 1.0;
+        for (Size q=0; q < d; ++q) {
+            if (q > 0)
+                binomial *= Real(d-q)/q;
+
+            const Size sum = level + d - 1 - q;
+            if (sum < d)
+                break;
+
+            addLevels(l, 0, sum, levels);
+            coefficients.resize(levels.size(),
+                                (q % 2 == 0) ? binomial : -binomial);
+        }
+    }
+
+    Real FdmSparseGridCombination::operator()(Size level) const {
+        std::vector<std::vector<Size> > levels;
+        std::vector<Real> coefficients;
+        subgrids(level, levels, coefficients);
+
+        const Size n = levels.size();
+        std::vector<Real> prices(n);
+        std::vector<std::string> errors(n);
+
+        // the first grid is priced on its own so that shared lazy
+        // objects are calculated before the parallel section
+        prices[0] = pricer_(levels[0]);
+
+        #pragma omp parallel for
+        for (long i=1; i<(long)n; ++i) {
+            try {
+                prices[i] = pricer_(levels[i]);
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            }
+        }
+
+        Real result = 0.0;
+        for (Size i=0; i < n; ++i) {
+            QL_REQUIRE(errors[i].empty(),
+                       "subgrid #" << i+1 << ": " << errors[i]);
+            result += coefficients[i]*prices[i];
+        }
+        return result;
+    }
+
+}
@@ -0,0 +1,82 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmsparsegridcombination.hpp
+    \brief sparse-grid combination technique for finite-difference prices
+*/
+
+#ifndef quantlib_fdm_sparse_grid_combination_hpp
+#define quantlib_fdm_sparse_grid_combination_hpp
+
+#include <ql/types.hpp>
+#include <ql/functional.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Sparse-grid combination technique
+    /*! The price of a d-dimensional problem at level n is combined
+        from prices calculated on small anisotropic full grids,
+        \f[
+            u_n = \sum_{q=0}^{d-1} (-1)^q \binom{d-1}{q}
+                  \sum_{|l|_1 = n+d-1-q} u_l,
+        \f]
+        where \f$ l = (l_1, \dots, l_d) \f$ with \f$ l_i \geq 1 \f$
+        are the levels of the full grids.  The pricer is expected to
+        use about \f$ 2^{l_i} \f$ times a base number of points in
+        the i-th direction; the number of points of the combined
+        grids then grows as \f$ 2^n n^{d-1} \f$ instead of
+        \f$ 2^{nd} \f$.
+
+        The full grids are independent and are priced in parallel
+        when OpenMP is enabled.  The first one is priced on its own
+        before the others, so that the shared lazy objects (e.g.,
+        term structures used by the process) are calculated before
+        the pricer is called concurrently; apart from that, the
+        pricer must be safe to call from several threads.
+
+        References:
+        M. Griebel, M. Schneider, C. Zenger, 1992. A combination
+        technique for the solution of sparse grid problems.
+
+        C. Reisinger, G. Wittum, 2007. Efficient hierarchical
+        approximation of high-dimensional option pricing problems.
+        SIAM Journal on Scientific Computing 29(1), 440-458.
+    */
+    class FdmSparseGridCombination {
+      public:
+        //! returns the price on the full grid with the given levels
+        typedef ext::function<Real (const std::vector<Size>&)> Pricer;
+
+        FdmSparseGridCombination(Pricer pricer, Size dimensions);
+
+        //! combined price at the given level
+        Real operator()(Size level) const;
+
+        //! levels and coefficients of the full grids used at a level
+        void subgrids(Size level,
+                      std::vector<std::vector<Size> >& levels,
+                      std::vector<Real>& coefficients) const;
+
+      private:
+        const Pricer pricer_;
+        const Size dimensions_;
+    };
+
+}
+
+#endif
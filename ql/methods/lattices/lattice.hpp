@@ -152,11 +152,15 @@ namespace QuantLib {
         auto iFrom = Integer(t_.index(from));
         auto iTo = Integer(t_.index(to));
 
+        // the buffers are swapped at each step; since the lattice
+        // doesn't grow when rolling back, resizing them only shrinks
+        // the used part and doesn't allocate.
+        Array newValues;
         for (Integer i=iFrom-1; i>=iTo; --i) {
-            Array newValues(this->impl().size(i));
+            newValues.resize(this->impl().size(i));
             this->impl().stepback(i, asset.values(), newValues);
             asset.time() = t_[i];
-            asset.values() = newValues;
+            asset.values().swap(newValues);
             // skip the very last adjustment
             if (i != iTo)
                 asset.adjustValues();
@@ -84,4 +84,29 @@ namespace QuantLib {
         
         return error;
     }
+
+    bool BlackCalibrationHelper::calibrationErrorAndGradient(Real& error,
+                                                             Array& gradient) {
+        if (calibrationErrorType_ == ImpliedVolError)
+            return false;
+
+        Real modelPrice;
+        if (!modelValueAndGradient(modelPrice, gradient))
+            return false;
+
+        switch (calibrationErrorType_) {
+          case RelativePriceError:
+            error = std::fabs(marketValue() - modelPrice)/marketValue();
+            gradient *= (marketValue() >= modelPrice ? -1.0 : 1.0)/marketValue();
+            break;
+          case PriceError:
+            error = marketValue() - modelPrice;
+            gradient *= -1.0;
+            break;
+          default:
+            QL_FAIL("unknown Calibration Error Type");
+        }
+
+        return true;
+    }
 }
@@ -25,6 +25,7 @@
 #ifndef quantlib_interest_rate_modelling_calibration_helper_h
 #define quantlib_interest_rate_modelling_calibration_helper_h
 
+#include <ql/math/array.hpp>
 #include <ql/patterns/lazyobject.hpp>
 #include <ql/quote.hpp>
 #include <ql/termstructures/volatility/volatilitytype.hpp>
@@ -42,6 +43,15 @@ namespace QuantLib {
         virtual ~CalibrationHelper() = default;
         //! returns the error resulting from the model valuation
         virtual Real calibrationError() = 0;
+        /*! returns the calibration error together with its gradient
+            with respect to the model parameters, or false if the
+            latter is not available (in which case, calibrations fall
+            back to finite differences.)
+        */
+        virtual bool calibrationErrorAndGradient(Real& /*error*/,
+                                                 Array& /*gradient*/) {
+            return false;
+        }
     };
 
     /*! \deprecated Renamed to CalibrationHelper.
@@ -97,9 +107,23 @@ namespace QuantLib {
         //! returns the price of the instrument according to the model
         virtual Real modelValue() const = 0;
 
+        /*! returns the price of the instrument according to the
+            model and its gradient with respect to the model
+            parameters, or false if the engine doesn't provide it.
+        */
+        virtual bool modelValueAndGradient(Real& /*value*/,
+                                           Array& /*gradient*/) const {
+            return false;
+        }
+
         //! returns the error resulting from the model valuation
         Real calibrationError() override;
 
+        /*! \warning the gradient is not available for implied
+                     volatility errors.
+        */
+        bool calibrationErrorAndGradient(Real& error, Array& gradient) override;
+
         virtual void addTimesTo(std::list<Time>& times) const = 0;
 
         //! Black volatility implied by the model
@@ -23,6 +23,7 @@
 #include <ql/instruments/payoffs.hpp>
 #include <ql/models/equity/hestonmodelhelper.hpp>
 #include <ql/pricingengines/blackformula.hpp>
+#include <ql/pricingengines/vanilla/analytichestonengine.hpp>
 #include <ql/processes/hestonprocess.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <utility>
@@ -83,6 +84,19 @@ namespace QuantLib {
         return option_->NPV();
     }
 
+    bool HestonModelHelper::modelValueAndGradient(Real& value,
+                                                  Array& gradient) const {
+        calculate();
+        ext::shared_ptr<AnalyticHestonEngine> engine =
+            ext::dynamic_pointer_cast<AnalyticHestonEngine>(engine_);
+        if (!engine || !engine->providesGradient())
+            return false;
+
+        value = engine->valueAndGradient(
+            PlainVanillaPayoff(type_, strikePrice_), exerciseDate_, gradient);
+        return true;
+    }
+
     Real HestonModelHelper::blackPrice(Real volatility) const {
         calculate();
         const Real stdDev = volatility * std::sqrt(maturity());
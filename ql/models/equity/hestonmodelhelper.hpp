@@ -56,6 +56,10 @@ namespace QuantLib {
         void addTimesTo(std::list<Time>&) const override {}
         void performCalculations() const override;
         Real modelValue() const override;
+        /*! the gradient is available if the engine is an
+            AnalyticHestonEngine providing it.
+        */
+        bool modelValueAndGradient(Real& value, Array& gradient) const override;
         Real blackPrice(Real volatility) const override;
         Time maturity() const  { calculate(); return tau_; }
       private:
@@ -23,6 +23,7 @@
 #include <ql/math/optimization/projection.hpp>
 #include <ql/models/model.hpp>
 #include <ql/utilities/null_deleter.hpp>
+#include <string>
 #include <utility>
 
 using std::vector;
@@ -32,7 +33,7 @@ namespace QuantLib {
     CalibratedModel::CalibratedModel(Size nArguments)
     : arguments_(nArguments),
       constraint_(new PrivateConstraint(arguments_)),
-      shortRateEndCriteria_(EndCriteria::None) {}
+      shortRateEndCriteria_(EndCriteria::None), parallelCalibration_(false) {}
 
     class CalibratedModel::CalibrationFunction : public CostFunction {
       public:
@@ -46,32 +47,110 @@ namespace QuantLib {
         ~CalibrationFunction() override = default;
 
         Real value(const Array& params) const override {
-            model_->setParams(projection_.include(params));
+            Array errors(instruments_.size());
+            calibrationErrors(params, errors);
             Real value = 0.0;
-            for (Size i=0; i<instruments_.size(); i++) {
-                Real diff = instruments_[i]->calibrationError();
-                value += diff*diff*weights_[i];
-            }
+            for (Size i=0; i<instruments_.size(); i++)
+                value += errors[i]*errors[i]*weights_[i];
             return std::sqrt(value);
         }
 
         Disposable<Array> values(const Array& params) const override {
-            model_->setParams(projection_.include(params));
             Array values(instruments_.size());
-            for (Size i=0; i<instruments_.size(); i++) {
-                values[i] = instruments_[i]->calibrationError()
-                           *std::sqrt(weights_[i]);
-            }
+            calibrationErrors(params, values);
+            for (Size i=0; i<instruments_.size(); i++)
+                values[i] *= std::sqrt(weights_[i]);
             return values;
         }
 
+        void gradient(Array& grad, const Array& params) const override {
+            Array errors(instruments_.size());
+            Matrix jac(instruments_.size(), params.size());
+            if (!calibrationErrorsAndJacobian(params, errors, jac)) {
+                CostFunction::gradient(grad, params);
+                return;
+            }
+            Real value = 0.0;
+            for (Size i=0; i<instruments_.size(); i++)
+                value += errors[i]*errors[i]*weights_[i];
+            value = std::sqrt(value);
+            for (Size k=0; k<params.size(); k++) {
+                grad[k] = 0.0;
+                for (Size i=0; i<instruments_.size(); i++)
+                    grad[k] += weights_[i]*errors[i]*jac[i][k];
+                if (value > 0.0)
+                    grad[k] /= value;
+            }
+        }
+
+        void jacobian(Matrix& jac, const Array& params) const override {
+            Array errors(instruments_.size());
+            if (!calibrationErrorsAndJacobian(params, errors, jac)) {
+                CostFunction::jacobian(jac, params);
+                return;
+            }
+            for (Size i=0; i<instruments_.size(); i++)
+                for (Size k=0; k<params.size(); k++)
+                    jac[i][k] *= std::sqrt(weights_[i]);
+        }
+
         Real finiteDifferenceEpsilon() const override { return 1e-6; }
 
       private:
+        // uses the analytic gradients of the helpers if they all
+        // provide them; returns false otherwise.
+        bool calibrationErrorsAndJacobian(const Array& params,
+                                          Array& errors,
+                                          Matrix& jac) const {
+            model_->setParams(projection_.include(params));
+            Array gradient;
+            for (Size i=0; i<instruments_.size(); i++) {
+                if (!instruments_[i]->calibrationErrorAndGradient(errors[i],
+                                                                  gradient))
+                    return false;
+                Array projected = projection_.project(gradient);
+                QL_REQUIRE(projected.size() == params.size(),
+                           "wrong gradient size for calibration helper #"
+                           << i+1);
+                std::copy(projected.begin(), projected.end(), jac.row_begin(i));
+            }
+            return true;
+        }
+
+        void calibrationErrors(const Array& params, Array& errors) const {
+            model_->setParams(projection_.include(params));
+            Size n = instruments_.size();
+            // The first evaluation is always serial, so that the
+            // helpers can perform their own lazy calculations (e.g.,
+            // of the market values) and register with their observables
+            // outside of the parallel loop below; the same holds for
+            // any lazy object shared between them.
+            if (!model_->parallelCalibration_ || n < 2 || !initialized_) {
+                for (Size i=0; i<n; i++)
+                    errors[i] = instruments_[i]->calibrationError();
+                initialized_ = true;
+                return;
+            }
+
+            vector<std::string> messages(n);
+            #pragma omp parallel for
+            for (long i=0; i<(long)n; i++) {
+                try {
+                    errors[i] = instruments_[i]->calibrationError();
+                } catch (std::exception& e) {
+                    messages[i] = e.what();
+                }
+            }
+            for (Size i=0; i<n; i++)
+                QL_REQUIRE(messages[i].empty(),
+                           "calibration helper #" << i+1 << ": " << messages[i]);
+        }
+
         ext::shared_ptr<CalibratedModel> model_;
         const vector<ext::shared_ptr<CalibrationHelper> >& instruments_;
         vector<Real> weights_;
         const Projection projection_;
+        mutable bool initialized_ = false;
     };
 
     void CalibratedModel::calibrate(
@@ -95,6 +95,12 @@ namespace QuantLib {
         //! Calibrate to a set of market instruments (usually caps/swaptions)
         /*! An additional constraint can be passed which must be
             satisfied in addition to the constraints of the model.
+
+            If all the helpers provide the gradient of their
+            calibration error, the gradient and Jacobian of the cost
+            function are calculated analytically; otherwise, they fall
+            back to finite differences.  Note that LevenbergMarquardt
+            only uses them if \c useCostFunctionsJacobian is set.
         */
         virtual void calibrate(
                 const std::vector<ext::shared_ptr<CalibrationHelper> >&,
@@ -140,6 +146,29 @@ namespace QuantLib {
         virtual void setParams(const Array& params);
         Integer functionEvaluation() const { return functionEvaluation_; }
 
+        /*! If enabled and the library is compiled with OpenMP
+            support, the calibration errors of the helpers are
+            evaluated concurrently during calibration (except for the
+            first evaluation, which is always serial).  This also
+            applies to each of the evaluations used for the
+            finite-difference Jacobian of Levenberg-Marquardt, while
+            the parameter bumps themselves are still applied in
+            sequence since the model is shared.
+
+            \warning Pricing the helpers must not modify shared
+                     state; in particular, each helper must have its
+                     own pricing engine, and engines caching results
+                     in the model (such as the Gaussian 1-D ones)
+                     should not be used.  Swaption helpers using
+                     implied-volatility errors register temporary
+                     engines with the shared discount curve and
+                     require the thread-safe observer pattern.
+        */
+        void enableParallelCalibration(bool b = true) {
+            parallelCalibration_ = b;
+        }
+        bool parallelCalibration() const { return parallelCalibration_; }
+
       protected:
         virtual void generateArguments() {}
         std::vector<Parameter> arguments_;
@@ -149,6 +178,7 @@ namespace QuantLib {
         Integer functionEvaluation_;
 
       private:
+        bool parallelCalibration_;
         //! Constraint imposed on arguments
         class PrivateConstraint;
         //! Calibration cost function class
@@ -59,7 +59,7 @@ namespace QuantLib {
         const ext::shared_ptr<TermStructureFittingParameter::NumericalImpl>& theta,
         const TimeGrid& timeGrid)
     : TreeLattice1D<OneFactorModel::ShortRateTree>(timeGrid, tree->size(1)), tree_(tree),
-      dynamics_(std::move(dynamics)), spread_(0.0) {
+      dynamics_(std::move(dynamics)), spread_(0.0), discounts_(timeGrid.size()) {
 
         theta->reset();
         Real value = 1.0;
@@ -81,7 +81,34 @@ namespace QuantLib {
                                                  ext::shared_ptr<ShortRateDynamics> dynamics,
                                                  const TimeGrid& timeGrid)
     : TreeLattice1D<OneFactorModel::ShortRateTree>(timeGrid, tree->size(1)), tree_(tree),
-      dynamics_(std::move(dynamics)), spread_(0.0) {}
+      dynamics_(std::move(dynamics)), spread_(0.0), discounts_(timeGrid.size()) {}
+
+    const Array& OneFactorModel::ShortRateTree::discounts(Size i) const {
+        // only called when rolling back; the fitting in the constructor
+        // calls discount() directly since the parameter is still changing
+        Array& d = discounts_[i];
+        if (d.empty()) {
+            d = Array(size(i));
+            for (Size j=0; j<d.size(); j++)
+                d[j] = discount(i, j);
+        }
+        return d;
+    }
+
+    void OneFactorModel::ShortRateTree::stepback(Size i,
+                                                 const Array& values,
+                                                 Array& newValues) const {
+        const Array& d = discounts(i);
+        #pragma omp parallel for
+        for (long j=0; j<(long)d.size(); j++) {
+            Real value = 0.0;
+            for (Size l=0; l<TrinomialTree::branches; l++) {
+                value += tree_->probability(i,j,l) *
+                         values[tree_->descendant(i,j,l)];
+            }
+            newValues[j] = value * d[j];
+        }
+    }
 
     OneFactorModel::OneFactorModel(Size nArguments)
     : ShortRateModel(nArguments) {}
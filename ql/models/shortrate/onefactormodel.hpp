@@ -102,15 +102,23 @@ namespace QuantLib {
         Real probability(Size i, Size index, Size branch) const {
             return tree_->probability(i, index, branch);
         }
+        /*! Rolls back using the discount factors of the nodes at
+            step \f$ i \f$, which are calculated once and stored.
+        */
+        void stepback(Size i, const Array& values, Array& newValues) const;
         void setSpread(Spread spread)
         {
+            if (spread != spread_)
+                discounts_ = std::vector<Array>(discounts_.size());
             spread_=spread;
         }
       private:
+        const Array& discounts(Size i) const;
         ext::shared_ptr<TrinomialTree> tree_;
         ext::shared_ptr<ShortRateDynamics> dynamics_;
         class Helper;
         Spread spread_;
+        mutable std::vector<Array> discounts_;
     };
 
     //! Single-factor affine base class
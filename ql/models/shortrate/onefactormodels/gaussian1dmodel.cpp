@@ -20,11 +20,89 @@
 #include <ql/models/shortrate/onefactormodels/gaussian1dmodel.hpp>
 #include <ql/math/interpolations/cubicinterpolation.hpp>
 #include <ql/payoff.hpp>
+#include <algorithm>
 
 using std::exp;
 
 namespace QuantLib {
 
+    Disposable<Array>
+    Gaussian1dModel::numeraire(const Time t, const Array& y,
+                               const Handle<YieldTermStructure>& yts) const {
+
+        calculate();
+
+        Array result(y.size());
+        if (y.empty())
+            return result;
+
+        if (!yts.empty()) {
+            numeraireGridImpl(t, y, yts, result);
+            return result;
+        }
+
+        CachedGrid& c = cachedGrid(true, 0.0, t, y);
+        if (c.values.empty()) {
+            c.values = Array(y.size());
+            numeraireGridImpl(t, y, yts, c.values);
+        }
+        std::copy(c.values.begin(), c.values.end(), result.begin());
+        return result;
+    }
+
+    Disposable<Array>
+    Gaussian1dModel::zerobond(const Time T, const Time t, const Array& y,
+                              const Handle<YieldTermStructure>& yts) const {
+
+        calculate();
+
+        Array result(y.size());
+        if (y.empty())
+            return result;
+
+        if (!yts.empty()) {
+            zerobondGridImpl(T, t, y, yts, result);
+            return result;
+        }
+
+        CachedGrid& c = cachedGrid(false, T, t, y);
+        if (c.values.empty()) {
+            c.values = Array(y.size());
+            zerobondGridImpl(T, t, y, yts, c.values);
+        }
+        std::copy(c.values.begin(), c.values.end(), result.begin());
+        return result;
+    }
+
+    Gaussian1dModel::CachedGrid&
+    Gaussian1dModel::cachedGrid(const bool numeraire, const Time T,
+                                const Time t, const Array& y) const {
+        CachedGridKey k = {numeraire, T, t, y.size(), y.front(), y.back()};
+        CachedGrid& c = gridCache_[k];
+        if (c.y.size() != y.size() ||
+            !std::equal(y.begin(), y.end(), c.y.begin())) {
+            // new entry, or a different grid with the same bounds
+            c.y = y;
+            c.values = Array();
+        }
+        return c;
+    }
+
+    void Gaussian1dModel::numeraireGridImpl(const Time t, const Array& y,
+                                            const Handle<YieldTermStructure>& yts,
+                                            Array& result) const {
+        for (Size i = 0; i < y.size(); ++i)
+            result[i] = numeraireImpl(t, y[i], yts);
+    }
+
+    void Gaussian1dModel::zerobondGridImpl(const Time T, const Time t,
+                                           const Array& y,
+                                           const Handle<YieldTermStructure>& yts,
+                                           Array& result) const {
+        for (Size i = 0; i < y.size(); ++i)
+            result[i] = zerobondImpl(T, t, y[i], yts);
+    }
+
     Real Gaussian1dModel::forwardRate(const Date& fixing,
                                       const Date& referenceDate,
                                       const Real y,
@@ -38,6 +38,7 @@
 #include <ql/stochasticprocess.hpp>
 #include <ql/utilities/null.hpp>
 #include <ql/patterns/lazyobject.hpp>
+#include <map>
 
 #ifdef GAUSS1D_ENABLE_NTL
 #include <boost/math/bindings/rr.hpp>
@@ -95,6 +96,23 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
                   Real y = 0.0,
                   const Handle<YieldTermStructure>& yts = Handle<YieldTermStructure>()) const;
 
+    /*! Vectorised versions of numeraire and zerobond for a grid of
+        states $y$. When no yield term structure is given the results
+        are cached in the model, so that engines pricing several
+        instruments on the same grids share them; the cache is
+        cleared when the model is recalculated or its parameters
+        change. */
+    Disposable<Array>
+    numeraire(Time t,
+              const Array& y,
+              const Handle<YieldTermStructure>& yts = Handle<YieldTermStructure>()) const;
+
+    Disposable<Array>
+    zerobond(Time T,
+             Time t,
+             const Array& y,
+             const Handle<YieldTermStructure>& yts = Handle<YieldTermStructure>()) const;
+
     Real zerobondOption(const Option::Type& type,
                         const Date& expiry,
                         const Date& valueDate,
@@ -184,6 +202,38 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
 
     mutable CacheType swapCache_;
 
+    // numeraires and zero bonds on state grids, see the vectorised
+    // numeraire and zerobond methods above. The key holds the grid
+    // size and bounds, the full grid is compared on lookup.
+
+    struct CachedGridKey {
+        bool numeraire;
+        Time T, t;
+        Size size;
+        Real yMin, yMax;
+        bool operator<(const CachedGridKey &o) const {
+            if (numeraire != o.numeraire)
+                return numeraire < o.numeraire;
+            if (T != o.T)
+                return T < o.T;
+            if (t != o.t)
+                return t < o.t;
+            if (size != o.size)
+                return size < o.size;
+            if (yMin != o.yMin)
+                return yMin < o.yMin;
+            return yMax < o.yMax;
+        }
+    };
+
+    struct CachedGrid {
+        Array y, values;
+    };
+
+    mutable std::map<CachedGridKey, CachedGrid> gridCache_;
+
+    CachedGrid& cachedGrid(bool numeraire, Time T, Time t, const Array& y) const;
+
   protected:
     // we let derived classes register with the termstructure
     Gaussian1dModel(const Handle<YieldTermStructure> &yieldTermStructure)
@@ -198,17 +248,36 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
     virtual Real
     zerobondImpl(Time T, Time t, Real y, const Handle<YieldTermStructure>& yts) const = 0;
 
+    /*! vectorised implementations, the default ones call the
+        scalar methods above for each state */
+    virtual void numeraireGridImpl(Time t,
+                                   const Array& y,
+                                   const Handle<YieldTermStructure>& yts,
+                                   Array& result) const;
+
+    virtual void zerobondGridImpl(Time T,
+                                  Time t,
+                                  const Array& y,
+                                  const Handle<YieldTermStructure>& yts,
+                                  Array& result) const;
+
     void performCalculations() const override {
         evaluationDate_ = Settings::instance().evaluationDate();
         enforcesTodaysHistoricFixings_ =
             Settings::instance().enforcesTodaysHistoricFixings();
+        gridCache_.clear();
     }
 
     void generateArguments() {
         calculate();
+        gridCache_.clear();
         notifyObservers();
     }
 
+    //! must be called by derived classes when their parameters change
+    //  without the model being recalculated
+    void clearGridCache() const { gridCache_.clear(); }
+
     // retrieve underlying swap from cache if possible, otherwise
     // create it and store it in the cache
     ext::shared_ptr<VanillaSwap>
@@ -19,6 +19,7 @@
 
 #include <ql/models/shortrate/onefactormodels/gsr.hpp>
 #include <ql/quotes/simplequote.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace QuantLib {
@@ -216,4 +217,57 @@ Real Gsr::numeraireImpl(const Time t, const Real y,
                    : yts->discount(p->getForwardMeasureTime());
     return zerobond(p->getForwardMeasureTime(), t, y, yts);
 }
+
+void Gsr::zerobondGridImpl(const Time T, const Time t, const Array& y,
+                           const Handle<YieldTermStructure> &yts,
+                           Array& result) const {
+
+    calculate();
+
+    if (t == 0.0) {
+        std::fill(result.begin(), result.end(),
+                  yts.empty() ? this->termStructure()->discount(T, true)
+                              : yts->discount(T, true));
+        return;
+    }
+
+    ext::shared_ptr<GsrProcess> p =
+        ext::dynamic_pointer_cast<GsrProcess>(stateProcess_);
+
+    // everything but the state itself is computed once for the grid
+    Real stdDev = stateProcess_->stdDeviation(0.0, 0.0, t);
+    Real expectation = stateProcess_->expectation(0.0, 0.0, t);
+    Real yt = p->y(t);
+
+    Real d = yts.empty()
+                 ? termStructure()->discount(T, true) /
+                       termStructure()->discount(t, true)
+                 : yts->discount(T, true) / yts->discount(t, true);
+
+    for (Size i = 0; i < y.size(); ++i) {
+        Real x = y[i] * stdDev + expectation;
+        Real gtT = p->G(t, T, x);
+        result[i] = d * exp(-x * gtT - 0.5 * yt * gtT * gtT);
+    }
+}
+
+void Gsr::numeraireGridImpl(const Time t, const Array& y,
+                            const Handle<YieldTermStructure> &yts,
+                            Array& result) const {
+
+    calculate();
+
+    ext::shared_ptr<GsrProcess> p =
+        ext::dynamic_pointer_cast<GsrProcess>(stateProcess_);
+
+    if (t == 0) {
+        std::fill(result.begin(), result.end(),
+                  yts.empty()
+                      ? this->termStructure()->discount(
+                            p->getForwardMeasureTime(), true)
+                      : yts->discount(p->getForwardMeasureTime()));
+        return;
+    }
+    zerobondGridImpl(p->getForwardMeasureTime(), t, y, yts, result);
+}
 }
@@ -141,8 +141,20 @@ class Gsr : public Gaussian1dModel, public CalibratedModel {
 
     Real zerobondImpl(Time T, Time t, Real y, const Handle<YieldTermStructure>& yts) const override;
 
+    void numeraireGridImpl(Time t,
+                           const Array& y,
+                           const Handle<YieldTermStructure>& yts,
+                           Array& result) const override;
+
+    void zerobondGridImpl(Time T,
+                          Time t,
+                          const Array& y,
+                          const Handle<YieldTermStructure>& yts,
+                          Array& result) const override;
+
     void generateArguments() override {
         ext::static_pointer_cast<GsrProcess>(stateProcess_)->flushCache();
+        clearGridCache();
         notifyObservers();
     }
 
@@ -27,6 +27,7 @@
 #include <ql/termstructures/volatility/sabrinterpolatedsmilesection.hpp>
 #include <ql/termstructures/volatility/smilesection.hpp>
 #include <ql/termstructures/volatility/smilesectionutils.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace QuantLib {
@@ -818,6 +819,44 @@ namespace QuantLib {
                                      termStructure()->discount(T)));
     }
 
+    void MarkovFunctional::numeraireGridImpl(
+        const Time t, const Array& y,
+        const Handle<YieldTermStructure> &yts, Array& result) const {
+
+        if (t == 0) {
+            std::fill(result.begin(), result.end(),
+                      yts.empty()
+                          ? this->termStructure()->discount(numeraireTime(), true)
+                          : yts->discount(numeraireTime()));
+            return;
+        }
+
+        result = numeraireArray(t, y);
+        if (!yts.empty())
+            result *= yts->discount(numeraireTime()) / yts->discount(t) *
+                      termStructure()->discount(t) /
+                      termStructure()->discount(numeraireTime());
+    }
+
+    void
+    MarkovFunctional::zerobondGridImpl(const Time T, const Time t, const Array& y,
+                                       const Handle<YieldTermStructure> &yts,
+                                       Array& result) const {
+
+        if (t == 0.0) {
+            std::fill(result.begin(), result.end(),
+                      yts.empty() ? this->termStructure()->discount(T, true)
+                                  : yts->discount(T, true));
+            return;
+        }
+
+        result = zerobondArray(T, t, y);
+        if (!yts.empty())
+            result *= yts->discount(T) / yts->discount(t) *
+                      termStructure()->discount(t) /
+                      termStructure()->discount(T);
+    }
+
     Real MarkovFunctional::deflatedZerobond(Time T, Time t,
                                             Real y) const {
 
@@ -387,12 +387,24 @@ namespace QuantLib {
         Real
         zerobondImpl(Time T, Time t, Real y, const Handle<YieldTermStructure>& yts) const override;
 
+        void numeraireGridImpl(Time t,
+                               const Array& y,
+                               const Handle<YieldTermStructure>& yts,
+                               Array& result) const override;
+
+        void zerobondGridImpl(Time T,
+                              Time t,
+                              const Array& y,
+                              const Handle<YieldTermStructure>& yts,
+                              Array& result) const override;
+
         void generateArguments() override {
             // if calculate triggers performCalculations, updateNumeraireTabulations
             // is called twice. If we can not check the lazy object status this seem
             // hard to avoid though.
             calculate();
             updateNumeraireTabulation();
+            clearGridCache();
             notifyObservers();
         }
 
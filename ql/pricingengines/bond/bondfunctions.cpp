@@ -25,6 +25,7 @@
 
 #include <ql/math/solvers1d/newtonsafe.hpp>
 #include <ql/pricingengines/bond/bondfunctions.hpp>
+#include <string>
 
 namespace QuantLib {
 
@@ -475,6 +476,108 @@ namespace QuantLib {
                                                false, settlement);
     }
 
+    std::vector<Rate> BondFunctions::yields(
+                       const std::vector<ext::shared_ptr<Bond> >& bonds,
+                       const std::vector<Real>& prices,
+                       const DayCounter& dayCounter,
+                       Compounding compounding,
+                       Frequency frequency,
+                       Date settlement,
+                       Real accuracy,
+                       Size maxIterations,
+                       Rate guess,
+                       Bond::Price::Type priceType) {
+        QL_REQUIRE(bonds.size() == prices.size(),
+                   "number of bonds (" << bonds.size() <<
+                   ") different from number of prices (" <<
+                   prices.size() << ")");
+
+        Size n = bonds.size();
+
+        // the cash flows are inspected serially, since they might
+        // trigger lazy calculations...
+        std::vector<LegSnapshot> snapshots;
+        std::vector<Real> dirtyPrices(n);
+        snapshots.reserve(n);
+        for (Size i=0; i<n; ++i) {
+            const Bond& bond = *bonds[i];
+            Date settlementDate =
+                settlement == Date() ? bond.settlementDate() : settlement;
+
+            QL_REQUIRE(BondFunctions::isTradable(bond, settlementDate),
+                       "bond #" << i+1 << " non tradable at " <<
+                       settlementDate << " (maturity being " <<
+                       bond.maturityDate() << ")");
+
+            Real dirtyPrice = prices[i];
+            if (priceType == Bond::Price::Clean)
+                dirtyPrice += bond.accruedAmount(settlementDate);
+            dirtyPrices[i] = dirtyPrice / (100.0 / bond.notional(settlementDate));
+
+            snapshots.emplace_back(bond.cashflows(), dayCounter, false,
+                                   settlementDate, settlementDate);
+        }
+
+        // ...while the solvers only work on the snapshots and can
+        // run in parallel.
+        std::vector<Rate> result(n);
+        std::vector<std::string> errors(n);
+        #pragma omp parallel for
+        for (long i=0; i<(long)n; ++i) {
+            try {
+                NewtonSafe solver;
+                solver.setMaxEvaluations(maxIterations);
+                result[i] = CashFlows::yield<NewtonSafe>(solver, snapshots[i],
+                                                         dirtyPrices[i],
+                                                         compounding, frequency,
+                                                         accuracy, guess);
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            }
+        }
+        for (Size i=0; i<n; ++i)
+            QL_REQUIRE(errors[i].empty(),
+                       "bond #" << i+1 << ": " << errors[i]);
+
+        return result;
+    }
+
+    std::vector<Real> BondFunctions::prices(
+                       const std::vector<ext::shared_ptr<Bond> >& bonds,
+                       const std::vector<Rate>& yields,
+                       const DayCounter& dayCounter,
+                       Compounding compounding,
+                       Frequency frequency,
+                       Date settlement,
+                       Bond::Price::Type priceType) {
+        QL_REQUIRE(bonds.size() == yields.size(),
+                   "number of bonds (" << bonds.size() <<
+                   ") different from number of yields (" <<
+                   yields.size() << ")");
+
+        std::vector<Real> result(bonds.size());
+        for (Size i=0; i<bonds.size(); ++i) {
+            const Bond& bond = *bonds[i];
+            Date settlementDate =
+                settlement == Date() ? bond.settlementDate() : settlement;
+
+            QL_REQUIRE(BondFunctions::isTradable(bond, settlementDate),
+                       "bond #" << i+1 << " non tradable at " <<
+                       settlementDate << " (maturity being " <<
+                       bond.maturityDate() << ")");
+
+            LegSnapshot snapshot(bond.cashflows(), dayCounter, false,
+                                 settlementDate, settlementDate);
+            InterestRate y(yields[i], dayCounter, compounding, frequency);
+            Real price = CashFlows::npv(snapshot, y) *
+                100.0 / bond.notional(settlementDate);
+            if (priceType == Bond::Price::Clean)
+                price -= bond.accruedAmount(settlementDate);
+            result[i] = price;
+        }
+        return result;
+    }
+
     Real BondFunctions::cleanPrice(const Bond& bond,
                                    const ext::shared_ptr<YieldTermStructure>& d,
                                    Spread zSpread,
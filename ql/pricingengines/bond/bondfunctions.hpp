@@ -33,6 +33,7 @@
 #include <ql/interestrate.hpp>
 #include <ql/instruments/bond.hpp>
 #include <ql/shared_ptr.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -226,6 +227,35 @@ namespace QuantLib {
                                          Date settlementDate = Date());
         //@}
 
+        //! \name Batch yield functions
+        /*! Price/yield conversions for a number of bonds at once.
+            The cash flows of each bond are flattened once into a
+            LegSnapshot and the solver then runs on the snapshots;
+            if no settlement date is given, the settlement date of
+            each bond is used.
+        */
+        //@{
+        static std::vector<Rate> yields(
+                       const std::vector<ext::shared_ptr<Bond> >& bonds,
+                       const std::vector<Real>& prices,
+                       const DayCounter& dayCounter,
+                       Compounding compounding,
+                       Frequency frequency,
+                       Date settlementDate = Date(),
+                       Real accuracy = 1.0e-10,
+                       Size maxIterations = 100,
+                       Rate guess = 0.05,
+                       Bond::Price::Type priceType = Bond::Price::Clean);
+        static std::vector<Real> prices(
+                       const std::vector<ext::shared_ptr<Bond> >& bonds,
+                       const std::vector<Rate>& yields,
+                       const DayCounter& dayCounter,
+                       Compounding compounding,
+                       Frequency frequency,
+                       Date settlementDate = Date(),
+                       Bond::Price::Type priceType = Bond::Price::Clean);
+        //@}
+
         //! \name Z-spread functions
         //@{
         static Real cleanPrice(const Bond& bond,
@@ -58,6 +58,27 @@ namespace QuantLib {
 
                 Real strike;
 
+                // zero bonds and numeraire on the whole state grid,
+                // cached by the model across optionlets and instruments
+                Array paymentZerobonds, valueZerobonds,
+                    discountedPaymentZerobonds, numeraires;
+                if (fixingDate > settlement) {
+                    Time valueTime =
+                        model_->termStructure()->timeFromReference(valueDate);
+                    Time paymentTime =
+                        model_->termStructure()->timeFromReference(paymentDate);
+                    paymentZerobonds =
+                        model_->zerobond(paymentTime, fixingTime, z);
+                    if (iborIndex != nullptr)
+                        discountedPaymentZerobonds = model_->zerobond(
+                            paymentTime, fixingTime, z, discountCurve_);
+                    else
+                        valueZerobonds =
+                            model_->zerobond(valueTime, fixingTime, z);
+                    numeraires =
+                        model_->numeraire(fixingTime, z, discountCurve_);
+                }
+
                 if (type == CapFloor::Cap || type == CapFloor::Collar) {
                     strike = arguments_.capRates[i];
                     if (fixingDate <= settlement) {
@@ -75,22 +96,17 @@ namespace QuantLib {
                                     arguments_.accrualTimes[i] *
                                     model_->forwardRate(fixingDate, fixingDate,
                                                         z[j], iborIndex) *
-                                    model_->zerobond(paymentDate, fixingDate,
-                                                     z[j], discountCurve_);
+                                    discountedPaymentZerobonds[j];
                             else
                                 floatingLegNpv =
-                                    (model_->zerobond(valueDate, fixingDate,
-                                                      z[j]) -
-                                     model_->zerobond(paymentDate, fixingDate,
-                                                      z[j]));
+                                    valueZerobonds[j] - paymentZerobonds[j];
                             Real fixedLegNpv =
                                 arguments_.capRates[i] *
                                 arguments_.accrualTimes[i] *
-                                model_->zerobond(paymentDate, fixingDate, z[j]);
+                                paymentZerobonds[j];
                             p[j] =
                                 std::max((floatingLegNpv - fixedLegNpv), 0.0) /
-                                model_->numeraire(fixingTime, z[j],
-                                                  discountCurve_);
+                                numeraires[j];
                         }
                         CubicInterpolation payoff(
                             z.begin(), z.end(), p.begin(),
@@ -147,22 +163,17 @@ namespace QuantLib {
                                     arguments_.accrualTimes[i] *
                                     model_->forwardRate(fixingDate, fixingDate,
                                                         z[j], iborIndex) *
-                                    model_->zerobond(paymentDate, fixingDate,
-                                                     z[j], discountCurve_);
+                                    discountedPaymentZerobonds[j];
                             else
                                 floatingLegNpv =
-                                    (model_->zerobond(valueDate, fixingDate,
-                                                      z[j]) -
-                                     model_->zerobond(paymentDate, fixingDate,
-                                                      z[j]));
+                                    valueZerobonds[j] - paymentZerobonds[j];
                             Real fixedLegNpv =
                                 arguments_.floorRates[i] *
                                 arguments_.accrualTimes[i] *
-                                model_->zerobond(paymentDate, fixingDate, z[j]);
+                                paymentZerobonds[j];
                             p[j] =
                                 std::max(-(floatingLegNpv - fixedLegNpv), 0.0) /
-                                model_->numeraire(fixingTime, z[j],
-                                                  discountCurve_);
+                                numeraires[j];
                         }
                         CubicInterpolation payoff(
                             z.begin(), z.end(), p.begin(),
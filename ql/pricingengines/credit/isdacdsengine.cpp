@@ -42,13 +42,65 @@ namespace QuantLib {
     : probability_(std::move(probability)), recoveryRate_(recoveryRate),
       discountCurve_(std::move(discountCurve)),
       includeSettlementDateFlows_(includeSettlementDateFlows), numericalFix_(numericalFix),
-      accrualBias_(accrualBias), forwardsInCouponPeriod_(forwardsInCouponPeriod) {
+      accrualBias_(accrualBias), forwardsInCouponPeriod_(forwardsInCouponPeriod),
+      nodesCalculated_(false), nodeValues_(0) {
 
         registerWith(probability_);
         registerWith(discountCurve_);
     }
 
+
+    void IsdaCdsEngine::update() {
+        nodesCalculated_ = false;
+        CreditDefaultSwap::engine::update();
+    }
+
     void IsdaCdsEngine::calculate() const {
+        checkCurves();
+        Date horizon = arguments_.maturity;
+        if (!arguments_.leg.empty())
+            horizon = std::max(horizon, arguments_.leg.back()->date());
+        calculateNodeValues(horizon);
+        price();
+    }
+
+    std::vector<CreditDefaultSwap::results> IsdaCdsEngine::calculate(
+        const std::vector<ext::shared_ptr<CreditDefaultSwap> >& swaps) const {
+
+        checkCurves();
+
+        Date horizon = Date::minDate();
+        for (const auto& swap : swaps) {
+            QL_REQUIRE(swap, "null credit default swap");
+            if (swap->isExpired())
+                continue;
+            // the protection ends at or after the maturity
+            horizon = std::max(horizon, swap->protectionEndDate());
+            horizon = std::max(horizon, swap->coupons().back()->date());
+        }
+        calculateNodeValues(horizon);
+
+        std::vector<CreditDefaultSwap::results> results(swaps.size());
+        for (Size i = 0; i < swaps.size(); ++i) {
+            if (swaps[i]->isExpired()) {
+                // as in CreditDefaultSwap::setupExpired
+                results[i].value = results[i].errorEstimate = 0.0;
+                results[i].fairSpread = results[i].fairUpfront = 0.0;
+                results[i].couponLegBPS = results[i].upfrontBPS = 0.0;
+                results[i].couponLegNPV = results[i].defaultLegNPV = 0.0;
+                results[i].upfrontNPV = results[i].accrualRebateNPV = 0.0;
+                continue;
+            }
+            swaps[i]->setupArguments(&arguments_);
+            arguments_.validate();
+            results_.reset();
+            price();
+            results[i] = results_;
+        }
+        return results;
+    }
+
+    void IsdaCdsEngine::checkCurves() const {
 
         QL_REQUIRE(numericalFix_ == None || numericalFix_ == Taylor,
                    "numerical fix must be None or Taylor");
@@ -58,18 +110,11 @@ namespace QuantLib {
                        forwardsInCouponPeriod_ == Piecewise,
                    "forwards in coupon period must be Flat or Piecewise");
 
-        // it would be possible to handle the cases which are excluded below,
-        // but the ISDA engine is not explicitly specified to handle them,
-        // so we just forbid them too
-
         Actual365Fixed dc;
-        Actual360 dc1;
-        Actual360 dc2(true);
-
         Date evalDate = Settings::instance().evaluationDate();
 
         // check if given curves are ISDA compatible
-        // (the interpolation is checked below)
+        // (the interpolation is checked when collecting the nodes)
 
         QL_REQUIRE(!discountCurve_.empty(), "no discount term structure set");
         QL_REQUIRE(!probability_.empty(), "no probability term structure set");
@@ -89,16 +134,14 @@ namespace QuantLib {
                    "probability term structure reference date ("
                        << probability_->referenceDate()
                        << " should be evaluation date (" << evalDate << ")");
-        QL_REQUIRE(arguments_.settlesAccrual,
-                   "ISDA engine not compatible with non accrual paying CDS");
-        QL_REQUIRE(arguments_.paysAtDefaultTime,
-                   "ISDA engine not compatible with end period payment");
-        QL_REQUIRE(ext::dynamic_pointer_cast<FaceValueClaim>(arguments_.claim) != nullptr,
-                   "ISDA engine not compatible with non face value claim");
+    }
 
-        Date maturity = arguments_.maturity;
-        Date effectiveProtectionStart =
-            std::max<Date>(arguments_.protectionStart, evalDate + 1);
+    const std::vector<Date>& IsdaCdsEngine::nodes() const {
+
+        // the node dates don't change while a default curve is being
+        // bootstrapped, so they can be kept until the curves notify
+        if (nodesCalculated_)
+            return nodes_;
 
         // collect nodes from both curves and sort them
         std::vector<Date> yDates, cDates;
@@ -140,13 +183,54 @@ namespace QuantLib {
             QL_FAIL("Credit curve must be flat forward interpolated");
         }
 
-        std::vector<Date> nodes;
-        std::set_union(yDates.begin(), yDates.end(), cDates.begin(), cDates.end(), std::back_inserter(nodes));
-
+        nodes_.clear();
+        std::set_union(yDates.begin(), yDates.end(), cDates.begin(), cDates.end(), std::back_inserter(nodes_));
+        nodesCalculated_ = true;
+        return nodes_;
+    }
 
-        if(nodes.empty()){
-            nodes.push_back(maturity);
+    void IsdaCdsEngine::calculateNodeValues(const Date& horizon) const {
+        const std::vector<Date>& n = nodes();
+        nodeValues_ = std::upper_bound(n.begin(), n.end(), horizon) - n.begin();
+        nodeTimes_.resize(nodeValues_);
+        nodeDiscounts_.resize(nodeValues_);
+        nodeSurvivals_.resize(nodeValues_);
+        for (Size i = 0; i < nodeValues_; ++i) {
+            nodeTimes_[i] = discountCurve_->timeFromReference(n[i]);
+            nodeDiscounts_[i] = discountCurve_->discount(n[i]);
+            nodeSurvivals_[i] = probability_->survivalProbability(n[i]);
         }
+    }
+
+    void IsdaCdsEngine::price() const {
+
+        // it would be possible to handle the cases which are excluded below,
+        // but the ISDA engine is not explicitly specified to handle them,
+        // so we just forbid them too
+
+        Actual365Fixed dc;
+        Actual360 dc1;
+        Actual360 dc2(true);
+
+        Date evalDate = Settings::instance().evaluationDate();
+
+        QL_REQUIRE(arguments_.settlesAccrual,
+                   "ISDA engine not compatible with non accrual paying CDS");
+        QL_REQUIRE(arguments_.paysAtDefaultTime,
+                   "ISDA engine not compatible with end period payment");
+        QL_REQUIRE(ext::dynamic_pointer_cast<FaceValueClaim>(arguments_.claim) != nullptr,
+                   "ISDA engine not compatible with non face value claim");
+
+        Date maturity = arguments_.maturity;
+        Date effectiveProtectionStart =
+            std::max<Date>(arguments_.protectionStart, evalDate + 1);
+
+        // nodes and curve values calculated in calculateNodeValues;
+        // without nodes, the maturity is used and evaluated directly
+        std::vector<Date> maturityNode(1, maturity);
+        const std::vector<Date>& nodes = nodes_.empty() ? maturityNode : nodes_;
+        const Size nodeValues = nodes_.empty() ? 0 : nodeValues_;
+
         const Real nFix = (numericalFix_ == None ? 1E-50 : 0.0);
 
         // protection leg pricing (npv is always negative at this stage)
@@ -155,19 +239,22 @@ namespace QuantLib {
         Date d0 = effectiveProtectionStart-1;
         Real P0 = discountCurve_->discount(d0);
         Real Q0 = probability_->survivalProbability(d0);
-        Date d1;
-        std::vector<Date>::const_iterator it =
-            std::upper_bound(nodes.begin(), nodes.end(), effectiveProtectionStart);
-
-        for(;it != nodes.end(); ++it) {
-            if(*it > maturity) {
-                d1 = maturity;
-                it = nodes.end() - 1; //early exit
+        Size k = std::upper_bound(nodes.begin(), nodes.end(), effectiveProtectionStart) -
+                 nodes.begin();
+
+        for (; k < nodes.size(); ++k) {
+            Real P1, Q1;
+            if (nodes[k] > maturity) {
+                P1 = discountCurve_->discount(maturity);
+                Q1 = probability_->survivalProbability(maturity);
+                k = nodes.size() - 1; //early exit
+            } else if (k < nodeValues) {
+                P1 = nodeDiscounts_[k];
+                Q1 = nodeSurvivals_[k];
             } else {
-                d1 = *it;
+                P1 = discountCurve_->discount(nodes[k]);
+                Q1 = probability_->survivalProbability(nodes[k]);
             }
-            Real P1 = discountCurve_->discount(d1);
-            Real Q1 = probability_->survivalProbability(d1);
 
             Real fhat = std::log(P0) - std::log(P1);
             Real hhat = std::log(Q0) - std::log(Q1);
@@ -182,7 +269,6 @@ namespace QuantLib {
             } else {
                 protectionNpv += hhat / (fhphh + nFix) * (P0 * Q0 - P1 * Q1);
             }
-            d0 = d1;
             P0 = P1;
             Q0 = Q1;
         }
@@ -221,28 +307,38 @@ namespace QuantLib {
                 Real tstart =
                     discountCurve_->timeFromReference(coupon->accrualStartDate()-1) -
                     (accrualBias_ == HalfDayBias ? 1.0 / 730.0 : 0.0);
-                std::vector<Date> localNodes;
-                localNodes.push_back(start);
-                //add intermediary nodes, if any
+
+                // intermediary nodes, if any, are taken from the
+                // precalculated values
+                Size first = 0, last = 0;
                 if (forwardsInCouponPeriod_ == Piecewise) {
-                    std::vector<Date>::const_iterator it0 =
-                        std::upper_bound(nodes.begin(), nodes.end(), start);
-                    std::vector<Date>::const_iterator it1 =
-                        std::lower_bound(nodes.begin(), nodes.end(), end);
-                    localNodes.insert(localNodes.end(), it0, it1);
+                    first = std::upper_bound(nodes.begin(), nodes.end(), start) -
+                            nodes.begin();
+                    last = std::lower_bound(nodes.begin(), nodes.end(), end) -
+                           nodes.begin();
+                    last = std::max(first, last);
                 }
-                localNodes.push_back(end);
 
                 Real defaultAccrThisNode = 0.;
-                std::vector<Date>::const_iterator node = localNodes.begin();
-                Real t0 = discountCurve_->timeFromReference(*node);
-                Real P0 = discountCurve_->discount(*node);
-                Real Q0 = probability_->survivalProbability(*node);
-
-                for (++node; node != localNodes.end(); ++node) {
-                    Real t1 = discountCurve_->timeFromReference(*node);
-                    Real P1 = discountCurve_->discount(*node);
-                    Real Q1 = probability_->survivalProbability(*node);
+                Real t0 = discountCurve_->timeFromReference(start);
+                Real P0 = discountCurve_->discount(start);
+                Real Q0 = probability_->survivalProbability(start);
+
+                for (Size j = first; j <= last; ++j) {
+                    Real t1, P1, Q1;
+                    if (j == last) {
+                        t1 = discountCurve_->timeFromReference(end);
+                        P1 = discountCurve_->discount(end);
+                        Q1 = probability_->survivalProbability(end);
+                    } else if (j < nodeValues) {
+                        t1 = nodeTimes_[j];
+                        P1 = nodeDiscounts_[j];
+                        Q1 = nodeSurvivals_[j];
+                    } else {
+                        t1 = discountCurve_->timeFromReference(nodes[j]);
+                        P1 = discountCurve_->discount(nodes[j]);
+                        Q1 = probability_->survivalProbability(nodes[j]);
+                    }
                     Real fhat = std::log(P0) - std::log(P1);
                     Real hhat = std::log(Q0) - std::log(Q1);
                     Real fhphh = fhat + hhat;
@@ -92,6 +92,12 @@ namespace QuantLib {
 
             Furthermore, the ibor index in the swap rate helpers should not
             provide the evaluation date's fixing.
+
+            The merged nodes of the two curves are cached by the engine
+            and only recomputed when the curves notify a change, so that
+            they are shared by all swaps priced with the same engine;
+            discount factors and survival probabilities are evaluated
+            once per node and calculation.
         */
 
         IsdaCdsEngine(Handle<DefaultProbabilityTermStructure> probability,
@@ -106,8 +112,23 @@ namespace QuantLib {
         Handle<DefaultProbabilityTermStructure> isdaCreditCurve() const { return probability_; }
 
         void calculate() const override;
+        void update() override;
+
+        /*! Prices a book of swaps, e.g. the constituents of a CDS
+            index, in a single pass: the curves are evaluated once at
+            their nodes up to the longest maturity and the results are
+            returned in the order of the swaps.  The swaps themselves
+            are not modified.
+        */
+        std::vector<CreditDefaultSwap::results> calculate(
+            const std::vector<ext::shared_ptr<CreditDefaultSwap> >& swaps) const;
 
       private:
+        void checkCurves() const;
+        const std::vector<Date>& nodes() const;
+        void calculateNodeValues(const Date& horizon) const;
+        void price() const;
+
         Handle<DefaultProbabilityTermStructure> probability_;
         const Real recoveryRate_;
         Handle<YieldTermStructure> discountCurve_;
@@ -115,6 +136,14 @@ namespace QuantLib {
         const NumericalFix numericalFix_;
         const AccrualBias accrualBias_;
         const ForwardsInCouponPeriod forwardsInCouponPeriod_;
+
+        mutable std::vector<Date> nodes_;
+        mutable bool nodesCalculated_;
+        // curve values at the first nodeValues_ nodes
+        mutable Size nodeValues_;
+        mutable std::vector<Time> nodeTimes_;
+        mutable std::vector<DiscountFactor> nodeDiscounts_;
+        mutable std::vector<Probability> nodeSurvivals_;
     };
 }
 
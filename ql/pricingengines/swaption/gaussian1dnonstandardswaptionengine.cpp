@@ -200,6 +200,32 @@ namespace QuantLib {
                                  arguments_.floatingResetDates.end(), expiry0 - 1) -
                 arguments_.floatingResetDates.begin();
 
+            // zero bonds and numeraire on the whole state grid, cached
+            // by the model across instruments priced on the same grid
+            std::vector<Array> floatingZerobonds, fixedZerobonds;
+            Array rebateZerobonds, numeraires;
+            if (expiry0 > settlement) {
+                for (Size l = k1; l < arguments_.floatingCoupons.size(); l++) {
+                    floatingZerobonds.push_back(model_->zerobond(
+                        model_->termStructure()->timeFromReference(
+                            arguments_.floatingPayDates[l]),
+                        expiry0Time, z, discountCurve_));
+                }
+                for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
+                    fixedZerobonds.push_back(model_->zerobond(
+                        model_->termStructure()->timeFromReference(
+                            arguments_.fixedPayDates[l]),
+                        expiry0Time, z, discountCurve_));
+                }
+                if (rebatedExercise != nullptr) {
+                    rebateZerobonds = model_->zerobond(
+                        model_->termStructure()->timeFromReference(
+                            rebatedExercise->rebatePaymentDate(idx)),
+                        expiry0Time, z, discountCurve_);
+                }
+                numeraires = model_->numeraire(expiry0Time, z, discountCurve_);
+            }
+
             // todo add openmp support later on (as in gaussian1dswaptionengine)
 
             for (Size k = 0; k < (expiry0 > settlement ? npv0.size() : 1);
@@ -389,10 +415,7 @@ namespace QuantLib {
                                               arguments_.swap->iborIndex()) +
                                       arguments_.floatingSpreads[l]);
                         floatingLegNpv +=
-                            amount *
-                            model_->zerobond(arguments_.floatingPayDates[l],
-                                             expiry0, z[k], discountCurve_) *
-                            zSpreadDf;
+                            amount * floatingZerobonds[l - k1][k] * zSpreadDf;
                     }
                     Real fixedLegNpv = 0.0;
                     for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
@@ -408,16 +431,14 @@ namespace QuantLib {
                                                 arguments_.fixedPayDates[l])));
                         fixedLegNpv +=
                             arguments_.fixedCoupons[l] *
-                            model_->zerobond(arguments_.fixedPayDates[l],
-                                             expiry0, z[k], discountCurve_) *
-                            zSpreadDf;
+                            fixedZerobonds[l - j1][k] * zSpreadDf;
                     }
                     Real rebate = 0.0;
+                    Real rebateZerobond = 0.0;
                     Real zSpreadDf = 1.0;
-                    Date rebateDate = expiry0;
                     if (rebatedExercise != nullptr) {
                         rebate = rebatedExercise->rebate(idx);
-                        rebateDate = rebatedExercise->rebatePaymentDate(idx);
+                        rebateZerobond = rebateZerobonds[k];
                         zSpreadDf =
                             oas_.empty()
                                 ? 1.0
@@ -425,15 +446,16 @@ namespace QuantLib {
                                       -oas_->value() *
                                       (model_->termStructure()
                                            ->dayCounter()
-                                           .yearFraction(expiry0, rebateDate)));
+                                           .yearFraction(
+                                                expiry0,
+                                                rebatedExercise
+                                                    ->rebatePaymentDate(idx))));
                     }
                     Real exerciseValue =
                         ((type == Option::Call ? 1.0 : -1.0) *
                              (floatingLegNpv - fixedLegNpv) +
-                         rebate * model_->zerobond(rebateDate, expiry0, z[k],
-                                                   discountCurve_) *
-                             zSpreadDf) /
-                        model_->numeraire(expiry0Time, z[k], discountCurve_);
+                         rebate * rebateZerobond * zSpreadDf) /
+                        numeraires[k];
 
                     // for probability computation
                     if (probabilities_ != None) {
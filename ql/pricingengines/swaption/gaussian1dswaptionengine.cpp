@@ -20,6 +20,7 @@
 #include <ql/pricingengines/swaption/gaussian1dswaptionengine.hpp>
 #include <ql/math/interpolations/cubicinterpolation.hpp>
 #include <ql/payoff.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -104,16 +105,30 @@ namespace QuantLib {
                     model_->forwardRate(arguments_.floatingFixingDates[l],
                                         expiry0, 0.0,
                                         arguments_.swap->iborIndex());
-                    model_->zerobond(arguments_.floatingPayDates[l], expiry0,
-                                     0.0, discountCurve_);
+                }
+            }
+#endif
+
+            // zero bonds and numeraire on the whole state grid; the
+            // model caches them so that they are shared with other
+            // swaptions priced on the same grid
+            std::vector<Array> floatingZerobonds, fixedZerobonds;
+            Array numeraires;
+            if (expiry0 > settlement) {
+                for (Size l = k1; l < arguments_.floatingCoupons.size(); l++) {
+                    floatingZerobonds.push_back(model_->zerobond(
+                        model_->termStructure()->timeFromReference(
+                            arguments_.floatingPayDates[l]),
+                        expiry0Time, z, discountCurve_));
                 }
                 for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
-                    model_->zerobond(arguments_.fixedPayDates[l], expiry0, 0.0,
-                                     discountCurve_);
+                    fixedZerobonds.push_back(model_->zerobond(
+                        model_->termStructure()->timeFromReference(
+                            arguments_.fixedPayDates[l]),
+                        expiry0Time, z, discountCurve_));
                 }
-                model_->numeraire(expiry0Time, 0.0, discountCurve_);
+                numeraires = model_->numeraire(expiry0Time, z, discountCurve_);
             }
-#endif
 
 #pragma omp parallel for default(shared) firstprivate(p) if(expiry0>settlement)
             for (long k = 0; k < (expiry0 > settlement ? (long)npv0.size() : 1);
@@ -264,20 +279,17 @@ namespace QuantLib {
                              model_->forwardRate(
                                  arguments_.floatingFixingDates[l], expiry0,
                                  z[k], arguments_.swap->iborIndex())) *
-                            model_->zerobond(arguments_.floatingPayDates[l],
-                                             expiry0, z[k], discountCurve_);
+                            floatingZerobonds[l - k1][k];
                     }
                     Real fixedLegNpv = 0.0;
                     for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
                         fixedLegNpv +=
                             arguments_.fixedCoupons[l] *
-                            model_->zerobond(arguments_.fixedPayDates[l],
-                                             expiry0, z[k], discountCurve_);
+                            fixedZerobonds[l - j1][k];
                     }
                     Real exerciseValue =
                         (type == Option::Call ? 1.0 : -1.0) *
-                        (floatingLegNpv - fixedLegNpv) /
-                        model_->numeraire(expiry0Time, z[k], discountCurve_);
+                        (floatingLegNpv - fixedLegNpv) / numeraires[k];
 
                     // for probability computation
                     if (probabilities_ != None) {
@@ -119,6 +119,65 @@ namespace QuantLib {
             const Real v0T2_, logEpsilon_;
             mutable Size evaluations_;
         };
+
+        /* Integrand of P_j in Gatheral's form and its derivatives
+           with respect to theta, kappa, sigma, rho and v0, obtained
+           by differentiating the characteristic function in forward
+           mode.  freq is the log-moneyness term log(F/K). */
+        Real gatheralIntegrandAndGradient(Real phi, Size j,
+                                          Real kappa, Real theta,
+                                          Real sigma, Real rho, Real v0,
+                                          Time term, Real freq,
+                                          Real* gradient) {
+            typedef std::complex<Real> Complex;
+
+            const Real sigma2 = sigma*sigma;
+            const Real c = (j == 1) ? 1.0 : 0.0;
+            const Complex z(phi, (j == 1) ? -1.0 : 1.0);
+
+            const Complex t1(kappa - c*rho*sigma, -rho*sigma*phi);
+            const Complex d = std::sqrt(t1*t1 + sigma2*phi*z);
+            const Complex ex = std::exp(-d*term);
+            const Complex p = (t1-d)/(t1+d);
+            const Complex q = 1.0 - p*ex;
+            const Complex a = (t1-d)*(1.0-ex)/q;
+            const Complex b = (t1-d)*term - 2.0*std::log(q/(1.0-p));
+
+            const Complex e = std::exp(v0*a/sigma2
+                                       + kappa*theta/sigma2*b
+                                       + Complex(0.0, phi*freq));
+
+            // theta and v0 only enter the exponent linearly
+            gradient[0] = (e*(kappa*b/sigma2)).imag()/phi;
+            gradient[4] = (e*(a/sigma2)).imag()/phi;
+
+            // kappa, sigma and rho enter through t1 and d
+            const Complex dt1[] = { Complex(1.0, 0.0),
+                                    Complex(-c*rho, -rho*phi),
+                                    Complex(-c*sigma, -sigma*phi) };
+            for (Size k=1; k<4; ++k) {
+                const Complex& dt = dt1[k-1];
+                const Complex dd2 = 2.0*t1*dt
+                    + ((k == 2) ? Complex(2.0*sigma*phi)*z : Complex(0.0));
+                const Complex dd = dd2/(2.0*d);
+                const Complex dex = -term*ex*dd;
+                const Complex dp = 2.0*(d*dt - t1*dd)/((t1+d)*(t1+d));
+                const Complex dq = -(dp*ex + p*dex);
+                const Complex da =
+                    ((dt-dd)*(1.0-ex) - (t1-d)*dex)/q - a*dq/q;
+                const Complex db = (dt-dd)*term - 2.0*(dq/q + dp/(1.0-p));
+
+                Complex dE = (v0*da + kappa*theta*db)/sigma2;
+                if (k == 1)
+                    dE += theta*b/sigma2;
+                else if (k == 2)
+                    dE -= 2.0*(v0*a + kappa*theta*b)/(sigma2*sigma);
+
+                gradient[k] = (e*dE).imag()/phi;
+            }
+
+            return e.imag()/phi;
+        }
     }
 
     // helper class for integration
@@ -159,6 +218,11 @@ namespace QuantLib {
 
       Real operator()(Real phi) const;
 
+      // strike-independent part of the exponent of the integrand
+      // in Gatheral's form, i.e., the log of the characteristic
+      // function of P_j without the log-moneyness term
+      std::complex<Real> gatheralExponent(Real phi) const;
+
     private:
         const Size j_;
         //     const VanillaOption::arguments& arg_;
@@ -246,8 +310,47 @@ namespace QuantLib {
       engine_(nullptr) {}
 
 
+    std::complex<Real>
+    AnalyticHestonEngine::Fj_Helper::gatheralExponent(Real phi) const {
+        const Real rpsig(rsigma_*phi);
+
+        const std::complex<Real> t1 = t0_+std::complex<Real>(0, -rpsig);
+        const std::complex<Real> d =
+            std::sqrt(t1*t1 - sigma2_*phi
+                      *std::complex<Real>(-phi, (j_== 1)? 1 : -1));
+        const std::complex<Real> ex = std::exp(-d*term_);
+        const std::complex<Real> addOnTerm =
+            engine_ != nullptr ? engine_->addOnTerm(phi, term_, j_) : Real(0.0);
+
+        if (sigma_ > 1e-5) {
+            const std::complex<Real> p = (t1-d)/(t1+d);
+            const std::complex<Real> g
+                                    = std::log((1.0 - p*ex)/(1.0 - p));
+
+            return v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
+                + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
+                + addOnTerm;
+        }
+        else {
+            const std::complex<Real> td = phi/(2.0*t1)
+                           *std::complex<Real>(-phi, (j_== 1)? 1 : -1);
+            const std::complex<Real> p = td*sigma2_/(t1+d);
+            const std::complex<Real> g = p*(1.0-ex);
+
+            return v0_*td*(1.0-ex)/(1.0-p*ex)
+                + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
+                + addOnTerm;
+        }
+    }
+
     Real AnalyticHestonEngine::Fj_Helper::operator()(Real phi) const
     {
+        if (cpxLog_ == Gatheral && phi != 0.0) {
+            return std::exp(gatheralExponent(phi)
+                            + std::complex<Real>(0.0, phi*(dd_-sx_))
+                            ).imag()/phi;
+        }
+
         const Real rpsig(rsigma_*phi);
 
         const std::complex<Real> t1 = t0_+std::complex<Real>(0, -rpsig);
@@ -259,54 +362,25 @@ namespace QuantLib {
             engine_ != nullptr ? engine_->addOnTerm(phi, term_, j_) : Real(0.0);
 
         if (cpxLog_ == Gatheral) {
-            if (phi != 0.0) {
-                if (sigma_ > 1e-5) {
-                    const std::complex<Real> p = (t1-d)/(t1+d);
-                    const std::complex<Real> g
-                                            = std::log((1.0 - p*ex)/(1.0 - p));
-
-                    return
-                        std::exp(v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
-                                 + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
-                }
-                else {
-                    const std::complex<Real> td = phi/(2.0*t1)
-                                   *std::complex<Real>(-phi, (j_== 1)? 1 : -1);
-                    const std::complex<Real> p = td*sigma2_/(t1+d);
-                    const std::complex<Real> g = p*(1.0-ex);
-
-                    return
-                        std::exp(v0_*td*(1.0-ex)/(1.0-p*ex)
-                                 + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
+            // use l'Hospital's rule to get lim_{phi->0}
+            if (j_ == 1) {
+                const Real kmr = rsigma_-kappa_;
+                if (std::fabs(kmr) > 1e-7) {
+                    return dd_-sx_
+                        + (std::exp(kmr*term_)*kappa_*theta_
+                           -kappa_*theta_*(kmr*term_+1.0) ) / (2*kmr*kmr)
+                        - v0_*(1.0-std::exp(kmr*term_)) / (2.0*kmr);
                 }
+                else
+                    // \kappa = \rho * \sigma
+                    return dd_-sx_ + 0.25*kappa_*theta_*term_*term_
+                                   + 0.5*v0_*term_;
             }
             else {
-                // use l'Hospital's rule to get lim_{phi->0}
-                if (j_ == 1) {
-                    const Real kmr = rsigma_-kappa_;
-                    if (std::fabs(kmr) > 1e-7) {
-                        return dd_-sx_
-                            + (std::exp(kmr*term_)*kappa_*theta_
-                               -kappa_*theta_*(kmr*term_+1.0) ) / (2*kmr*kmr)
-                            - v0_*(1.0-std::exp(kmr*term_)) / (2.0*kmr);
-                    }
-                    else
-                        // \kappa = \rho * \sigma
-                        return dd_-sx_ + 0.25*kappa_*theta_*term_*term_
-                                       + 0.5*v0_*term_;
-                }
-                else {
-                    return dd_-sx_
-                        - (std::exp(-kappa_*term_)*kappa_*theta_
-                           +kappa_*theta_*(kappa_*term_-1.0))/(2*kappa_*kappa_)
-                        - v0_*(1.0-std::exp(-kappa_*term_))/(2*kappa_);
-                }
+                return dd_-sx_
+                    - (std::exp(-kappa_*term_)*kappa_*theta_
+                       +kappa_*theta_*(kappa_*term_-1.0))/(2*kappa_*kappa_)
+                    - v0_*(1.0-std::exp(-kappa_*term_))/(2*kappa_);
             }
         }
         else if (cpxLog_ == BranchCorrection) {
@@ -572,6 +646,78 @@ namespace QuantLib {
         return evaluations_;
     }
 
+    bool AnalyticHestonEngine::providesGradient() const {
+        return cpxLog_ == Gatheral
+            && integration_->isGaussianQuadrature()
+            && model_->params().size() == 5
+            && model_->sigma() > 1e-5
+            && !hasAddOnTerm();
+    }
+
+    Real AnalyticHestonEngine::valueAndGradient(
+                                        const PlainVanillaPayoff& payoff,
+                                        const Date& maturity,
+                                        Array& gradient) const {
+        QL_REQUIRE(providesGradient(),
+                   "gradient not available: Gatheral's complex log, "
+                   "Gaussian quadrature and Heston model required");
+
+        const ext::shared_ptr<HestonProcess>& process = model_->process();
+
+        const Real riskFreeDiscount =
+            process->riskFreeRate()->discount(maturity);
+        const Real dividendDiscount =
+            process->dividendYield()->discount(maturity);
+
+        const Real spotPrice = process->s0()->value();
+        QL_REQUIRE(spotPrice > 0.0, "negative or null underlying given");
+
+        const Real strikePrice = payoff.strike();
+        const Real term = process->time(maturity);
+
+        const Real kappa = model_->kappa();
+        const Real theta = model_->theta();
+        const Real sigma = model_->sigma();
+        const Real rho = model_->rho();
+        const Real v0 = model_->v0();
+
+        const Real freq = std::log(spotPrice*dividendDiscount
+                                   /(strikePrice*riskFreeDiscount));
+        const Real c_inf = std::min(0.2, std::max(0.0001,
+                std::sqrt(1.0-rho*rho)/sigma))*(v0 + kappa*theta*term);
+
+        Array u, w;
+        integration_->gaussianQuadratureNodes(c_inf, u, w);
+
+        Real p1 = 0.0, p2 = 0.0;
+        Real dp1[5] = { 0.0, 0.0, 0.0, 0.0, 0.0 };
+        Real dp2[5] = { 0.0, 0.0, 0.0, 0.0, 0.0 };
+        Real g[5];
+        for (Size i=0; i<u.size(); ++i) {
+            if (w[i] == 0.0)
+                continue;
+            p1 += w[i]*gatheralIntegrandAndGradient(
+                u[i], 1, kappa, theta, sigma, rho, v0, term, freq, g);
+            for (Size k=0; k<5; ++k)
+                dp1[k] += w[i]*g[k];
+            p2 += w[i]*gatheralIntegrandAndGradient(
+                u[i], 2, kappa, theta, sigma, rho, v0, term, freq, g);
+            for (Size k=0; k<5; ++k)
+                dp2[k] += w[i]*g[k];
+        }
+        evaluations_ = 2*u.size();
+
+        const Real fwdValue = spotPrice*dividendDiscount/M_PI;
+        const Real strikeValue = strikePrice*riskFreeDiscount/M_PI;
+
+        gradient = Array(5);
+        for (Size k=0; k<5; ++k)
+            gradient[k] = fwdValue*dp1[k] - strikeValue*dp2[k];
+
+        const Real shift = M_PI*(payoff.optionType() == Option::Call ? 0.5 : -0.5);
+        return fwdValue*(p1+shift) - strikeValue*(p2+shift);
+    }
+
     void AnalyticHestonEngine::doCalculation(Real riskFreeDiscount,
                                              Real dividendDiscount,
                                              Real spotPrice,
@@ -668,6 +814,14 @@ namespace QuantLib {
         }
     }
 
+    void AnalyticHestonEngine::update() {
+        chFCache_.clear();
+
+        GenericModelEngine<HestonModel,
+                           VanillaOption::arguments,
+                           VanillaOption::results>::update();
+    }
+
     void AnalyticHestonEngine::calculate() const
     {
         // this is a european option pricer
@@ -679,6 +833,13 @@ namespace QuantLib {
             ext::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
         QL_REQUIRE(payoff, "non plain vanilla payoff given");
 
+        if (cpxLog_ == Gatheral && integration_->isGaussianQuadrature()) {
+            results_.value = values(payoff->optionType(),
+                                    std::vector<Real>(1, payoff->strike()),
+                                    arguments_.exercise->lastDate())[0];
+            return;
+        }
+
         const ext::shared_ptr<HestonProcess>& process = model_->process();
 
         const Real riskFreeDiscount = process->riskFreeRate()->discount(
@@ -711,6 +872,117 @@ namespace QuantLib {
     }
 
 
+    std::vector<Real> AnalyticHestonEngine::values(
+                                        Option::Type type,
+                                        const std::vector<Real>& strikes,
+                                        const Date& maturity) const {
+
+        const ext::shared_ptr<HestonProcess>& process = model_->process();
+
+        const Real riskFreeDiscount =
+            process->riskFreeRate()->discount(maturity);
+        const Real dividendDiscount =
+            process->dividendYield()->discount(maturity);
+
+        const Real spotPrice = process->s0()->value();
+        QL_REQUIRE(spotPrice > 0.0, "negative or null underlying given");
+
+        const Real term = process->time(maturity);
+
+        std::vector<Real> values(strikes.size());
+
+        if (cpxLog_ != Gatheral || !integration_->isGaussianQuadrature()) {
+            evaluations_ = 0;
+            for (Size i=0; i<strikes.size(); ++i) {
+                Size evaluations;
+                doCalculation(riskFreeDiscount, dividendDiscount,
+                              spotPrice, strikes[i], term,
+                              model_->kappa(), model_->theta(),
+                              model_->sigma(), model_->v0(), model_->rho(),
+                              PlainVanillaPayoff(type, strikes[i]),
+                              *integration_, cpxLog_, this,
+                              values[i], evaluations);
+                evaluations_ += evaluations;
+            }
+            return values;
+        }
+
+        const ChFValues& chf = chFValues(term);
+        const Real fwdPrice = spotPrice*dividendDiscount/riskFreeDiscount;
+
+        for (Size i=0; i<strikes.size(); ++i) {
+            const Real freq = std::log(fwdPrice/strikes[i]);
+
+            Real p1 = 0.0, p2 = 0.0;
+            for (Size n=0; n<chf.u.size(); ++n) {
+                const std::complex<Real> e = std::polar(1.0, chf.u[n]*freq);
+                p1 += (chf.a1[n]*e).imag();
+                p2 += (chf.a2[n]*e).imag();
+            }
+            p1 /= M_PI;
+            p2 /= M_PI;
+
+            switch (type) {
+              case Option::Call:
+                values[i] = spotPrice*dividendDiscount*(p1+0.5)
+                    - strikes[i]*riskFreeDiscount*(p2+0.5);
+                break;
+              case Option::Put:
+                values[i] = spotPrice*dividendDiscount*(p1-0.5)
+                    - strikes[i]*riskFreeDiscount*(p2-0.5);
+                break;
+              default:
+                QL_FAIL("unknown option type");
+            }
+        }
+
+        return values;
+    }
+
+    const AnalyticHestonEngine::ChFValues&
+    AnalyticHestonEngine::chFValues(Time term) const {
+
+        std::map<Time, ChFValues>::const_iterator cached =
+            chFCache_.find(term);
+        if (cached != chFCache_.end()) {
+            evaluations_ = 0;
+            return cached->second;
+        }
+
+        const Real kappa = model_->kappa();
+        const Real theta = model_->theta();
+        const Real sigma = model_->sigma();
+        const Real rho = model_->rho();
+        const Real v0 = model_->v0();
+
+        const Real c_inf = std::min(0.2, std::max(0.0001,
+            std::sqrt(1.0-rho*rho)/sigma))*(v0 + kappa*theta*term);
+
+        Array u, w;
+        integration_->gaussianQuadratureNodes(c_inf, u, w);
+
+        // spot, strike and ratio only enter the log-moneyness term
+        const Fj_Helper f1(kappa, theta, sigma, v0, 1.0, rho, this,
+                           Gatheral, term, 1.0, 1.0, 1);
+        const Fj_Helper f2(kappa, theta, sigma, v0, 1.0, rho, this,
+                           Gatheral, term, 1.0, 1.0, 2);
+
+        ChFValues& values = chFCache_[term];
+        values.u.reserve(u.size());
+        values.a1.reserve(u.size());
+        values.a2.reserve(u.size());
+        for (Size i=0; i<u.size(); ++i) {
+            if (w[i] == 0.0)
+                continue;
+            values.u.push_back(u[i]);
+            values.a1.push_back(w[i]/u[i]*std::exp(f1.gatheralExponent(u[i])));
+            values.a2.push_back(w[i]/u[i]*std::exp(f2.gatheralExponent(u[i])));
+        }
+        evaluations_ = 2*u.size();
+
+        return values;
+    }
+
     AnalyticHestonEngine::Integration::Integration(Algorithm intAlgo,
                                                    ext::shared_ptr<Integrator> integrator)
     : intAlgo_(intAlgo), integrator_(std::move(integrator)) {}
@@ -818,6 +1090,34 @@ namespace QuantLib {
             || intAlgo_ == Trapezoid;
     }
 
+    bool AnalyticHestonEngine::Integration::isGaussianQuadrature() const {
+        return gaussianQuadrature_ != nullptr;
+    }
+
+    void AnalyticHestonEngine::Integration::gaussianQuadratureNodes(
+        Real c_inf, Array& u, Array& w) const {
+        QL_REQUIRE(isGaussianQuadrature(), "Gaussian quadrature required");
+
+        const Array& x = gaussianQuadrature_->x();
+        const Array& weights = gaussianQuadrature_->weights();
+
+        u = Array(x.size(), 0.0);
+        w = Array(x.size(), 0.0);
+        for (Size i=0; i<x.size(); ++i) {
+            if (intAlgo_ == GaussLaguerre) {
+                u[i] = x[i];
+                w[i] = weights[i];
+            } else {
+                // same change of variable as in integrand1
+                const Real s = (1.0-x[i])*c_inf;
+                if (s > QL_EPSILON) {
+                    u[i] = -std::log(0.5-0.5*x[i])/c_inf;
+                    w[i] = weights[i]/s;
+                }
+            }
+        }
+    }
+
     Real AnalyticHestonEngine::Integration::calculate(
         Real c_inf,
         const ext::function<Real(Real)>& f,
@@ -31,8 +31,11 @@
 #include <ql/pricingengines/genericmodelengine.hpp>
 #include <ql/models/equity/hestonmodel.hpp>
 #include <ql/instruments/vanillaoption.hpp>
+#include <ql/instruments/payoffs.hpp>
 #include <ql/functional.hpp>
 #include <complex>
+#include <map>
+#include <vector>
 
 namespace QuantLib {
 
@@ -129,9 +132,51 @@ namespace QuantLib {
         std::complex<Real> chF(const std::complex<Real>& z, Time t) const;
         std::complex<Real> lnChF(const std::complex<Real>& z, Time t) const;
 
+        void update() override;
         void calculate() const override;
         Size numberOfEvaluations() const;
 
+        //! values of European options with common maturity
+        /*! With Gatheral's form of the complex logarithm and a
+            Gaussian quadrature, the characteristic function is
+            evaluated only once per quadrature node and maturity and
+            cached until the model changes; each strike then only
+            costs the strike-dependent phase factor.  The cache is
+            also used by calculate(), so that options sharing the
+            engine and the expiry are priced in a single pass over
+            the nodes.  Otherwise, one integration per strike is
+            performed.
+
+            \warning for engines whose add-on term is updated in
+                     calculate(), such as the Heston Hull-White one,
+                     this method should only be called after pricing
+                     an option with the same maturity.
+        */
+        std::vector<Real> values(Option::Type type,
+                                 const std::vector<Real>& strikes,
+                                 const Date& maturity) const;
+
+        //! value of a European option and its model-parameter gradient
+        /*! Returns the value of the option with the given payoff and
+            maturity and fills \c gradient with its derivatives with
+            respect to the model parameters, in the order given by
+            HestonModel::params() (i.e., theta, kappa, sigma, rho and
+            v0).  The derivatives of the characteristic function are
+            integrated at the same quadrature nodes as the price, at a
+            fraction of the cost of bumping each parameter.
+
+            \pre providesGradient() must return true.
+        */
+        Real valueAndGradient(const PlainVanillaPayoff& payoff,
+                              const Date& maturity,
+                              Array& gradient) const;
+        /*! returns whether valueAndGradient() is available for the
+            current engine settings and model parameters; this
+            requires Gatheral's form of the complex logarithm, a
+            Gaussian quadrature and a pure Heston model.
+        */
+        bool providesGradient() const;
+
         static void doCalculation(Real riskFreeDiscount,
                                   Real dividendDiscount,
                                   Real spotPrice,
@@ -178,14 +223,25 @@ namespace QuantLib {
         virtual std::complex<Real> addOnTerm(Real phi,
                                              Time t,
                                              Size j) const;
+        //! whether addOnTerm() is overridden with a non-null term
+        virtual bool hasAddOnTerm() const;
 
       private:
         class Fj_Helper;
 
+        // quadrature nodes and weighted characteristic-function
+        // values for P_1 and P_2, divided by the node
+        struct ChFValues {
+            std::vector<Real> u;
+            std::vector<std::complex<Real> > a1, a2;
+        };
+        const ChFValues& chFValues(Time term) const;
+
         mutable Size evaluations_;
         const ComplexLogFormula cpxLog_;
         const ext::shared_ptr<Integration> integration_;
         const Real andersenPiterbargEpsilon_;
+        mutable std::map<Time, ChFValues> chFCache_;
     };
 
 
@@ -227,6 +283,12 @@ namespace QuantLib {
 
         Size numberOfEvaluations() const;
         bool isAdaptiveIntegration() const;
+        bool isGaussianQuadrature() const;
+
+        // nodes u_i and weights w_i of the Gaussian quadrature such
+        // that the integral of f over [0, inf) is approximated by
+        // sum_i w_i f(u_i); nodes with null weight are to be skipped
+        void gaussianQuadratureNodes(Real c_inf, Array& u, Array& w) const;
 
       private:
         enum Algorithm
@@ -252,6 +314,10 @@ namespace QuantLib {
                                                        Size) const {
         return std::complex<Real>(0,0);
     }
+
+    inline bool AnalyticHestonEngine::hasAddOnTerm() const {
+        return false;
+    }
 }
 
 #endif
@@ -80,6 +80,7 @@ namespace QuantLib {
 
       protected:
         std::complex<Real> addOnTerm(Real phi, Time t, Size j) const override;
+        bool hasAddOnTerm() const override;
 
         const ext::shared_ptr<HullWhite> hullWhiteModel_;
 
@@ -88,6 +89,10 @@ namespace QuantLib {
         mutable Real a_, sigma_;
     };
 
+    inline bool AnalyticHestonHullWhiteEngine::hasAddOnTerm() const {
+        return true;
+    }
+
     inline
     std::complex<Real> AnalyticHestonHullWhiteEngine::addOnTerm(Real u,
                                                                 Time,
@@ -31,21 +31,33 @@ namespace QuantLib {
                              Real relTolerance, Size maxEvaluations)
     : AnalyticHestonEngine(model, relTolerance, maxEvaluations) { }
 
+    bool BatesEngine::hasAddOnTerm() const {
+        return true;
+    }
+
     std::complex<Real> BatesEngine::addOnTerm(
                                             Real phi, Time t, Size j) const {
         
         ext::shared_ptr<BatesModel> batesModel =
                             ext::dynamic_pointer_cast<BatesModel>(*model_);
 
-        const Real nu_     = batesModel->nu();
-        const Real delta2_ = 0.5*batesModel->delta()*batesModel->delta();
-        const Real lambda_ = batesModel->lambda();
-        const Real i       = (j == 1)? 1.0 : 0.0;
+        const Real i = (j == 1)? 1.0 : 0.0;
         const std::complex<Real> g(i, phi);
 
+        return jumpTerm(g, t, batesModel->lambda(),
+                        batesModel->nu(), batesModel->delta());
+    }
+
+    std::complex<Real> BatesEngine::jumpTerm(const std::complex<Real>& g,
+                                             Time t,
+                                             Real lambda,
+                                             Real nu,
+                                             Real delta) {
+        const Real delta2 = 0.5*delta*delta;
+
         //it can throw: to be fixed
-        return t*lambda_*(std::exp(nu_*g + delta2_*g*g) - 1.0
-                          -g*(std::exp(nu_+delta2_) - 1.0));
+        return t*lambda*(std::exp(nu*g + delta2*g*g) - 1.0
+                         -g*(std::exp(nu+delta2) - 1.0));
     }
 
 
@@ -88,6 +100,10 @@ namespace QuantLib {
         Real relTolerance, Size maxEvaluations)
     : AnalyticHestonEngine(model, relTolerance, maxEvaluations) { }
 
+    bool BatesDoubleExpEngine::hasAddOnTerm() const {
+        return true;
+    }
+
     std::complex<Real> BatesDoubleExpEngine::addOnTerm(
         Real phi, Time t, Size j) const {
         ext::shared_ptr<BatesDoubleExpModel> batesDoubleExpModel =
@@ -110,8 +110,20 @@ namespace QuantLib {
         BatesEngine(const ext::shared_ptr<BatesModel>& model,
                     Real relTolerance, Size maxEvaluations);
 
+        //! log of the characteristic function of the jumps
+        /*! compensated compound Poisson process with intensity lambda
+            and normal log-jumps with mean nu and volatility delta,
+            evaluated at \f$ g = iu \f$ for the transform variable u.
+        */
+        static std::complex<Real> jumpTerm(const std::complex<Real>& g,
+                                           Time t,
+                                           Real lambda,
+                                           Real nu,
+                                           Real delta);
+
       protected:
         std::complex<Real> addOnTerm(Real phi, Time t, Size j) const override;
+        bool hasAddOnTerm() const override;
     };
 
 
@@ -138,6 +150,7 @@ namespace QuantLib {
 
       protected:
         std::complex<Real> addOnTerm(Real phi, Time t, Size j) const override;
+        bool hasAddOnTerm() const override;
     };
 
 
@@ -42,6 +42,8 @@ namespace QuantLib {
         rho_   = model_->rho();
         v0_    = model_->v0();
 
+        chFCache_.clear();
+
         GenericModelEngine<HestonModel,
                            VanillaOption::arguments,
                            VanillaOption::results>::update();
@@ -59,9 +61,18 @@ namespace QuantLib {
             ext::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
         QL_REQUIRE(payoff, "non plain vanilla payoff given");
 
+        results_.value = values(payoff->optionType(),
+                                std::vector<Real>(1, payoff->strike()),
+                                arguments_.exercise->lastDate())[0];
+    }
+
+    std::vector<Real> COSHestonEngine::values(
+                                        Option::Type type,
+                                        const std::vector<Real>& strikes,
+                                        const Date& maturityDate) const {
+
         const ext::shared_ptr<HestonProcess> process = model_->process();
 
-        const Date maturityDate = arguments_.exercise->lastDate();
         const Time maturity = process->time(maturityDate);
 
         const Real cum1 = c1(maturity);
@@ -70,7 +81,6 @@ namespace QuantLib {
             // + std::sqrt(std::fabs(c4(maturity)))
         );
 
-        const Real k = payoff->strike();
         const Real spot = process->s0()->value();
         QL_REQUIRE(spot > 0.0, "negative or null underlying given");
 
@@ -79,34 +89,56 @@ namespace QuantLib {
         const DiscountFactor qf
             = process->dividendYield()->discount(maturityDate);
         const Real fwd = spot*qf/df;
-        const Real x = std::log(fwd/k);
-
-        const Real a = x + cum1 - L_*w;
-        const Real b = x + cum1 + L_*w;
 
-        const Real d = 1.0/(b-a);
-
-        const Real expA = std::exp(a);
-        Real s = chF(0, maturity).real()*(expA-1-a)*d;
-
-        for (Size n=1; n < N_; ++n) {
-            const Real r = n*M_PI*d;
-            const Real U_n = 2.0*d*( 1.0/(1.0 + r*r)
-                *(expA + r*std::sin(r*a) - std::cos(r*a)) - 1.0/r*std::sin(r*a));
-
-            s += U_n*(chF(r, maturity)
-                     *std::exp(std::complex<Real>(0, r*(x-a)))).real();
+        // the width of the truncation range and thus the frequencies
+        // r_n and the phases r_n*(x-a) don't depend on the strike, so
+        // that the characteristic function is evaluated once per
+        // maturity and then reused for all strikes.
+        const Real d = 1.0/(2.0*L_*w);
+        const std::vector<std::complex<Real> >& phi =
+            chFValues(maturity, d, L_*w - cum1);
+
+        std::vector<Real> values(strikes.size());
+        for (Size i=0; i < strikes.size(); ++i) {
+            const Real k = strikes[i];
+            const Real x = std::log(fwd/k);
+
+            const Real a = x + cum1 - L_*w;
+
+            const Real expA = std::exp(a);
+            Real s = phi[0].real()*(expA-1-a)*d;
+
+            for (Size n=1; n < N_; ++n) {
+                const Real r = n*M_PI*d;
+                const Real U_n = 2.0*d*( 1.0/(1.0 + r*r)
+                    *(expA + r*std::sin(r*a) - std::cos(r*a)) - 1.0/r*std::sin(r*a));
+
+                s += U_n*phi[n].real();
+            }
+
+            if (type == Option::Put)
+                values[i] = k*df*s;
+            else if (type == Option::Call)
+                values[i] = spot*qf - k*df*(1-s);
+            else
+                QL_FAIL("unknown payoff type");
         }
 
-        if (payoff->optionType() == Option::Put)
-            results_.value = k*df*s;
-        else if (payoff->optionType() == Option::Call) {
-            const DiscountFactor qf
-                = process->dividendYield()->discount(maturityDate);
-            results_.value = spot*qf - k*df*(1-s);
+        return values;
+    }
+
+    const std::vector<std::complex<Real> >& COSHestonEngine::chFValues(
+                                        Time t, Real d, Real xMinusA) const {
+        std::vector<std::complex<Real> >& phi = chFCache_[t];
+        if (phi.empty()) {
+            phi.resize(N_);
+            phi[0] = chF(0, t);
+            for (Size n=1; n < N_; ++n) {
+                const Real r = n*M_PI*d;
+                phi[n] = chF(r, t)*std::exp(std::complex<Real>(0, r*xMinusA));
+            }
         }
-        else
-            QL_FAIL("unknown payoff type");
+        return phi;
     }
 
     Real COSHestonEngine::muT(Time t) const {
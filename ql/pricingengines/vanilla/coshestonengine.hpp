@@ -29,6 +29,8 @@
 #include <ql/pricingengines/genericmodelengine.hpp>
 
 #include <complex>
+#include <map>
+#include <vector>
 
 namespace QuantLib {
 
@@ -61,6 +63,16 @@ namespace QuantLib {
         void update() override;
         void calculate() const override;
 
+        //! values of European options with common maturity
+        /*! The characteristic function doesn't depend on the strike
+            and is evaluated only once per maturity; the results are
+            cached until the model changes, so that options sharing
+            the engine and the expiry also reuse them in calculate().
+        */
+        std::vector<Real> values(Option::Type type,
+                                 const std::vector<Real>& strikes,
+                                 const Date& maturity) const;
+
         // normalized characteristic function
         std::complex<Real> chF(Real u, Real t) const;
 
@@ -76,10 +88,13 @@ namespace QuantLib {
 
       private:
         Real muT(Time t) const;
+        const std::vector<std::complex<Real> >& chFValues(
+                                        Time t, Real d, Real xMinusA) const;
 
         const Real L_;
         const Size N_;
         Real kappa_, theta_, sigma_, rho_, v0_;
+        mutable std::map<Time, std::vector<std::complex<Real> > > chFCache_;
     };
 }
 
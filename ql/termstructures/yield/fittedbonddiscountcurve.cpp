@@ -26,6 +26,8 @@
 #include <ql/termstructures/yield/fittedbonddiscountcurve.hpp>
 #include <ql/time/daycounters/simpledaycounter.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <algorithm>
+#include <numeric>
 #include <utility>
 
 using std::vector;
@@ -40,8 +42,15 @@ namespace QuantLib {
                        FittedBondDiscountCurve::FittingMethod* fittingMethod);
         Real value(const Array& x) const override;
         Disposable<Array> values(const Array& x) const override;
+        void gradient(Array& grad, const Array& x) const override;
+        Real valueAndGradient(Array& grad, const Array& x) const override;
+        void jacobian(Matrix& jac, const Array& x) const override;
+        Disposable<Array> valuesAndJacobian(Matrix& jac,
+                                            const Array& x) const override;
 
       private:
+        // model prices of the bonds and, if required, their gradients
+        void prices(const Array& x, Array& prices, Matrix* gradients) const;
         FittedBondDiscountCurve::FittingMethod* fittingMethod_;
     };
 
@@ -169,6 +178,68 @@ namespace QuantLib {
         QL_REQUIRE(weights_.size() == n,
                    "Given weights do not cover all boostrapping helpers");
 
+        // collect the cash flows contributing to the bond prices, as in
+        // the DiscountingBondEngine used by the helpers, so that the
+        // cost function needs only the discount factors at their dates
+        std::vector<Time> cashFlowTimes, settlementTimes;
+        firstCashFlow_.resize(n+1);
+        cashFlowAmounts_.clear();
+        accruedAmounts_.resize(n);
+        marketPrices_.resize(n);
+        for (Size i=0; i<n; ++i) {
+            const ext::shared_ptr<BondHelper>& helper = curve_->bondHelpers_[i];
+            ext::shared_ptr<Bond> bond = helper->bond();
+            Date bondSettlement = bond->settlementDate();
+            Real notional = bond->notional(bondSettlement);
+            Real scale = notional == 0.0 ? 0.0 : 100.0/notional;
+
+            firstCashFlow_[i] = cashFlowAmounts_.size();
+            for (auto& cf : bond->cashflows()) {
+                // same flows as the settlement value of the bond engine,
+                // which excludes the ones paid on the settlement date
+                // regardless of includeReferenceDateEvents
+                if (!cf->hasOccurred(bondSettlement, false) &&
+                    !cf->tradingExCoupon(bondSettlement)) {
+                    cashFlowTimes.push_back(
+                                    curve_->timeFromReference(cf->date()));
+                    cashFlowAmounts_.push_back(cf->amount() * scale);
+                }
+            }
+            settlementTimes.push_back(
+                                curve_->timeFromReference(bondSettlement));
+
+            switch (helper->priceType()) {
+              case Bond::Price::Clean:
+                accruedAmounts_[i] = notional == 0.0 ? 0.0 :
+                    bond->accruedAmount(bondSettlement);
+                break;
+              case Bond::Price::Dirty:
+                accruedAmounts_[i] = 0.0;
+                break;
+              default:
+                QL_FAIL("This price type isn't implemented.");
+            }
+            marketPrices_[i] = helper->quote()->value();
+        }
+        firstCashFlow_[n] = cashFlowAmounts_.size();
+
+        times_ = cashFlowTimes;
+        times_.insert(times_.end(),
+                      settlementTimes.begin(), settlementTimes.end());
+        std::sort(times_.begin(), times_.end());
+        times_.erase(std::unique(times_.begin(), times_.end()), times_.end());
+
+        cashFlowTimes_.resize(cashFlowTimes.size());
+        for (Size j=0; j<cashFlowTimes.size(); ++j)
+            cashFlowTimes_[j] =
+                std::lower_bound(times_.begin(), times_.end(),
+                                 cashFlowTimes[j]) - times_.begin();
+        settlementTimes_.resize(n);
+        for (Size i=0; i<n; ++i)
+            settlementTimes_[i] =
+                std::lower_bound(times_.begin(), times_.end(),
+                                 settlementTimes[i]) - times_.begin();
+
         if (!l2_.empty()) {
             QL_REQUIRE(l2_.size() == size(),
                        "Given penalty factors do not cover all parameters");
@@ -233,11 +304,81 @@ namespace QuantLib {
     }
 
 
+    const CostFunction&
+    FittedBondDiscountCurve::FittingMethod::costFunction() const {
+        QL_REQUIRE(costFunction_, "cost function not initialized");
+        return *costFunction_;
+    }
+
+
     FittedBondDiscountCurve::FittingMethod::FittingCost::FittingCost(
                         FittedBondDiscountCurve::FittingMethod* fittingMethod)
     : fittingMethod_(fittingMethod) {}
 
 
+    void FittedBondDiscountCurve::FittingMethod::discountFunctionGradient(
+                                             const Array&, Time, Array&) const {
+        QL_FAIL("discount function gradient not implemented");
+    }
+
+
+    void FittedBondDiscountCurve::FittingMethod::FittingCost::prices(
+                                                const Array& x,
+                                                Array& prices,
+                                                Matrix* gradients) const {
+        const FittingMethod& method = *fittingMethod_;
+        const std::vector<Time>& times = method.times_;
+        Size n = method.marketPrices_.size();
+        long m = times.size();
+        Size k = x.size();
+
+        // discount factors (and their gradients) at the distinct dates.
+        // The first one is calculated outside the parallel loop so that
+        // any lazy calculation in the fitting method is triggered once.
+        Array discounts(m);
+        Matrix discountGradients(gradients != nullptr ? m : 0, k);
+        discounts[0] = method.discount(x, times[0]);
+        #pragma omp parallel for
+        for (long j=1; j<m; ++j)
+            discounts[j] = method.discount(x, times[j]);
+        if (gradients != nullptr) {
+            #pragma omp parallel for
+            for (long j=0; j<m; ++j) {
+                Array g(k);
+                method.discountGradient(x, times[j], g);
+                std::copy(g.begin(), g.end(), discountGradients.row_begin(j));
+            }
+        }
+
+        #pragma omp parallel for
+        for (long i=0; i<(long)n; ++i) {
+            Real value = 0.0;
+            for (Size j=method.firstCashFlow_[i];
+                 j<method.firstCashFlow_[i+1]; ++j)
+                value += method.cashFlowAmounts_[j] *
+                    discounts[method.cashFlowTimes_[j]];
+            Size s = method.settlementTimes_[i];
+            prices[i] = value/discounts[s] - method.accruedAmounts_[i];
+
+            if (gradients != nullptr) {
+                // d(V/D) = (dV - (V/D) dD) / D
+                Matrix::row_iterator g = gradients->row_begin(i);
+                std::fill(g, gradients->row_end(i), 0.0);
+                for (Size j=method.firstCashFlow_[i];
+                     j<method.firstCashFlow_[i+1]; ++j) {
+                    Real a = method.cashFlowAmounts_[j];
+                    Size t = method.cashFlowTimes_[j];
+                    for (Size l=0; l<k; ++l)
+                        g[l] += a * discountGradients[t][l];
+                }
+                Real v = value/discounts[s];
+                for (Size l=0; l<k; ++l)
+                    g[l] = (g[l] - v * discountGradients[s][l]) / discounts[s];
+            }
+        }
+    }
+
+
     Real FittedBondDiscountCurve::FittingMethod::FittingCost::value(
                                                        const Array& x) const {
         Real squaredError = 0.0;
@@ -258,10 +399,12 @@ namespace QuantLib {
         // the final solution will be set in FittingMethod::calculate() later on
         fittingMethod_->solution_ = x;
 
+        Array modelPrices(n);
+        prices(x, modelPrices, nullptr);
+
         Array values(n + N);
         for (Size i=0; i<n; ++i) {
-            ext::shared_ptr<BondHelper> helper = fittingMethod_->curve_->bondHelpers_[i];
-            Real error = helper->impliedQuote() - helper->quote()->value();
+            Real error = modelPrices[i] - fittingMethod_->marketPrices_[i];
             Real weightedError = fittingMethod_->weights_[i] * error;
             values[i] = weightedError * weightedError;
         }
@@ -275,4 +418,63 @@ namespace QuantLib {
         return values;
     }
 
+    void FittedBondDiscountCurve::FittingMethod::FittingCost::gradient(
+                                          Array& grad, const Array& x) const {
+        valueAndGradient(grad, x);
+    }
+
+    Real FittedBondDiscountCurve::FittingMethod::FittingCost::valueAndGradient(
+                                          Array& grad, const Array& x) const {
+        if (!fittingMethod_->providesDiscountGradient())
+            return CostFunction::valueAndGradient(grad, x);
+
+        Size n = fittingMethod_->curve_->bondHelpers_.size();
+        Matrix jac(n + fittingMethod_->l2_.size(), x.size());
+        Array vals = valuesAndJacobian(jac, x);
+        std::fill(grad.begin(), grad.end(), 0.0);
+        for (Size i=0; i<jac.rows(); ++i)
+            for (Size l=0; l<x.size(); ++l)
+                grad[l] += jac[i][l];
+        return std::accumulate(vals.begin(), vals.end(), Real(0.0));
+    }
+
+    void FittedBondDiscountCurve::FittingMethod::FittingCost::jacobian(
+                                          Matrix& jac, const Array& x) const {
+        valuesAndJacobian(jac, x);
+    }
+
+    Disposable<Array>
+    FittedBondDiscountCurve::FittingMethod::FittingCost::valuesAndJacobian(
+                                          Matrix& jac, const Array& x) const {
+        if (!fittingMethod_->providesDiscountGradient())
+            return CostFunction::valuesAndJacobian(jac, x);
+
+        Size n = fittingMethod_->curve_->bondHelpers_.size();
+        Size N = fittingMethod_->l2_.size();
+        Size k = x.size();
+
+        fittingMethod_->solution_ = x;
+
+        Array modelPrices(n);
+        Matrix priceGradients(n, k);
+        prices(x, modelPrices, &priceGradients);
+
+        Array values(n + N);
+        for (Size i=0; i<n; ++i) {
+            Real w = fittingMethod_->weights_[i];
+            Real error = modelPrices[i] - fittingMethod_->marketPrices_[i];
+            values[i] = w * w * error * error;
+            for (Size l=0; l<k; ++l)
+                jac[i][l] = 2.0 * w * w * error * priceGradients[i][l];
+        }
+        for (Size i=0; i<N; ++i) {
+            Real error = x[i] - fittingMethod_->curve_->guessSolution_[i];
+            values[i + n] = fittingMethod_->l2_[i] * error * error;
+            for (Size l=0; l<k; ++l)
+                jac[i + n][l] = 0.0;
+            jac[i + n][i] = 2.0 * fittingMethod_->l2_[i] * error;
+        }
+        return values;
+    }
+
 }
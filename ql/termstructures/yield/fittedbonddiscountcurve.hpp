@@ -27,6 +27,7 @@
 #define quantlib_fitted_bond_discount_curve_hpp
 
 #include <ql/termstructures/yield/bondhelpers.hpp>
+#include <ql/math/optimization/costfunction.hpp>
 #include <ql/math/optimization/method.hpp>
 #include <ql/patterns/lazyobject.hpp>
 #include <ql/math/array.hpp>
@@ -48,6 +49,21 @@ namespace QuantLib {
         implementation details. Developers thus need only derive new
         fitting methods from the latter.
 
+        The cash flows of the bonds are collected once per
+        calculation, so that the cost function evaluations during the
+        optimization only require discount factors at the (distinct)
+        cash-flow dates.  The curve observes the cash flows, so that
+        a change in their amounts (e.g., of floating-rate coupons
+        whose forecast curve moved) triggers a new collection and
+        fit; however, the amounts are kept constant during a fit,
+        so that coupons forecast on the fitted curve itself are not
+        supported.  If the fitting method provides the gradient
+        of its discount function with respect to its parameters, the
+        gradient and Jacobian of the cost function are calculated
+        analytically, which makes gradient-based optimizers such as
+        BFGS or Levenberg-Marquardt much cheaper to use.  The last
+        solution is used as starting point for the next fit.
+
         \warning The method can be slow if there are many bonds to
                  fit. Speed also depends on the particular choice of
                  fitting method chosen and its convergence properties
@@ -208,8 +224,20 @@ namespace QuantLib {
         Array l2() const;
         //! return optimization method being used
         ext::shared_ptr<OptimizationMethod> optimizationMethod() const;
+        //! cost function minimized by the fit
+        /*! It's available once the curve is calculated.
+
+            \warning evaluating it changes the parameters used by
+                     the curve until the next fit.
+        */
+        const CostFunction& costFunction() const;
         //! open discountFunction to public
         DiscountFactor discount(const Array& x, Time t) const;
+        //! whether the gradient of the discount function is available
+        virtual bool providesDiscountGradient() const { return false; }
+        //! open discountFunctionGradient to public
+        /*! \pre gradient must have size() elements */
+        void discountGradient(const Array& x, Time t, Array& gradient) const;
       protected:
         //! constructors
         FittingMethod(bool constrainAtZero = true,
@@ -224,6 +252,13 @@ namespace QuantLib {
         //! discount function called by FittedBondDiscountCurve
         virtual DiscountFactor discountFunction(const Array& x,
                                                 Time t) const = 0;
+        //! gradient of the discount function with respect to the parameters
+        /*! Derived classes overriding this method must also override
+            providesDiscountGradient() so that it returns \c true.
+        */
+        virtual void discountFunctionGradient(const Array& x,
+                                              Time t,
+                                              Array& gradient) const;
 
         //! constrains discount function to unity at \f$ T=0 \f$, if true
         bool constrainAtZero_;
@@ -258,6 +293,15 @@ namespace QuantLib {
         ext::shared_ptr<OptimizationMethod> optimizationMethod_;
         // flat extrapolation of instantaneous forward before / after cutoff
         Real minCutoffTime_, maxCutoffTime_;
+        // bond data collected in init() and used by the cost function:
+        // distinct cash-flow and settlement times,
+        std::vector<Time> times_;
+        // the cash flows of the i-th bond, scaled to a price, are the
+        // ones from firstCashFlow_[i] to firstCashFlow_[i+1]
+        std::vector<Size> firstCashFlow_, cashFlowTimes_;
+        std::vector<Real> cashFlowAmounts_;
+        std::vector<Size> settlementTimes_;
+        std::vector<Real> accruedAmounts_, marketPrices_;
     };
 
     // inline
@@ -283,8 +327,13 @@ namespace QuantLib {
     }
 
     inline void FittedBondDiscountCurve::setup() {
-        for (auto& bondHelper : bondHelpers_)
+        for (auto& bondHelper : bondHelpers_) {
             registerWith(bondHelper);
+            // the cash-flow amounts collected by the fitting method
+            // must be refreshed when, e.g., floating coupons change
+            for (auto& cf : bondHelper->bond()->cashflows())
+                registerWith(cf);
+        }
     }
 
     inline DiscountFactor FittedBondDiscountCurve::discountImpl(Time t) const {
@@ -342,6 +391,33 @@ namespace QuantLib {
             return discountFunction(x, t);
         }
     }
+
+    inline void FittedBondDiscountCurve::FittingMethod::discountGradient(
+                             const Array& x, Time t, Array& gradient) const {
+        if (t < minCutoffTime_) {
+            // d(t) = d(t_min)^(t/t_min)
+            DiscountFactor d = discountFunction(x, minCutoffTime_);
+            discountFunctionGradient(x, minCutoffTime_, gradient);
+            Real factor = std::exp(std::log(d) / minCutoffTime_ * t)
+                * t / minCutoffTime_ / d;
+            gradient *= factor;
+        } else if (t > maxCutoffTime_) {
+            const Real h = 1E-4;
+            DiscountFactor d1 = discountFunction(x, maxCutoffTime_);
+            DiscountFactor d2 = discountFunction(x, maxCutoffTime_ + h);
+            DiscountFactor d = d1 * std::exp((std::log(d2) - std::log(d1)) *
+                                             1E4 * (t - maxCutoffTime_));
+            Array g2(gradient.size());
+            discountFunctionGradient(x, maxCutoffTime_, gradient);
+            discountFunctionGradient(x, maxCutoffTime_ + h, g2);
+            Real w = 1E4 * (t - maxCutoffTime_);
+            for (Size i=0; i<gradient.size(); ++i)
+                gradient[i] = d * ((1.0 - w) * gradient[i] / d1 +
+                                   w * g2[i] / d2);
+        } else {
+            discountFunctionGradient(x, t, gradient);
+        }
+    }
 }
 
 #endif
@@ -102,6 +102,35 @@ namespace QuantLib {
         return d;
     }
 
+    void ExponentialSplinesFitting::discountFunctionGradient(const Array& x,
+                                                             Time t,
+                                                             Array& gradient) const {
+        Size N = size();
+        bool fixedKappa = (fixedKappa_ != Null<Real>());
+        Real kappa = fixedKappa ? fixedKappa_ : x[N-1];
+        Real dKappa = 0.0;
+
+        if (!constrainAtZero_) {
+            for (Size i = 0; i < N - 1; ++i) {
+                Real e = std::exp(-kappa * (i + 1) * t);
+                gradient[i] = e;
+                dKappa -= x[i] * (i + 1) * t * e;
+            }
+        } else {
+            Real e1 = std::exp(-kappa * t);
+            Real coeff = 1.0;
+            for (Size i = 0; i < N - 1; i++) {
+                Real e = std::exp(-kappa * (i + 2) * t);
+                gradient[i] = e - e1;
+                dKappa -= x[i] * (i + 2) * t * e;
+                coeff -= x[i];
+            }
+            dKappa -= coeff * t * e1;
+        }
+        // if kappa is fixed, the last parameter is not used
+        gradient[N-1] = fixedKappa ? 0.0 : dKappa;
+    }
+
 
     NelsonSiegelFitting::NelsonSiegelFitting(
         const Array& weights,
@@ -139,6 +168,24 @@ namespace QuantLib {
         return d;
     }
 
+    void NelsonSiegelFitting::discountFunctionGradient(const Array& x,
+                                                       Time t,
+                                                       Array& gradient) const {
+        Real kappa = x[size()-1];
+        Real e = std::exp(-kappa*t);
+        Real k = kappa+QL_EPSILON, tau = t+QL_EPSILON;
+        Real a = (1.0 - e)/(k*tau);
+        Real zeroRate = x[0] + (x[1] + x[2])*a - x[2]*e;
+        DiscountFactor d = std::exp(-zeroRate * t);
+
+        // d(d)/dx = -t d dr/dx
+        Real da = t*e/(k*tau) - a/k;
+        gradient[0] = -t * d;
+        gradient[1] = -t * d * a;
+        gradient[2] = -t * d * (a - e);
+        gradient[3] = -t * d * ((x[1] + x[2])*da + x[2]*t*e);
+    }
+
 
     SvenssonFitting::SvenssonFitting(const Array& weights,
                                      const ext::shared_ptr<OptimizationMethod>& optimizationMethod,
@@ -177,6 +224,29 @@ namespace QuantLib {
         return d;
     }
 
+    void SvenssonFitting::discountFunctionGradient(const Array& x,
+                                                   Time t,
+                                                   Array& gradient) const {
+        Real kappa = x[size()-2];
+        Real kappa_1 = x[size()-1];
+        Real tau = t+QL_EPSILON;
+        Real e = std::exp(-kappa*t), e_1 = std::exp(-kappa_1*t);
+        Real k = kappa+QL_EPSILON, k_1 = kappa_1+QL_EPSILON;
+        Real a = (1.0 - e)/(k*tau), b = (1.0 - e_1)/(k_1*tau);
+        Real zeroRate = x[0] + (x[1] + x[2])*a - x[2]*e + x[3]*(b - e_1);
+        DiscountFactor d = std::exp(-zeroRate * t);
+
+        // d(d)/dx = -t d dr/dx
+        Real da = t*e/(k*tau) - a/k;
+        Real db = t*e_1/(k_1*tau) - b/k_1;
+        gradient[0] = -t * d;
+        gradient[1] = -t * d * a;
+        gradient[2] = -t * d * (a - e);
+        gradient[3] = -t * d * (b - e_1);
+        gradient[4] = -t * d * ((x[1] + x[2])*da + x[2]*t*e);
+        gradient[5] = -t * d * x[3] * (db + t*e_1);
+    }
+
 
     CubicBSplinesFitting::CubicBSplinesFitting(
         const std::vector<Time>& knots,
@@ -280,6 +350,22 @@ namespace QuantLib {
         return d;
     }
 
+    void CubicBSplinesFitting::discountFunctionGradient(const Array&,
+                                                        Time t,
+                                                        Array& gradient) const {
+        if (!constrainAtZero_) {
+            for (Size i=0; i<size_; ++i)
+                gradient[i] = splines_(i,t);
+        } else {
+            const Real T = 0.0;
+            Real ratio = splines_(N_,t)/splines_(N_,T);
+            for (Size i=0; i<size_; ++i) {
+                Size j = (i < N_) ? i : i+1;
+                gradient[i] = splines_(j,t) - splines_(j,T)*ratio;
+            }
+        }
+    }
+
 
     SimplePolynomialFitting::SimplePolynomialFitting(
         Natural degree,
@@ -325,6 +411,18 @@ namespace QuantLib {
         return d;
     }
 
+    void SimplePolynomialFitting::discountFunctionGradient(const Array&,
+                                                           Time t,
+                                                           Array& gradient) const {
+        if (!constrainAtZero_) {
+            for (Size i=0; i<size_; ++i)
+                gradient[i] = BernsteinPolynomial::get(i,i,t);
+        } else {
+            for (Size i=0; i<size_; ++i)
+                gradient[i] = BernsteinPolynomial::get(i+1,i+1,t);
+        }
+    }
+
     SpreadFittingMethod::SpreadFittingMethod(const ext::shared_ptr<FittingMethod>& method,
                                              Handle<YieldTermStructure> discountCurve,
                                              const Real minCutoffTime,
@@ -355,7 +453,20 @@ namespace QuantLib {
         return method_->discount(x, t)*discountingCurve_->discount(t, true)/rebase_;
     }
 
+    bool SpreadFittingMethod::providesDiscountGradient() const {
+        return method_->providesDiscountGradient();
+    }
+
+    void SpreadFittingMethod::discountFunctionGradient(const Array& x, Time t,
+                                                       Array& gradient) const {
+        method_->discountGradient(x, t, gradient);
+        gradient *= discountingCurve_->discount(t, true)/rebase_;
+    }
+
     void SpreadFittingMethod::init(){
+        // calculate the discounting curve now if it's lazy, so that
+        // the parallel loops of the cost function only read from it
+        discountingCurve_->discount(curve_->referenceDate());
         //In case discount curve has a different reference date,
         //discount to this curve's reference date
         if (curve_->referenceDate() != discountingCurve_->referenceDate()){
@@ -81,6 +81,10 @@ namespace QuantLib {
         Real fixedKappa_;
         Size size() const override;
         DiscountFactor discountFunction(const Array& x, Time t) const override;
+        bool providesDiscountGradient() const override { return true; }
+        void discountFunctionGradient(const Array& x,
+                                      Time t,
+                                      Array& gradient) const override;
     };
 
 
@@ -115,6 +119,10 @@ namespace QuantLib {
       private:
         Size size() const override;
         DiscountFactor discountFunction(const Array& x, Time t) const override;
+        bool providesDiscountGradient() const override { return true; }
+        void discountFunctionGradient(const Array& x,
+                                      Time t,
+                                      Array& gradient) const override;
     };
 
 
@@ -151,6 +159,10 @@ namespace QuantLib {
       private:
         Size size() const override;
         DiscountFactor discountFunction(const Array& x, Time t) const override;
+        bool providesDiscountGradient() const override { return true; }
+        void discountFunctionGradient(const Array& x,
+                                      Time t,
+                                      Array& gradient) const override;
     };
 
 
@@ -200,6 +212,10 @@ namespace QuantLib {
       private:
         Size size() const override;
         DiscountFactor discountFunction(const Array& x, Time t) const override;
+        bool providesDiscountGradient() const override { return true; }
+        void discountFunctionGradient(const Array& x,
+                                      Time t,
+                                      Array& gradient) const override;
         BSpline splines_;
         Size size_;
         //! N_th basis function coefficient to solve for when d(0)=1
@@ -242,6 +258,10 @@ namespace QuantLib {
       private:
         Size size() const override;
         DiscountFactor discountFunction(const Array& x, Time t) const override;
+        bool providesDiscountGradient() const override { return true; }
+        void discountFunctionGradient(const Array& x,
+                                      Time t,
+                                      Array& gradient) const override;
         Size size_;
     };
 
@@ -267,6 +287,8 @@ namespace QuantLib {
     private:
       Size size() const override;
       DiscountFactor discountFunction(const Array& x, Time t) const override;
+      bool providesDiscountGradient() const override;
+      void discountFunctionGradient(const Array& x, Time t, Array& gradient) const override;
       // underlying parametric method
       ext::shared_ptr<FittingMethod> method_;
       // adjustment in case underlying discount curve has different reference date
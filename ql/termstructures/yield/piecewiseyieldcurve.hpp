@@ -26,6 +26,7 @@
 #ifndef quantlib_piecewise_yield_curve_hpp
 #define quantlib_piecewise_yield_curve_hpp
 
+#include <ql/math/matrix.hpp>
 #include <ql/patterns/lazyobject.hpp>
 #include <ql/termstructures/iterativebootstrap.hpp>
 #include <ql/termstructures/localbootstrap.hpp>
@@ -56,6 +57,9 @@ namespace QuantLib {
         - the correctness of the returned values is tested by
           checking them against the original inputs.
         - the observability of the term structure is tested.
+        - the Jacobian of the node values with respect to the quotes
+          is checked against the one obtained by bumping each quote and
+          bootstrapping the curve again.
     */
     template <class Traits, class Interpolator,
               template <class> class Bootstrap = IterativeBootstrap>
@@ -245,6 +249,39 @@ namespace QuantLib {
         const std::vector<Real>& data() const;
         std::vector<std::pair<Date, Real> > nodes() const;
         //@}
+        //! \name Sensitivities
+        //@{
+        /*! Returns the Jacobian \f$ J_{ij} = \partial z_i / \partial q_j \f$
+            of the bootstrapped node values \f$ z_i \f$ (excluding the
+            first node, which is either fixed or tied to the second one)
+            with respect to the quotes \f$ q_j \f$ of the alive helpers,
+            sorted by pillar date.
+
+            The matrix is obtained from the bootstrapped curve by means
+            of the implicit function theorem: the sensitivities of the
+            implied helper quotes to the node values are calculated by
+            perturbing each node in turn without bootstrapping the
+            curve again, and the resulting matrix is inverted.  Its
+            cost is thus comparable to a single bootstrap, instead of
+            one bootstrap per quote.
+
+            \pre the curve must have exactly one alive helper per
+                 node after the first, as is the case for the
+                 iterative and local bootstraps.
+        */
+        Matrix jacobian() const;
+        /*! Returns the sensitivities \f$ \partial q_i / \partial z_j \f$
+            of the quotes implied by the given helpers, which might
+            belong to other curves depending on this one, to the node
+            values of this curve (excluding the first node).  The
+            nodes are perturbed in turn as in jacobian(), which is
+            the inverse of this matrix for the alive helpers of the
+            curve.
+        */
+        Matrix impliedQuoteSensitivities(
+            const std::vector<ext::shared_ptr<typename Traits::helper> >&
+                                                           helpers) const;
+        //@}
         //! \name Observer interface
         //@{
         void update() override;
@@ -256,6 +293,7 @@ namespace QuantLib {
         //@}
         // methods
         DiscountFactor discountImpl(Time) const override;
+        void setNodeValue(Size i, Real value) const;
         // data members
         std::vector<ext::shared_ptr<typename Traits::helper> > instruments_;
         Real accuracy_;
@@ -305,6 +343,70 @@ namespace QuantLib {
         return base_curve::nodes();
     }
 
+    template <class C, class I, template <class> class B>
+    Matrix PiecewiseYieldCurve<C,I,B>::jacobian() const {
+        calculate();
+
+        const Size n = this->data_.size() - 1;
+        QL_REQUIRE(instruments_.size() >= n,
+                   "curve has " << n << " nodes but only "
+                   << instruments_.size() << " helpers");
+        const Size firstAlive = instruments_.size() - n;
+        for (Size i=0; i<n; ++i)
+            QL_REQUIRE(instruments_[firstAlive+i]->pillarDate() ==
+                       this->dates_[i+1],
+                       io::ordinal(i+1) << " node (" << this->dates_[i+1]
+                       << ") doesn't match the pillar of the corresponding"
+                       " helper (" << instruments_[firstAlive+i]->pillarDate()
+                       << ")");
+
+        return inverse(impliedQuoteSensitivities(
+            std::vector<ext::shared_ptr<typename C::helper> >(
+                instruments_.begin() + firstAlive, instruments_.end())));
+    }
+
+    template <class C, class I, template <class> class B>
+    Matrix PiecewiseYieldCurve<C,I,B>::impliedQuoteSensitivities(
+        const std::vector<ext::shared_ptr<typename C::helper> >&
+                                                        helpers) const {
+        calculate();
+
+        // perturbation of the node values; central differences
+        // are accurate enough given the smoothness of the helpers
+        const Real h = 1.0e-6;
+
+        const Size n = this->data_.size() - 1, m = helpers.size();
+        const std::vector<Real> original = this->data_;
+        Matrix dqdz(m, n);
+        try {
+            for (Size j=0; j<n; ++j) {
+                setNodeValue(j+1, original[j+1] + h);
+                for (Size i=0; i<m; ++i)
+                    dqdz[i][j] = helpers[i]->impliedQuote();
+                setNodeValue(j+1, original[j+1] - h);
+                for (Size i=0; i<m; ++i)
+                    dqdz[i][j] = (dqdz[i][j] - helpers[i]->impliedQuote())
+                        / (2.0*h);
+                std::copy(original.begin(), original.end(),
+                          this->data_.begin());
+                this->interpolation_.update();
+            }
+        } catch (...) {
+            std::copy(original.begin(), original.end(), this->data_.begin());
+            this->interpolation_.update();
+            throw;
+        }
+
+        return dqdz;
+    }
+
+    template <class C, class I, template <class> class B>
+    inline void PiecewiseYieldCurve<C,I,B>::setNodeValue(Size i,
+                                                        Real value) const {
+        C::updateGuess(this->data_, value, i);
+        this->interpolation_.update();
+    }
+
     template <class C, class I, template <class> class B>
     inline void PiecewiseYieldCurve<C,I,B>::update() {
 
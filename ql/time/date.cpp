@@ -39,6 +39,7 @@
 #endif
 #include <iomanip>
 #include <ctime>
+#include <cstdint>
 
 #if defined(BOOST_NO_STDC_NAMESPACE)
     namespace std { using ::time; using ::time_t; using ::tm;
@@ -78,15 +79,33 @@ namespace QuantLib {
         serialNumber_ = d + offset + yearOffset(y);
     }
 
+    namespace {
+
+        /* Civil-from-days conversion, see H. Hinnant, "chrono-Compatible
+           Low-Level Date Algorithms".  Years are counted from March 1st,
+           which moves the leap day at their end and allows to get the
+           month with a few integer operations and no branches or table
+           lookups.  Only valid for serial numbers after
+           February 1900, i.e., outside the range affected by the
+           Excel bug which is out of the valid date range anyway.
+        */
+        inline Month monthFromSerial(Date::serial_type serial) {
+            // days since March 1st, 1600, the start of a 400-year era;
+            // unsigned arithmetic makes divisions by constants cheaper
+            auto z = static_cast<std::uint32_t>(serial) + 109511U;
+            std::uint32_t doe = z % 146097U;                     // [0, 146096]
+            std::uint32_t yoe =
+                (doe - doe/1460U + doe/36524U - doe/146096U) / 365U; // [0, 399]
+            std::uint32_t doy =
+                doe - (365U*yoe + yoe/4U - yoe/100U);            // [0, 365]
+            std::uint32_t mp = (5U*doy + 2U)/153U;               // [0, 11]
+            return Month(mp < 10U ? mp + 3U : mp - 9U);
+        }
+
+    }
+
     Month Date::month() const {
-        Day d = dayOfYear(); // dayOfYear is 1 based
-        Integer m = d/30 + 1;
-        bool leap = isLeap(year());
-        while (d <= monthOffset(Month(m),leap))
-            --m;
-        while (d > monthOffset(Month(m+1),leap)) // NOLINT(misc-misplaced-widening-cast)
-            ++m;
-        return Month(m);
+        return monthFromSerial(serialNumber_);
     }
 
     Year Date::year() const {
@@ -28,6 +28,7 @@
 #include <ql/errors.hpp>
 #include <ql/time/date.hpp>
 #include <utility>
+#include <vector>
 
 namespace QuantLib {
 
@@ -57,6 +58,22 @@ namespace QuantLib {
                                       const Date& d2,
                                       const Date& refPeriodStart,
                                       const Date& refPeriodEnd) const = 0;
+            //! to be overloaded by day counters with a faster batch calculation
+            /*! Reference periods are either empty or of the same
+                size as the dates.
+            */
+            virtual void yearFractions(const std::vector<Date>& d1,
+                                       const std::vector<Date>& d2,
+                                       const std::vector<Date>& refPeriodStart,
+                                       const std::vector<Date>& refPeriodEnd,
+                                       std::vector<Time>& result) const {
+                bool withReference = !refPeriodStart.empty();
+                for (Size i=0; i<d1.size(); ++i)
+                    result[i] = yearFraction(
+                        d1[i], d2[i],
+                        withReference ? refPeriodStart[i] : Date(),
+                        withReference ? refPeriodEnd[i] : Date());
+            }
         };
         ext::shared_ptr<Impl> impl_;
         /*! This constructor can be invoked by derived classes which
@@ -87,6 +104,18 @@ namespace QuantLib {
         Time yearFraction(const Date&, const Date&,
                           const Date& refPeriodStart = Date(),
                           const Date& refPeriodEnd = Date()) const;
+        //! Returns the periods between pairs of dates as fractions of year.
+        /*! The reference periods can be omitted; if given, they must
+            have the same size as the start and end dates.  This is
+            equivalent to calling yearFraction on each pair, but avoids
+            the overhead of a virtual call per pair for the simpler
+            day counters.
+        */
+        std::vector<Time> yearFractions(
+            const std::vector<Date>& startDates,
+            const std::vector<Date>& endDates,
+            const std::vector<Date>& refPeriodStarts = std::vector<Date>(),
+            const std::vector<Date>& refPeriodEnds = std::vector<Date>()) const;
         //@}
     };
 
@@ -131,6 +160,32 @@ namespace QuantLib {
             return impl_->yearFraction(d1,d2,refPeriodStart,refPeriodEnd);
     }
 
+    inline std::vector<Time> DayCounter::yearFractions(
+                                const std::vector<Date>& startDates,
+                                const std::vector<Date>& endDates,
+                                const std::vector<Date>& refPeriodStarts,
+                                const std::vector<Date>& refPeriodEnds) const {
+        QL_REQUIRE(impl_, "no day counter implementation provided");
+        QL_REQUIRE(startDates.size() == endDates.size(),
+                   "number of start dates (" << startDates.size()
+                   << ") different from number of end dates ("
+                   << endDates.size() << ")");
+        QL_REQUIRE(refPeriodStarts.size() == refPeriodEnds.size(),
+                   "number of reference-period starts ("
+                   << refPeriodStarts.size()
+                   << ") different from number of reference-period ends ("
+                   << refPeriodEnds.size() << ")");
+        QL_REQUIRE(refPeriodStarts.empty() ||
+                   refPeriodStarts.size() == startDates.size(),
+                   "number of reference periods (" << refPeriodStarts.size()
+                   << ") different from number of dates ("
+                   << startDates.size() << ")");
+        std::vector<Time> result(startDates.size());
+        impl_->yearFractions(startDates, endDates,
+                             refPeriodStarts, refPeriodEnds, result);
+        return result;
+    }
+
 
     inline bool operator==(const DayCounter& d1, const DayCounter& d2) {
         return (d1.empty() && d2.empty())
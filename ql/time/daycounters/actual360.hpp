@@ -55,6 +55,15 @@ namespace QuantLib {
                 return (daysBetween(d1,d2)
                         + (includeLastDay_ ? 1.0 : 0.0))/360.0;
             }
+            void yearFractions(const std::vector<Date>& d1,
+                               const std::vector<Date>& d2,
+                               const std::vector<Date>&,
+                               const std::vector<Date>&,
+                               std::vector<Time>& result) const override {
+                Real extraDay = includeLastDay_ ? 1.0 : 0.0;
+                for (Size i=0; i<d1.size(); ++i)
+                    result[i] = (daysBetween(d1[i],d2[i]) + extraDay)/360.0;
+            }
         };
       public:
         explicit Actual360(const bool includeLastDay = false)
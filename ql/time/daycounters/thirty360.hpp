@@ -72,6 +72,14 @@ namespace QuantLib {
             yearFraction(const Date& d1, const Date& d2, const Date&, const Date&) const override {
                 return dayCount(d1,d2)/360.0;
             }
+            void yearFractions(const std::vector<Date>& d1,
+                               const std::vector<Date>& d2,
+                               const std::vector<Date>&,
+                               const std::vector<Date>&,
+                               std::vector<Time>& result) const override {
+                for (Size i=0; i<d1.size(); ++i)
+                    result[i] = US_Impl::dayCount(d1[i],d2[i])/360.0;
+            }
         };
         class EU_Impl : public DayCounter::Impl {
           public:
@@ -81,6 +89,14 @@ namespace QuantLib {
             yearFraction(const Date& d1, const Date& d2, const Date&, const Date&) const override {
                 return dayCount(d1,d2)/360.0;
             }
+            void yearFractions(const std::vector<Date>& d1,
+                               const std::vector<Date>& d2,
+                               const std::vector<Date>&,
+                               const std::vector<Date>&,
+                               std::vector<Time>& result) const override {
+                for (Size i=0; i<d1.size(); ++i)
+                    result[i] = EU_Impl::dayCount(d1[i],d2[i])/360.0;
+            }
         };
         class IT_Impl : public DayCounter::Impl {
           public:
@@ -90,6 +106,14 @@ namespace QuantLib {
             yearFraction(const Date& d1, const Date& d2, const Date&, const Date&) const override {
                 return dayCount(d1,d2)/360.0;
             }
+            void yearFractions(const std::vector<Date>& d1,
+                               const std::vector<Date>& d2,
+                               const std::vector<Date>&,
+                               const std::vector<Date>&,
+                               std::vector<Time>& result) const override {
+                for (Size i=0; i<d1.size(); ++i)
+                    result[i] = IT_Impl::dayCount(d1[i],d2[i])/360.0;
+            }
         };
         class GER_Impl : public DayCounter::Impl {
           public:
@@ -100,6 +124,14 @@ namespace QuantLib {
             yearFraction(const Date& d1, const Date& d2, const Date&, const Date&) const override {
                 return dayCount(d1,d2)/360.0;
             }
+            void yearFractions(const std::vector<Date>& d1,
+                               const std::vector<Date>& d2,
+                               const std::vector<Date>&,
+                               const std::vector<Date>&,
+                               std::vector<Time>& result) const override {
+                for (Size i=0; i<d1.size(); ++i)
+                    result[i] = GER_Impl::dayCount(d1[i],d2[i])/360.0;
+            }
 
         private:
             bool isLastPeriod_;
@@ -40,6 +40,14 @@ namespace QuantLib {
             yearFraction(const Date& d1, const Date& d2, const Date&, const Date&) const override {
                 return dayCount(d1,d2)/365.0;
             }
+            void yearFractions(const std::vector<Date>& d1,
+                               const std::vector<Date>& d2,
+                               const std::vector<Date>&,
+                               const std::vector<Date>&,
+                               std::vector<Time>& result) const override {
+                for (Size i=0; i<d1.size(); ++i)
+                    result[i] = Impl::dayCount(d1[i],d2[i])/365.0;
+            }
         };
       public:
         Thirty365();
@@ -1661,6 +1661,80 @@ void BondTest::testThirty360BondWithSettlementOn31st(){
     ASSERT_CLOSE("accrued", settlement, accrued, 0.7, 1e-6);
 }
 
+void BondTest::testBatchYields() {
+
+    BOOST_TEST_MESSAGE("Testing batch bond price/yield calculation...");
+
+    using namespace bonds_test;
+
+    CommonVars vars;
+
+    Real tolerance = 1.0e-10;
+
+    Integer issueMonths[] = { -18, -6, 0, 12 };
+    Integer lengths[] = { 3, 10, 20 };
+    Real coupons[] = { 0.02, 0.08 };
+    DayCounter bondDayCount = ActualActual(ActualActual::ISMA);
+    Frequency frequency = Semiannual;
+    Compounding compounding = Compounded;
+
+    std::vector<ext::shared_ptr<Bond> > bonds;
+    std::vector<Rate> yields;
+    for (int issueMonth : issueMonths) {
+        for (int length : lengths) {
+            for (Real coupon : coupons) {
+                Date issue = vars.calendar.advance(vars.today, issueMonth, Months);
+                Date maturity = vars.calendar.advance(issue, length, Years);
+                Schedule sch(issue, maturity, Period(frequency), vars.calendar,
+                             Unadjusted, Unadjusted, DateGeneration::Backward,
+                             false);
+                bonds.push_back(ext::make_shared<FixedRateBond>(
+                    3, vars.faceAmount, sch, std::vector<Rate>(1, coupon),
+                    bondDayCount, ModifiedFollowing, 100.0, issue));
+                yields.push_back(0.01 + 0.005 * (yields.size() % 9));
+            }
+        }
+    }
+
+    std::vector<Real> prices =
+        BondFunctions::prices(bonds, yields, bondDayCount, compounding, frequency);
+    std::vector<Rate> calculated =
+        BondFunctions::yields(bonds, prices, bondDayCount, compounding, frequency,
+                              Date(), tolerance);
+
+    Handle<YieldTermStructure> discountCurve(
+        flatRate(vars.today, 0.03, bondDayCount));
+
+    for (Size i=0; i<bonds.size(); ++i) {
+        const Bond& bond = *bonds[i];
+        Real price = BondFunctions::cleanPrice(bond, yields[i], bondDayCount,
+                                               compounding, frequency);
+        checkValue(prices[i], price, 1.0e-12,
+                   "batch price differs from single-bond price");
+
+        Rate yield = BondFunctions::yield(bond, price, bondDayCount,
+                                          compounding, frequency, Date(),
+                                          tolerance);
+        checkValue(calculated[i], yield, 1.0e-12,
+                   "batch yield differs from single-bond yield");
+        checkValue(calculated[i], yields[i], 1.0e-8,
+                   "failed to recover yield from batch price");
+
+        // the snapshot reproduces the leg-based curve analytics
+        Date settlement = bond.settlementDate();
+        LegSnapshot snapshot(bond.cashflows(), bondDayCount, false,
+                             settlement, settlement);
+        checkValue(CashFlows::npv(snapshot, **discountCurve),
+                   CashFlows::npv(bond.cashflows(), **discountCurve, false,
+                                  settlement, settlement),
+                   1.0e-6, "snapshot npv differs from leg npv");
+        checkValue(CashFlows::bps(snapshot, **discountCurve),
+                   CashFlows::bps(bond.cashflows(), **discountCurve, false,
+                                  settlement, settlement),
+                   1.0e-6, "snapshot bps differs from leg bps");
+    }
+}
+
 test_suite* BondTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Bond tests");
 
@@ -1679,6 +1753,7 @@ test_suite* BondTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&BondTest::testBondFromScheduleWithDateVector));
     suite->add(QUANTLIB_TEST_CASE(&BondTest::testFixedRateBondWithArbitrarySchedule));
     suite->add(QUANTLIB_TEST_CASE(&BondTest::testThirty360BondWithSettlementOn31st));
+    suite->add(QUANTLIB_TEST_CASE(&BondTest::testBatchYields));
     return suite;
 }
 
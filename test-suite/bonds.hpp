@@ -42,6 +42,7 @@ class BondTest {
     static void testBondFromScheduleWithDateVector();
     static void testFixedRateBondWithArbitrarySchedule();
     static void testThirty360BondWithSettlementOn31st();
+    static void testBatchYields();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -27,6 +27,7 @@
 #include <ql/experimental/credit/inhomogeneouspooldef.hpp>
 #include <ql/experimental/credit/homogeneouspooldef.hpp>
 #include <ql/experimental/credit/gaussianlhplossmodel.hpp>
+#include <ql/experimental/credit/fftpoollossmodel.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/credit/flathazardrate.hpp>
 #include <ql/time/calendars/target.hpp>
@@ -34,8 +35,13 @@
 #include <ql/time/daycounters/actualactual.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/currencies/europe.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/math/randomnumbers/randomsequencegenerator.hpp>
 #include <iomanip>
 #include <iostream>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace QuantLib;
 using namespace std;
@@ -365,9 +371,535 @@ void CdoTest::testHW(unsigned dataSet) {
 }
 
 
+namespace cdo_test {
+
+    struct TestPool {
+        ext::shared_ptr<Pool> pool;
+        vector<string> names;
+        // hazard rates of the senior secured debt of each name
+        vector<ext::shared_ptr<SimpleQuote> > hazardRates;
+    };
+
+    /* Issuers with flat hazard rates for senior secured debt, driven
+       by quotes, and 4% higher ones for senior unsecured debt.  The
+       pool uses the senior secured curves, unless mixed is true: then
+       names are added in reverse alphabetical order and with
+       alternating seniorities, so that positions and name ordering
+       don't coincide. */
+    TestPool makePool(const Date& asofDate,
+                      Size poolSize,
+                      Rate firstRate,
+                      Rate rateStep,
+                      bool mixed = false) {
+        TestPool data;
+        data.pool = ext::make_shared<Pool>();
+        for (Size i=0; i<poolSize; ++i) {
+            Rate rate = firstRate + rateStep*i;
+            data.hazardRates.push_back(ext::make_shared<SimpleQuote>(rate));
+            vector<pair<DefaultProbKey,
+                   Handle<DefaultProbabilityTermStructure> > > probabilities;
+            probabilities.emplace_back(
+                NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                           Period(0, Weeks), 10.),
+                Handle<DefaultProbabilityTermStructure>(
+                    ext::make_shared<FlatHazardRate>(
+                        asofDate, Handle<Quote>(data.hazardRates.back()),
+                        ActualActual())));
+            probabilities.emplace_back(
+                NorthAmericaCorpDefaultKey(EURCurrency(), SeniorUnSec,
+                                           Period(0, Weeks), 10.),
+                Handle<DefaultProbabilityTermStructure>(
+                    ext::make_shared<FlatHazardRate>(asofDate, rate + 0.04,
+                                                     ActualActual())));
+            ostringstream o;
+            o << "issuer-" << std::setw(2) << std::setfill('0')
+              << (mixed ? poolSize-i : i);
+            data.names.push_back(o.str());
+            Seniority seniority =
+                (mixed && i % 2 != 0) ? SeniorUnSec : SeniorSec;
+            data.pool->add(data.names.back(), Issuer(probabilities),
+                           NorthAmericaCorpDefaultKey(EURCurrency(), seniority,
+                                                      Period(), 1.));
+        }
+        return data;
+    }
+
+    // pseudo-random simulations, which don't need the Sobol tables
+    typedef RandomDefaultLM<GaussianCopulaPolicy,
+        RandomSequenceGenerator<MersenneTwisterUniformRng> >
+            MTRandomDefaultLM;
+
+    // gives access to the simulated events and to the cached losses
+    class InspectedRandomDefaultLM : public MTRandomDefaultLM {
+      public:
+        using MTRandomDefaultLM::MTRandomDefaultLM;
+        using MTRandomDefaultLM::update;
+        using MTRandomDefaultLM::getSim;
+        using MTRandomDefaultLM::eventsBefore;
+        using MTRandomDefaultLM::lossBefore;
+        bool isCached(const Date& d) const {
+            return expectedTrancheLosses_.find(d) !=
+                expectedTrancheLosses_.end();
+        }
+    };
+
+}
+
+
+void CdoTest::testConditionalProbabilitiesBatch() {
+    BOOST_TEST_MESSAGE("Testing batch conditional default probabilities "
+                       "in default latent models...");
+
+    SavedSettings backup;
+
+    Date asofDate = Date(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+
+    using namespace cdo_test;
+
+    Size poolSize = 10;
+    TestPool data = makePool(asofDate, poolSize, 0.005, 0.003);
+    const ext::shared_ptr<Pool>& pool = data.pool;
+    const vector<string>& names = data.names;
+    const vector<ext::shared_ptr<SimpleQuote> >& hazardRates =
+        data.hazardRates;
+    ext::shared_ptr<Basket> basket(
+        new Basket(asofDate, names, vector<Real>(poolSize, 100.0), pool));
+
+    ext::shared_ptr<SimpleQuote> correlation(new SimpleQuote(0.3));
+    TCopulaPolicy::initTraits initT;
+    initT.tOrders = vector<Integer>(2, 5);
+    ext::shared_ptr<TConstantLossLM> lm(new TConstantLossLM(
+        Handle<Quote>(correlation), vector<Real>(poolSize, 0.4),
+        LatentModelIntegrationType::GaussianQuadrature, poolSize, initT));
+    lm->resetBasket(basket);
+
+    Date d = asofDate + 3*Years;
+    const Real tolerance = 1.0e-14;
+
+    for (Size k=0; k<3; ++k) {
+        if (k == 1)
+            hazardRates[3]->setValue(0.05);
+        else if (k == 2)
+            correlation->setValue(0.5);
+
+        vector<Probability> probs = basket->remainingProbabilities(d);
+        vector<Real> invProbs = lm->inverseRemainingProbabilities(d);
+        BOOST_REQUIRE(invProbs.size() == poolSize);
+        for (Size i=0; i<poolSize; ++i) {
+            Real expected = lm->inverseCumulativeY(probs[i], i);
+            if (std::fabs(invProbs[i] - expected) > tolerance)
+                BOOST_ERROR("inverted probability mismatch for name "
+                            << i << " in case " << k << ":"
+                            << "\n    cached:   " << invProbs[i]
+                            << "\n    expected: " << expected);
+        }
+
+        vector<Probability> condProbs;
+        for (Real m = -4.0; m <= 4.0; m += 0.5) {
+            vector<Real> mktFactor(1, m);
+            lm->conditionalDefaultProbabilitiesInvP(invProbs, mktFactor,
+                                                    condProbs);
+            BOOST_REQUIRE(condProbs.size() == poolSize);
+            for (Size i=0; i<poolSize; ++i) {
+                Probability expected =
+                    lm->conditionalDefaultProbabilityInvP(invProbs[i], i,
+                                                          mktFactor);
+                if (std::fabs(condProbs[i] - expected) > tolerance)
+                    BOOST_ERROR("conditional probability mismatch for name "
+                                << i << " in case " << k
+                                << " at factor " << m << ":"
+                                << "\n    batch:    " << condProbs[i]
+                                << "\n    expected: " << expected);
+            }
+        }
+    }
+}
+
+
+void CdoTest::testFFTLossModel() {
+    BOOST_TEST_MESSAGE("Testing FFT pool loss model...");
+
+    SavedSettings backup;
+
+    Date asofDate = Date(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+
+    using namespace cdo_test;
+
+    // losses given default are multiples of the loss unit, so that the
+    // model distribution is exact up to the factor integration
+    Size poolSize = 20;
+    Real recovery = 0.4;
+    vector<Real> notionals;
+    for (Size i=0; i<poolSize; ++i)
+        notionals.push_back(50.0 * (1 + i%4));
+    TestPool data = makePool(asofDate, poolSize, 0.01, 0.002);
+    const ext::shared_ptr<Pool>& pool = data.pool;
+    const vector<string>& names = data.names;
+    const vector<ext::shared_ptr<SimpleQuote> >& hazardRates =
+        data.hazardRates;
+    // attachment and detachment amounts: 150 and 600
+    Real attachment = 0.06, detachment = 0.24;
+    Size nBuckets = 20;
+    Real lossUnit = 30.0;
+
+    ext::shared_ptr<SimpleQuote> correlation(new SimpleQuote(0.0));
+    ext::shared_ptr<GaussianConstantLossLM> lm(new GaussianConstantLossLM(
+        Handle<Quote>(correlation), vector<Real>(poolSize, recovery),
+        LatentModelIntegrationType::GaussianQuadrature, poolSize,
+        GaussianCopulaPolicy::initTraits()));
+
+    ext::shared_ptr<Basket> basket(new Basket(asofDate, names, notionals,
+                                              pool, attachment, detachment));
+    ext::shared_ptr<FFTGaussPoolLossModel> fftModel(
+        new FFTGaussPoolLossModel(lm, nBuckets));
+    basket->setLossModel(fftModel);
+
+    Date d = asofDate + 5*Years;
+
+    // without correlation the names are independent and the loss
+    // distribution can be obtained by direct convolution
+    vector<Probability> probs = basket->remainingProbabilities(d);
+    vector<Real> reference(1, 1.0);
+    for (Size i=0; i<poolSize; ++i) {
+        Size k = Size(notionals[i] * (1.0-recovery) / lossUnit + 0.5);
+        vector<Real> next(reference.size() + k, 0.0);
+        for (Size n=0; n<reference.size(); ++n) {
+            next[n] += reference[n] * (1.0 - probs[i]);
+            next[n+k] += reference[n] * probs[i];
+        }
+        reference.swap(next);
+    }
+    Real expectedLoss = 0.0;
+    for (Size n=0; n<reference.size(); ++n)
+        expectedLoss += reference[n] *
+            std::min(std::max(n*lossUnit - 150.0, 0.0), 450.0);
+
+    // the tolerance accounts for the accuracy of the inverse
+    // cumulative normal used by the latent model
+    Real tolerance = 1.0e-8;
+    Real calculated = basket->expectedTrancheLoss(d);
+    if (std::fabs(calculated - expectedLoss) > tolerance * expectedLoss)
+        BOOST_ERROR("failed to reproduce independent tranche loss:"
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expectedLoss);
+
+    std::map<Real, Probability> distribution = basket->lossDistribution(d);
+    BOOST_REQUIRE(distribution.size() == nBuckets);
+    Probability cumulated = 0.0;
+    Size n = 0;
+    for (std::map<Real, Probability>::const_iterator it =
+             distribution.begin(); it != distribution.end(); ++it, ++n) {
+        cumulated += reference[n];
+        if (std::fabs(it->first - n*lossUnit) > tolerance
+            || std::fabs(it->second - cumulated) > tolerance)
+            BOOST_ERROR("failed to reproduce independent loss distribution "
+                        "at loss " << n*lossUnit << ":"
+                        << "\n    calculated: " << it->second
+                        << "\n    expected:   " << cumulated);
+    }
+
+    // correlated pool: compare with the bucketing algorithm and check
+    // that the distributions are recomputed when the inputs change
+    correlation->setValue(0.3);
+    ext::shared_ptr<DefaultLossModel> ihModel(
+        new IHGaussPoolLossModel(lm, 500, 5., -5., 50));
+    ext::shared_ptr<Basket> ihBasket(new Basket(asofDate, names, notionals,
+                                                pool, attachment, detachment));
+    ihBasket->setLossModel(ihModel);
+
+    for (Size k=0; k<2; ++k) {
+        if (k == 1)
+            hazardRates[5]->setValue(0.05);
+        calculated = basket->expectedTrancheLoss(d);
+        Real bucketed = ihBasket->expectedTrancheLoss(d);
+        if (std::fabs(calculated - bucketed) > 0.01 * bucketed)
+            BOOST_ERROR("failed to reproduce bucketed tranche loss:"
+                        << "\n    calculated: " << calculated
+                        << "\n    bucketing:  " << bucketed);
+    }
+
+    // distributions for several dates in a single integration
+    vector<Date> dates;
+    for (Size i=1; i<=5; ++i)
+        dates.push_back(asofDate + i*Years);
+    fftModel->computeDistributions(dates);
+    ext::shared_ptr<Basket> singleBasket(new Basket(asofDate, names,
+                                                    notionals, pool,
+                                                    attachment, detachment));
+    singleBasket->setLossModel(ext::make_shared<FFTGaussPoolLossModel>(
+                                                          lm, nBuckets));
+    for (Size i=0; i<dates.size(); ++i) {
+        Real batch = basket->expectedTrancheLoss(dates[i]);
+        Real single = singleBasket->expectedTrancheLoss(dates[i]);
+        if (std::fabs(batch - single) > 1.0e-12 * single)
+            BOOST_ERROR("batch and single date tranche losses differ at "
+                        << dates[i] << ":"
+                        << "\n    batch:  " << batch
+                        << "\n    single: " << single);
+    }
+}
+
+
+void CdoTest::testPoolIndexedAccess() {
+    BOOST_TEST_MESSAGE("Testing positional access to pool and basket data...");
+
+    SavedSettings backup;
+
+    Date asofDate = Date(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+
+    using namespace cdo_test;
+
+    // names are added in reverse alphabetical order and with different
+    // seniorities, so that positions and name ordering don't coincide
+    Size poolSize = 12;
+    TestPool data = makePool(asofDate, poolSize, 0.01, 0.002, true);
+    const ext::shared_ptr<Pool>& pool = data.pool;
+    const vector<string>& names = data.names;
+    vector<Real> notionals;
+    for (Size i=0; i<poolSize; ++i)
+        notionals.push_back(100.0 + i);
+    ext::shared_ptr<Basket> basket(
+        new Basket(asofDate, names, notionals, pool));
+
+    BOOST_REQUIRE(pool->size() == poolSize);
+    BOOST_REQUIRE(pool->defaultKeys().size() == poolSize);
+
+    Date d = asofDate + 5*Years;
+    vector<Probability> probs = basket->probabilities(d);
+    vector<Real> remaining = basket->remainingNotionals(d);
+    for (Size i=0; i<poolSize; ++i) {
+        if (pool->index(names[i]) != i)
+            BOOST_ERROR("wrong position for " << names[i] << ": "
+                        << pool->index(names[i]) << " instead of " << i);
+        if (&pool->get(i) != &pool->get(names[i]))
+            BOOST_ERROR("positional and named issuers differ for "
+                        << names[i]);
+        if (!(pool->defaultKeys()[i] == pool->defaultKey(names[i])) ||
+            !(pool->defaultKey(i) == pool->defaultKey(names[i])))
+            BOOST_ERROR("default key out of order for " << names[i]);
+
+        Probability expected = pool->get(names[i]).defaultProbability(
+            pool->defaultKey(names[i]))->defaultProbability(d);
+        if (std::fabs(probs[i] - expected) > 1.0e-15)
+            BOOST_ERROR("wrong basket probability for " << names[i] << ":"
+                        << "\n    calculated: " << probs[i]
+                        << "\n    expected:   " << expected);
+
+        if (basket->exposure(i) != notionals[i] ||
+            basket->exposure(names[i]) != notionals[i] ||
+            remaining[i] != notionals[i])
+            BOOST_ERROR("wrong exposure for " << names[i]);
+
+        pool->setTime(i, 0.5*i);
+        if (pool->getTime(names[i]) != 0.5*i || pool->times()[i] != 0.5*i)
+            BOOST_ERROR("wrong time for " << names[i]);
+    }
+
+    BOOST_CHECK_THROW(pool->get(poolSize), Error);
+    BOOST_CHECK_THROW(pool->defaultKey(poolSize), Error);
+    BOOST_CHECK_THROW(pool->setTime(poolSize, 1.0), Error);
+    BOOST_CHECK_THROW(pool->getTime(poolSize), Error);
+}
+
+
+void CdoTest::testRandomDefaultSimulations() {
+    BOOST_TEST_MESSAGE("Testing random default simulations "
+                       "against cached values...");
+
+    SavedSettings backup;
+
+    Date asofDate = Date(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+
+    using namespace cdo_test;
+
+    Size poolSize = 10;
+    Real recovery = 0.4;
+    vector<Real> notionals;
+    for (Size i=0; i<poolSize; ++i)
+        notionals.push_back(100.0 + 10.0*i);
+    TestPool data = makePool(asofDate, poolSize, 0.02, 0.005);
+
+    ext::shared_ptr<GaussianConstantLossLM> lm(new GaussianConstantLossLM(
+        Handle<Quote>(ext::make_shared<SimpleQuote>(0.3)),
+        vector<Real>(poolSize, recovery),
+        LatentModelIntegrationType::GaussianQuadrature, poolSize,
+        GaussianCopulaPolicy::initTraits()));
+
+    // the simulations span more than one block of latent samples
+    Size numSims = 5000;
+    ext::shared_ptr<MTRandomDefaultLM> model(
+        new MTRandomDefaultLM(lm, numSims));
+    ext::shared_ptr<Basket> basket(new Basket(asofDate, data.names,
+                                              notionals, data.pool,
+                                              0.03, 0.10));
+    basket->setLossModel(model);
+
+    Date dates[] = { asofDate + 1*Years,
+                     asofDate + 3*Years,
+                     asofDate + 5*Years };
+    Real cached[] = { 18.2566, 44.8809, 60.9959 };
+
+    Real tolerance = 1.0e-8;
+    for (Size i=0; i<LENGTH(dates); ++i) {
+        Real calculated = basket->expectedTrancheLoss(dates[i]);
+        if (std::fabs(calculated - cached[i]) > tolerance)
+            BOOST_ERROR("failed to reproduce cached tranche loss at "
+                        << dates[i] << ":"
+                        << std::setprecision(12)
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << cached[i]);
+    }
+
+    #ifdef _OPENMP
+    // the samples are drawn serially, so that the results don't
+    // depend on the number of threads
+    vector<Real> losses[2];
+    const int threads = omp_get_max_threads();
+    for (Size k=0; k<2; ++k) {
+        omp_set_num_threads(k == 1 ? 4 : 1);
+        try {
+            basket->setLossModel(
+                ext::make_shared<MTRandomDefaultLM>(lm, numSims));
+            for (Size i=0; i<LENGTH(dates); ++i)
+                losses[k].push_back(basket->expectedTrancheLoss(dates[i]));
+        } catch (...) {
+            omp_set_num_threads(threads);
+            throw;
+        }
+    }
+    omp_set_num_threads(threads);
+
+    for (Size i=0; i<LENGTH(dates); ++i) {
+        if (losses[0][i] != losses[1][i])
+            BOOST_ERROR("parallel and serial tranche losses differ at "
+                        << dates[i] << ":"
+                        << std::setprecision(16)
+                        << "\n    serial:   " << losses[0][i]
+                        << "\n    parallel: " << losses[1][i]);
+    }
+    #endif
+}
+
+
+void CdoTest::testRandomDefaultStatistics() {
+    BOOST_TEST_MESSAGE("Testing random default statistics "
+                       "against the simulated events...");
+
+    SavedSettings backup;
+
+    Date asofDate = Date(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+
+    using namespace cdo_test;
+
+    Size poolSize = 8;
+    Real recovery = 0.4;
+    vector<Real> notionals;
+    for (Size i=0; i<poolSize; ++i)
+        notionals.push_back(100.0 + 10.0*i);
+    TestPool data = makePool(asofDate, poolSize, 0.03, 0.01);
+
+    ext::shared_ptr<GaussianConstantLossLM> lm(new GaussianConstantLossLM(
+        Handle<Quote>(ext::make_shared<SimpleQuote>(0.3)),
+        vector<Real>(poolSize, recovery),
+        LatentModelIntegrationType::GaussianQuadrature, poolSize,
+        GaussianCopulaPolicy::initTraits()));
+
+    Size numSims = 1000;
+    ext::shared_ptr<InspectedRandomDefaultLM> model(
+        new InspectedRandomDefaultLM(lm, numSims));
+    ext::shared_ptr<Basket> basket(new Basket(asofDate, data.names,
+                                              notionals, data.pool,
+                                              0.05, 0.20));
+    basket->setLossModel(model);
+    Real attachment = basket->attachmentAmount();
+    Real detachment = basket->detachmentAmount();
+
+    Date dates[] = { asofDate + 1*Years,
+                     asofDate + 3*Years,
+                     asofDate + 5*Years };
+    Real trancheLosses[LENGTH(dates)];
+
+    Real tolerance = 1.0e-10;
+    for (Size i=0; i<LENGTH(dates); ++i) {
+        trancheLosses[i] = basket->expectedTrancheLoss(dates[i]);
+        if (!model->isCached(dates[i]))
+            BOOST_ERROR("tranche loss not cached at " << dates[i]);
+
+        // scan all the events of each simulation, without relying
+        // on their order
+        Date::serial_type day =
+            dates[i].serialNumber() - asofDate.serialNumber();
+        Real expected = 0.0;
+        for (Size iSim=0; iSim<numSims; ++iSim) {
+            Size events = 0;
+            Real loss = 0.0;
+            for (const auto& evt : model->getSim(iSim)) {
+                if (evt.dayFromRef < day) {
+                    ++events;
+                    loss += basket->exposure(evt.nameIdx,
+                        Date(asofDate.serialNumber() + evt.dayFromRef))
+                        * (1.0 - recovery);
+                }
+            }
+            if (model->eventsBefore(iSim, day) != events ||
+                std::fabs(model->lossBefore(iSim, day) - loss) > tolerance)
+                BOOST_FAIL("failed to reproduce simulated events at "
+                           << dates[i] << " in simulation " << iSim << ":"
+                           << "\n    calculated events: "
+                           << model->eventsBefore(iSim, day)
+                           << "\n    expected events:   " << events
+                           << "\n    calculated loss:   "
+                           << model->lossBefore(iSim, day)
+                           << "\n    expected loss:     " << loss);
+            expected += std::min(std::max(loss - attachment, 0.0),
+                                 detachment - attachment);
+        }
+        expected /= numSims;
+
+        if (std::fabs(trancheLosses[i] - expected) > tolerance)
+            BOOST_ERROR("failed to reproduce simulated tranche loss at "
+                        << dates[i] << ":"
+                        << std::setprecision(12)
+                        << "\n    calculated: " << trancheLosses[i]
+                        << "\n    expected:   " << expected);
+    }
+
+    // the cached losses are discarded with the simulations...
+    model->update();
+    for (Size i=0; i<LENGTH(dates); ++i) {
+        if (model->isCached(dates[i]))
+            BOOST_ERROR("tranche loss still cached at " << dates[i]
+                        << " after update");
+    }
+
+    // ...and the same seed reproduces them
+    for (Size i=0; i<LENGTH(dates); ++i) {
+        Real calculated = basket->expectedTrancheLoss(dates[i]);
+        if (calculated != trancheLosses[i])
+            BOOST_ERROR("failed to reproduce tranche loss at "
+                        << dates[i] << " after update:"
+                        << std::setprecision(16)
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << trancheLosses[i]);
+    }
+}
+
+
 test_suite* CdoTest::suite(SpeedLevel speed) {
     auto* suite = BOOST_TEST_SUITE("CDO tests");
 
+    suite->add(QUANTLIB_TEST_CASE(
+                       &CdoTest::testConditionalProbabilitiesBatch));
+    suite->add(QUANTLIB_TEST_CASE(&CdoTest::testFFTLossModel));
+    suite->add(QUANTLIB_TEST_CASE(&CdoTest::testPoolIndexedAccess));
+    suite->add(QUANTLIB_TEST_CASE(&CdoTest::testRandomDefaultSimulations));
+    suite->add(QUANTLIB_TEST_CASE(&CdoTest::testRandomDefaultStatistics));
+
     #ifndef QL_PATCH_SOLARIS
     if (speed == Slow) {
         // unrolled to get different test names
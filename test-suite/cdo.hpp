@@ -29,6 +29,11 @@
 class CdoTest {
   public:
     static void testHW(unsigned dataSet);
+    static void testConditionalProbabilitiesBatch();
+    static void testFFTLossModel();
+    static void testPoolIndexedAccess();
+    static void testRandomDefaultSimulations();
+    static void testRandomDefaultStatistics();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
 
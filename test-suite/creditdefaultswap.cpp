@@ -26,7 +26,9 @@
 #include <ql/pricingengines/credit/integralcdsengine.hpp>
 #include <ql/pricingengines/credit/isdacdsengine.hpp>
 #include <ql/termstructures/credit/flathazardrate.hpp>
+#include <ql/termstructures/credit/defaultprobabilityhelpers.hpp>
 #include <ql/termstructures/credit/interpolatedhazardratecurve.hpp>
+#include <ql/termstructures/credit/piecewisedefaultcurve.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/yield/discountcurve.hpp>
 #include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
@@ -708,6 +710,92 @@ void CreditDefaultSwapTest::testIsdaEngine() {
     }
 }
 
+void CreditDefaultSwapTest::testIsdaEngineBook() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing ISDA engine batch pricing of credit-default swaps...");
+
+    SavedSettings backup;
+
+    Date today(21, May, 2009);
+    Settings::instance().evaluationDate() = today;
+    Actual365Fixed dayCounter;
+
+    std::vector<Date> discountDates;
+    std::vector<DiscountFactor> discounts;
+    for (Integer i = 0; i <= 24; ++i) {
+        discountDates.push_back(today + (6 * i) * Months);
+        discounts.push_back(std::exp(-(0.01 + 0.001 * i) * 0.5 * i));
+    }
+    Handle<YieldTermStructure> discountCurve(
+        ext::make_shared<InterpolatedDiscountCurve<LogLinear> >(
+            discountDates, discounts, dayCounter));
+
+    // bootstrap the default curve on ISDA helpers, which reprice
+    // with the cached nodes of their own engines
+    Real recoveryRate = 0.4;
+    Integer tenors[] = {1, 2, 3, 5, 7};
+    Rate spreads[] = {0.0050, 0.0065, 0.0080, 0.0095, 0.0100};
+    std::vector<ext::shared_ptr<SimpleQuote> > quotes;
+    std::vector<ext::shared_ptr<DefaultProbabilityHelper> > helpers;
+    for (Size i = 0; i < LENGTH(tenors); ++i) {
+        quotes.push_back(ext::make_shared<SimpleQuote>(spreads[i]));
+        helpers.push_back(ext::make_shared<SpreadCdsHelper>(
+            Handle<Quote>(quotes.back()), tenors[i] * Years, 1, WeekendsOnly(),
+            Quarterly, Following, DateGeneration::CDS2015, Actual360(),
+            recoveryRate, discountCurve, true, true, Date(), Actual360(true),
+            true, CreditDefaultSwap::ISDA));
+    }
+    ext::shared_ptr<PiecewiseDefaultCurve<HazardRate, BackwardFlat> > curve =
+        ext::make_shared<PiecewiseDefaultCurve<HazardRate, BackwardFlat> >(
+            today, helpers, dayCounter);
+    curve->enableExtrapolation();
+    Handle<DefaultProbabilityTermStructure> probabilityCurve(curve);
+
+    curve->nodes(); // triggers the bootstrap
+    for (Size i = 0; i < helpers.size(); ++i) {
+        Real error = std::fabs(helpers[i]->impliedQuote() - spreads[i]);
+        if (error > 1.0e-10)
+            BOOST_ERROR("failed to reprice helper " << i << ":"
+                        << "\n    implied spread: " << helpers[i]->impliedQuote()
+                        << "\n    quoted spread:  " << spreads[i]);
+    }
+
+    ext::shared_ptr<IsdaCdsEngine> engine = ext::make_shared<IsdaCdsEngine>(
+        probabilityCurve, recoveryRate, discountCurve);
+
+    std::vector<ext::shared_ptr<CreditDefaultSwap> > book;
+    for (Integer n = 1; n <= 8; ++n) {
+        for (Rate coupon : {0.01, 0.05}) {
+            book.push_back(MakeCreditDefaultSwap(n * Years, coupon)
+                           .withNominal(1000000.0 * n)
+                           .withSide(n % 2 == 0 ? Protection::Buyer : Protection::Seller)
+                           .withPricingEngine(engine));
+        }
+    }
+
+    Real tolerance = 1.0e-10;
+    for (Size k = 0; k < 2; ++k) {
+        std::vector<CreditDefaultSwap::results> results = engine->calculate(book);
+        for (Size i = 0; i < book.size(); ++i) {
+            Real npv = book[i]->NPV();
+            if (std::fabs(results[i].value - npv) > tolerance * book[i]->notional())
+                BOOST_ERROR("batch and single NPV differ for swap " << i << ":"
+                            << std::setprecision(12)
+                            << "\n    batch:  " << results[i].value
+                            << "\n    single: " << npv);
+            Rate fairSpread = book[i]->fairSpread();
+            if (std::fabs(results[i].fairSpread - fairSpread) > tolerance)
+                BOOST_ERROR("batch and single fair spread differ for swap " << i << ":"
+                            << std::setprecision(12)
+                            << "\n    batch:  " << results[i].fairSpread
+                            << "\n    single: " << fairSpread);
+        }
+        // bootstrap again on a different quote and reprice
+        quotes[2]->setValue(spreads[2] + 0.0010);
+    }
+}
+
 void CreditDefaultSwapTest::testAccrualRebateAmounts() {
 
     BOOST_TEST_MESSAGE("Testing accrual rebate amounts on credit default swaps...");
@@ -755,6 +843,7 @@ test_suite* CreditDefaultSwapTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&CreditDefaultSwapTest::testFairSpread));
     suite->add(QUANTLIB_TEST_CASE(&CreditDefaultSwapTest::testFairUpfront));
     suite->add(QUANTLIB_TEST_CASE(&CreditDefaultSwapTest::testIsdaEngine));
+    suite->add(QUANTLIB_TEST_CASE(&CreditDefaultSwapTest::testIsdaEngineBook));
     suite->add(QUANTLIB_TEST_CASE(&CreditDefaultSwapTest::testAccrualRebateAmounts));
     return suite;
 }
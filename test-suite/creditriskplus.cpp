@@ -20,6 +20,7 @@
 #include "creditriskplus.hpp"
 #include "utilities.hpp"
 #include <ql/experimental/risk/creditriskplus.hpp>
+#include <ql/experimental/risk/fftcreditriskplus.hpp>
 #include <ql/math/comparison.hpp>
 
 using namespace QuantLib;
@@ -119,8 +120,159 @@ void CreditRiskPlusTest::testReferenceValues() {
                    << cr.lossQuantile(0.99) << ", should be 250)");
 }
 
-test_suite *CreditRiskPlusTest::suite() {
+void CreditRiskPlusTest::testFourierInversion() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing Fourier inversion of the credit risk plus model...");
+
+    // single sector with full weights, compared with the recursion
+
+    Size m = 500;
+    std::vector<Real> exposure(m), pd(m);
+    std::vector<Size> sector(m, 0);
+    std::vector<std::vector<FFTCreditRiskPlus::SectorWeight> > weights(
+        m, std::vector<FFTCreditRiskPlus::SectorWeight>(
+               1, FFTCreditRiskPlus::SectorWeight(0, 1.0)));
+    for (Size i = 0; i < m; ++i) {
+        exposure[i] = 0.37 + 0.81 * (i % 11);
+        pd[i] = 0.01 + 0.002 * (i % 17);
+    }
+    std::vector<Real> relativeDefaultVariance(1, 0.5);
+    Real unit = 0.25;
+
+    CreditRiskPlus recursion(exposure, pd, sector, relativeDefaultVariance,
+                             Matrix(1, 1, 1.0), unit);
+    FFTCreditRiskPlus fourier(exposure, pd, weights,
+                              relativeDefaultVariance, unit);
+
+    Size n = std::min(recursion.loss().size(), fourier.loss().size());
+    for (Size k = 0; k < n; ++k) {
+        if (std::fabs(recursion.loss()[k] - fourier.loss()[k]) > 1.0e-12)
+            BOOST_FAIL("failed to reproduce loss distribution of "
+                       "recursion at " << k << " units:"
+                       << std::setprecision(12)
+                       << "\n    recursion: " << recursion.loss()[k]
+                       << "\n    fourier:   " << fourier.loss()[k]);
+    }
+
+    // several sectors with sparse weights and idiosyncratic parts
+
+    m = 300;
+    exposure.resize(m);
+    pd.resize(m);
+    weights.assign(m, std::vector<FFTCreditRiskPlus::SectorWeight>());
+    for (Size i = 0; i < m; ++i) {
+        exposure[i] = unit * (1 + i % 7);
+        pd[i] = 0.005 + 0.001 * (i % 13);
+        weights[i].push_back(FFTCreditRiskPlus::SectorWeight(i % 3, 0.5));
+        if (i % 2 == 0)
+            weights[i].push_back(
+                FFTCreditRiskPlus::SectorWeight((i + 1) % 3, 0.3));
+    }
+    relativeDefaultVariance.resize(3);
+    relativeDefaultVariance[0] = 0.3;
+    relativeDefaultVariance[1] = 1.0;
+    relativeDefaultVariance[2] = 0.0;
+
+    FFTCreditRiskPlus cr(exposure, pd, weights, relativeDefaultVariance,
+                         unit);
+
+    Real mean = 0.0, second = 0.0;
+    for (Size k = 0; k < cr.loss().size(); ++k) {
+        mean += k * unit * cr.loss()[k];
+        second += k * unit * k * unit * cr.loss()[k];
+    }
+    Real ul = std::sqrt(second - mean * mean);
+    if (std::fabs(mean / cr.expectedLoss() - 1.0) > 1.0e-10)
+        BOOST_FAIL("failed to reproduce expected loss ("
+                   << mean << ", should be " << cr.expectedLoss() << ")");
+    if (std::fabs(ul / cr.unexpectedLoss() - 1.0) > 1.0e-8)
+        BOOST_FAIL("failed to reproduce unexpected loss ("
+                   << ul << ", should be " << cr.unexpectedLoss() << ")");
+
+    FFTCreditRiskPlus finer(exposure, pd, weights, relativeDefaultVariance,
+                            unit, 4 * cr.loss().size());
+    if (std::fabs(finer.expectedShortfall(0.999) -
+                  cr.expectedShortfall(0.999)) > 1.0e-8)
+        BOOST_FAIL("expected shortfall depends on the grid size ("
+                   << cr.expectedShortfall(0.999) << " with "
+                   << cr.loss().size() << " points, "
+                   << finer.expectedShortfall(0.999) << " with "
+                   << finer.loss().size() << " points)");
+
+    // the risk contributions add up to the portfolio figures
+
+    Real levels[] = { 0.9, 0.99, 0.999 };
+    for (Real p : levels) {
+        std::vector<Real> var = cr.valueAtRiskContributions(p);
+        std::vector<Real> es = cr.expectedShortfallContributions(p);
+        Real varSum = 0.0, esSum = 0.0;
+        for (Size i = 0; i < m; ++i) {
+            varSum += var[i];
+            esSum += es[i];
+        }
+        if (std::fabs(varSum / cr.lossQuantile(p) - 1.0) > 1.0e-8)
+            BOOST_FAIL("value at risk contributions at " << p
+                       << " add up to " << varSum << " instead of "
+                       << cr.lossQuantile(p));
+        if (std::fabs(esSum / cr.expectedShortfall(p) - 1.0) > 1.0e-8)
+            BOOST_FAIL("expected shortfall contributions at " << p
+                       << " add up to " << esSum << " instead of "
+                       << cr.expectedShortfall(p));
+    }
+}
+
+void CreditRiskPlusTest::testLargePortfolio() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing credit risk plus model on a 100000-obligor portfolio...");
+
+    const Size m = 100000, sectors = 50;
+
+    std::vector<Real> exposure(m), pd(m);
+    std::vector<std::vector<FFTCreditRiskPlus::SectorWeight> > weights(m);
+    for (Size i = 0; i < m; ++i) {
+        exposure[i] = 1.0 + 0.1 * ((i * 7919) % 1000);
+        pd[i] = 0.001 + 0.0002 * (i % 97);
+        weights[i].push_back(
+            FFTCreditRiskPlus::SectorWeight(i % sectors, 0.6));
+        if ((i * 13) % sectors != i % sectors)
+            weights[i].push_back(
+                FFTCreditRiskPlus::SectorWeight((i * 13) % sectors, 0.3));
+    }
+    std::vector<Real> relativeDefaultVariance(sectors);
+    for (Size j = 0; j < sectors; ++j)
+        relativeDefaultVariance[j] = 0.2 + 0.05 * (j % 10);
+
+    FFTCreditRiskPlus cr(exposure, pd, weights, relativeDefaultVariance,
+                         1.0);
+
+    Real mean = 0.0;
+    for (Size k = 0; k < cr.loss().size(); ++k)
+        mean += k * cr.loss()[k];
+    if (std::fabs(mean / cr.expectedLoss() - 1.0) > 1.0e-8)
+        BOOST_FAIL("failed to reproduce expected loss ("
+                   << mean << ", should be " << cr.expectedLoss() << ")");
+
+    std::vector<Real> es = cr.expectedShortfallContributions(0.999);
+    Real esSum = 0.0;
+    for (Size i = 0; i < m; ++i)
+        esSum += es[i];
+    // the round-off of the transforms is larger relative to the
+    // tail probabilities on this grid
+    if (std::fabs(esSum / cr.expectedShortfall(0.999) - 1.0) > 1.0e-6)
+        BOOST_FAIL("expected shortfall contributions add up to "
+                   << esSum << " instead of " << cr.expectedShortfall(0.999));
+}
+
+test_suite *CreditRiskPlusTest::suite(SpeedLevel speed) {
     auto* suite = BOOST_TEST_SUITE("Credit risk plus tests");
     suite->add(QUANTLIB_TEST_CASE(&CreditRiskPlusTest::testReferenceValues));
+    suite->add(QUANTLIB_TEST_CASE(&CreditRiskPlusTest::testFourierInversion));
+
+    if (speed == Slow) {
+        suite->add(QUANTLIB_TEST_CASE(&CreditRiskPlusTest::testLargePortfolio));
+    }
+
     return suite;
 }
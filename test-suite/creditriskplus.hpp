@@ -21,6 +21,7 @@
 #define quantlib_test_creditriskplus_hpp
 
 #include <boost/test/unit_test.hpp>
+#include "speedlevel.hpp"
 
 /* remember to document new and/or updated tests in the Doxygen
    comment block of the corresponding class */
@@ -28,7 +29,9 @@
 class CreditRiskPlusTest {
   public:
     static void testReferenceValues();
-    static boost::unit_test_framework::test_suite *suite();
+    static void testFourierInversion();
+    static void testLargePortfolio();
+    static boost::unit_test_framework::test_suite *suite(SpeedLevel);
 };
 
 #endif
@@ -102,12 +102,52 @@ void FastFourierTransformTest::testInverse() {
 
 }
 
+void FastFourierTransformTest::testFractional() {
+    BOOST_TEST_MESSAGE("Testing fractional Fourier transform...");
+    typedef std::complex<Real> cx;
+
+    // power-of-two and other sizes; alpha = 1/n gives the DFT
+    const Size sizes[] = { 1, 2, 5, 8, 12, 37 };
+    for (Size n : sizes) {
+        std::vector<cx> x(n);
+        for (Size j = 0; j < n; ++j)
+            x[j] = cx(std::cos(0.7*j) + 0.1*j, std::sin(1.3*j) - 0.05*j);
+
+        const Real alphas[] = { 1.0/n, 0.37/n, 0.013, -0.25 };
+        for (Real alpha : alphas) {
+            FractionalFourierTransform frft(n, alpha);
+            std::vector<cx> y(n);
+            frft.transform(x.begin(), x.end(), y.begin());
+
+            Real scale = 0.0;
+            for (Size j = 0; j < n; ++j)
+                scale += std::abs(x[j]);
+
+            for (Size k = 0; k < n; ++k) {
+                cx expected(0.0, 0.0);
+                for (Size j = 0; j < n; ++j) {
+                    const Real phase = -2.0*M_PI*alpha*Real(j*k);
+                    expected += x[j]*cx(std::cos(phase), std::sin(phase));
+                }
+                if (std::abs(y[k] - expected) > 1.0e-12*scale)
+                    BOOST_ERROR("failed to reproduce fractional DFT"
+                                << "\n    size:       " << n
+                                << "\n    alpha:      " << alpha
+                                << "\n    index:      " << k
+                                << std::setprecision(12)
+                                << "\n    calculated: " << y[k]
+                                << "\n    expected:   " << expected);
+            }
+        }
+    }
+}
 
 
 test_suite* FastFourierTransformTest::suite() {
     auto* suite = BOOST_TEST_SUITE("fast fourier transform tests");
     suite->add(QUANTLIB_TEST_CASE(&FastFourierTransformTest::testSimple));
     suite->add(QUANTLIB_TEST_CASE(&FastFourierTransformTest::testInverse));
+    suite->add(QUANTLIB_TEST_CASE(&FastFourierTransformTest::testFractional));
     return suite;
 }
 
@@ -30,6 +30,7 @@ class FastFourierTransformTest {
   public:
     static void testSimple();
     static void testInverse();
+    static void testFractional();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -37,6 +37,10 @@
 #include <ql/models/equity/hestonmodel.hpp>
 #include <ql/termstructures/yield/zerocurve.hpp>
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
+#include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
+#include <ql/pricingengines/vanilla/fdhestonvanillaengine.hpp>
+#include <ql/pricingengines/vanilla/analytichestonengine.hpp>
+#include <ql/instruments/europeanoption.hpp>
 #include <ql/pricingengines/vanilla/mchestonhullwhiteengine.hpp>
 #include <ql/methods/finitedifferences/finitedifferencemodel.hpp>
 #include <ql/math/matrixutilities/gmres.hpp>
@@ -62,6 +66,8 @@
 #include <ql/methods/finitedifferences/solvers/fdmhestonsolver.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmndimsolver.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmrichardsonextrapolation.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmsparsegridcombination.hpp>
 #include <ql/methods/finitedifferences/solvers/fdm3dimsolver.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmamericanstepcondition.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
@@ -1438,6 +1444,490 @@ void FdmLinearOpTest::testCrankNicolsonWithDamping() {
     }
 }
 
+void FdmLinearOpTest::testMultiplePayoffsRollback() {
+
+    BOOST_TEST_MESSAGE("Testing rollback of several payoffs at once...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual365Fixed();
+    Date today = Date(22, February, 2018);
+    Settings::instance().evaluationDate() = today;
+
+    ext::shared_ptr<BlackScholesMertonProcess> process(
+        new BlackScholesMertonProcess(
+            Handle<Quote>(ext::make_shared<SimpleQuote>(100.0)),
+            Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, 0.25, dc))));
+
+    const Time maturity = 1.0;
+    const Size tGrid = 50, dampingSteps = 2;
+
+    const ext::shared_ptr<FdmMesher> mesher(
+        new FdmMesherComposite(ext::make_shared<FdmBlackScholesMesher>(
+            200, process, maturity, 100.0)));
+
+    const ext::shared_ptr<FdmLinearOpComposite> op(
+        ext::make_shared<FdmBlackScholesOp>(mesher, process, 100.0));
+
+    const Real strikes[] = { 80.0, 90.0, 100.0, 110.0, 120.0 };
+
+    // American puts with an additional stopping time and European
+    // puts without conditions
+    std::vector<Array> values;
+    std::vector<Time> stoppingTimes;
+    std::vector<ext::shared_ptr<FdmStepConditionComposite> > conditions;
+    for (Size i = 0; i < LENGTH(strikes); ++i) {
+        const ext::shared_ptr<FdmInnerValueCalculator> calculator(
+            ext::make_shared<FdmLogInnerValue>(
+                ext::make_shared<PlainVanillaPayoff>(Option::Put, strikes[i]),
+                mesher, 0));
+
+        Array rhs(mesher->layout()->size());
+        const FdmLinearOpIterator endIter = mesher->layout()->end();
+        for (FdmLinearOpIterator iter = mesher->layout()->begin();
+             iter != endIter; ++iter)
+            rhs[iter.index()] = calculator->avgInnerValue(iter, maturity);
+        values.push_back(rhs);
+
+        if (i % 2 == 0) {
+            stoppingTimes.push_back(0.3 + 0.1 * i);
+            FdmStepConditionComposite::Conditions c(
+                1, ext::make_shared<FdmAmericanStepCondition>(
+                       mesher, calculator));
+            conditions.push_back(ext::make_shared<FdmStepConditionComposite>(
+                std::list<std::vector<Time> >(
+                    1, std::vector<Time>(1, stoppingTimes.back())),
+                c));
+        } else {
+            conditions.push_back(ext::shared_ptr<FdmStepConditionComposite>());
+        }
+    }
+
+    const FdmSchemeDesc schemes[] = { FdmSchemeDesc::Douglas(),
+                                      FdmSchemeDesc::CrankNicolson(),
+                                      FdmSchemeDesc::ImplicitEuler(),
+                                      FdmSchemeDesc::TrBDF2() };
+
+    for (const auto& scheme : schemes) {
+        std::vector<Array> batch(values);
+        FdmBackwardSolver(op, FdmBoundaryConditionSet(),
+                          ext::shared_ptr<FdmStepConditionComposite>(), scheme)
+            .rollback(batch, conditions, maturity, 0.0, tGrid, dampingSteps);
+
+        for (Size i = 0; i < LENGTH(strikes); ++i) {
+            // the batch is stepped through the stopping times of all
+            // the conditions, so they are needed for each single rollback
+            FdmStepConditionComposite::Conditions c;
+            if (conditions[i] != nullptr)
+                c.push_back(conditions[i]);
+            const ext::shared_ptr<FdmStepConditionComposite> condition(
+                ext::make_shared<FdmStepConditionComposite>(
+                    std::list<std::vector<Time> >(1, stoppingTimes), c));
+
+            Array expected(values[i]);
+            FdmBackwardSolver(op, FdmBoundaryConditionSet(),
+                              condition, scheme)
+                .rollback(expected, maturity, 0.0, tGrid, dampingSteps);
+
+            for (Size j = 0; j < expected.size(); ++j) {
+                if (std::fabs(batch[i][j] - expected[j]) > 1e-12) {
+                    BOOST_FAIL("batch rollback differs from single rollback"
+                               << "\n scheme:     " << scheme.type
+                               << "\n strike:     " << strikes[i]
+                               << "\n node:       " << j
+                               << std::setprecision(14)
+                               << "\n expected:   " << expected[j]
+                               << "\n calculated: " << batch[i][j]);
+                }
+            }
+        }
+    }
+}
+
+void FdmLinearOpTest::testAdaptiveRollback() {
+
+    BOOST_TEST_MESSAGE("Testing adaptive rollback...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual365Fixed();
+    Date today = Date(22, February, 2018);
+    Settings::instance().evaluationDate() = today;
+
+    ext::shared_ptr<BlackScholesMertonProcess> process(
+        new BlackScholesMertonProcess(
+            Handle<Quote>(ext::make_shared<SimpleQuote>(100.0)),
+            Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, 0.25, dc))));
+
+    const Time maturity = 1.0;
+    const Size referenceSteps = 2000, dampingSteps = 2;
+    const Real tolerance = 1e-5;
+
+    const ext::shared_ptr<FdmMesher> mesher(
+        new FdmMesherComposite(ext::make_shared<FdmBlackScholesMesher>(
+            200, process, maturity, 100.0)));
+
+    const ext::shared_ptr<FdmLinearOpComposite> op(
+        ext::make_shared<FdmBlackScholesOp>(mesher, process, 100.0));
+
+    const ext::shared_ptr<FdmInnerValueCalculator> calculator(
+        ext::make_shared<FdmLogInnerValue>(
+            ext::make_shared<PlainVanillaPayoff>(Option::Put, 100.0),
+            mesher, 0));
+
+    Array payoff(mesher->layout()->size());
+    const FdmLinearOpIterator endIter = mesher->layout()->end();
+    for (FdmLinearOpIterator iter = mesher->layout()->begin();
+         iter != endIter; ++iter)
+        payoff[iter.index()] = calculator->avgInnerValue(iter, maturity);
+
+    // European put without condition and American put with an
+    // additional stopping time, which has to be hit exactly
+    const std::vector<Time> stoppingTimes(1, 0.37);
+    const ext::shared_ptr<FdmStepConditionComposite> conditions[] = {
+        ext::shared_ptr<FdmStepConditionComposite>(),
+        ext::make_shared<FdmStepConditionComposite>(
+            std::list<std::vector<Time> >(1, stoppingTimes),
+            FdmStepConditionComposite::Conditions(
+                1, ext::make_shared<FdmAmericanStepCondition>(
+                       mesher, calculator)))
+    };
+
+    const FdmSchemeDesc schemes[] = { FdmSchemeDesc::Douglas(),
+                                      FdmSchemeDesc::CrankNicolson(),
+                                      FdmSchemeDesc::TrBDF2() };
+
+    const Array& x = mesher->locations(0);
+
+    for (const auto& condition : conditions) {
+        for (const auto& scheme : schemes) {
+            FdmBackwardSolver solver(op, FdmBoundaryConditionSet(),
+                                     condition, scheme);
+
+            Array expected(payoff);
+            solver.rollback(expected, maturity, 0.0,
+                            referenceSteps, dampingSteps);
+
+            Array calculated(payoff);
+            const Size steps = solver.adaptiveRollback(
+                calculated, maturity, 0.0, tolerance, 10, dampingSteps);
+
+            // the early exercise is only checked at the end of each
+            // (half) step, so that the American error is of first order
+            // in the number of steps: a uniform rollback needs about
+            // 600 steps to come within 1.2e-3 of the reference
+            const Size maxSteps =
+                condition ? referenceSteps/5 : referenceSteps/10;
+            const Real maxError = condition ? 2e-3 : 1e-3;
+
+            if (steps <= dampingSteps || steps > maxSteps) {
+                BOOST_FAIL("unexpected number of adaptive steps"
+                           << "\n scheme: " << scheme.type
+                           << "\n steps:  " << steps);
+            }
+
+            for (Size i = 0; i < x.size(); ++i) {
+                if (std::fabs(x[i] - std::log(100.0)) < 0.5
+                    && std::fabs(calculated[i] - expected[i]) > maxError) {
+                    BOOST_FAIL("adaptive rollback differs from "
+                               "fine uniform rollback"
+                               << "\n scheme:     " << scheme.type
+                               << "\n spot:       " << std::exp(x[i])
+                               << "\n steps:      " << steps
+                               << std::setprecision(10)
+                               << "\n expected:   " << expected[i]
+                               << "\n calculated: " << calculated[i]);
+                }
+            }
+        }
+    }
+}
+
+namespace {
+
+    // additive error expansion, for which the combination technique
+    // gives the same error as the full grid of the same level
+    Real additiveErrorPrice(const std::vector<Size>& l) {
+        const Real c[] = { 1.3, 0.7, 2.1 };
+        Real price = 5.0;
+        for (Size i=0; i < l.size(); ++i)
+            price += c[i]*std::pow(4.0, -Real(l[i]));
+        return price;
+    }
+
+    class FdEuropeanPutPricer {
+      public:
+        FdEuropeanPutPricer(
+            ext::shared_ptr<GeneralizedBlackScholesProcess> process,
+            ext::shared_ptr<VanillaOption> option)
+        : process_(std::move(process)), option_(std::move(option)) {}
+
+        Real operator()(Size refinement) const {
+            option_->setPricingEngine(
+                ext::make_shared<FdBlackScholesVanillaEngine>(
+                    process_, 25*refinement, 50*refinement));
+            return option_->NPV();
+        }
+      private:
+        const ext::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        const ext::shared_ptr<VanillaOption> option_;
+    };
+
+    class FdHestonPutPricer {
+      public:
+        FdHestonPutPricer(ext::shared_ptr<HestonModel> model,
+                          ext::shared_ptr<StrikedTypePayoff> payoff,
+                          ext::shared_ptr<Exercise> exercise)
+        : model_(std::move(model)), payoff_(std::move(payoff)),
+          exercise_(std::move(exercise)) {}
+
+        // a new option for each grid, as the grids might be priced
+        // concurrently
+        Real operator()(const std::vector<Size>& l) const {
+            VanillaOption option(payoff_, exercise_);
+            option.setPricingEngine(
+                ext::make_shared<FdHestonVanillaEngine>(
+                    model_, 50, 5*(Size(1) << l[0]), 3*(Size(1) << l[1])));
+            return option.NPV();
+        }
+      private:
+        const ext::shared_ptr<HestonModel> model_;
+        const ext::shared_ptr<StrikedTypePayoff> payoff_;
+        const ext::shared_ptr<Exercise> exercise_;
+    };
+}
+
+void FdmLinearOpTest::testSparseGridCombination() {
+
+    BOOST_TEST_MESSAGE("Testing sparse-grid combination technique...");
+
+    const Size dimensions = 3;
+    const FdmSparseGridCombination combination(
+        &additiveErrorPrice, dimensions);
+
+    for (Size level = 1; level < 7; ++level) {
+        std::vector<std::vector<Size> > levels;
+        std::vector<Real> coefficients;
+        combination.subgrids(level, levels, coefficients);
+
+        const Real sum = std::accumulate(
+            coefficients.begin(), coefficients.end(), 0.0);
+        if (std::fabs(sum - 1.0) > 1e-12)
+            BOOST_FAIL("combination coefficients do not sum to one"
+                       << "\n level: " << level
+                       << "\n sum:   " << sum);
+
+        const Real calculated = combination(level);
+        const Real expected = additiveErrorPrice(
+            std::vector<Size>(dimensions, level));
+
+        if (std::fabs(calculated - expected) > 1e-12)
+            BOOST_FAIL("combined price differs from full-grid price"
+                       << std::setprecision(14)
+                       << "\n level:      " << level
+                       << "\n expected:   " << expected
+                       << "\n calculated: " << calculated);
+    }
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual365Fixed();
+    Date today = Date(22, February, 2018);
+    Settings::instance().evaluationDate() = today;
+
+    const ext::shared_ptr<HestonModel> model(
+        ext::make_shared<HestonModel>(
+            ext::make_shared<HestonProcess>(
+                Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+                Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+                Handle<Quote>(ext::make_shared<SimpleQuote>(100.0)),
+                0.04, 1.5, 0.04, 0.3, -0.6)));
+
+    const ext::shared_ptr<StrikedTypePayoff> payoff(
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 105.0));
+    const ext::shared_ptr<Exercise> exercise(
+        ext::make_shared<EuropeanExercise>(today + Period(1, Years)));
+
+    VanillaOption option(payoff, exercise);
+    option.setPricingEngine(ext::make_shared<AnalyticHestonEngine>(model));
+    const Real expected = option.NPV();
+
+    const FdHestonPutPricer pricer(model, payoff, exercise);
+    const FdmSparseGridCombination heston(pricer, 2);
+
+    const Size level = 5;
+    const Real calculated = heston(level);
+    const Real fullGrid = pricer(std::vector<Size>(2, level));
+
+    const Real tolerance = 5e-3;
+    if (std::fabs(calculated - expected) > tolerance)
+        BOOST_FAIL("failed to reproduce Heston price "
+                   "with the combination technique"
+                   << std::setprecision(10)
+                   << "\n level:      " << level
+                   << "\n full grid:  " << fullGrid
+                   << "\n expected:   " << expected
+                   << "\n calculated: " << calculated);
+
+    if (std::fabs(calculated - fullGrid) > tolerance)
+        BOOST_FAIL("combined Heston price differs from full-grid price"
+                   << std::setprecision(10)
+                   << "\n level:      " << level
+                   << "\n full grid:  " << fullGrid
+                   << "\n calculated: " << calculated);
+}
+
+void FdmLinearOpTest::testRichardsonExtrapolation() {
+
+    BOOST_TEST_MESSAGE("Testing Richardson extrapolation "
+                       "of finite-difference prices...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual365Fixed();
+    Date today = Date(22, February, 2018);
+    Settings::instance().evaluationDate() = today;
+
+    const ext::shared_ptr<BlackScholesMertonProcess> process(
+        new BlackScholesMertonProcess(
+            Handle<Quote>(ext::make_shared<SimpleQuote>(100.0)),
+            Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, 0.25, dc))));
+
+    const ext::shared_ptr<VanillaOption> option(
+        ext::make_shared<EuropeanOption>(
+            ext::make_shared<PlainVanillaPayoff>(Option::Put, 105.0),
+            ext::make_shared<EuropeanExercise>(today + Period(1, Years))));
+
+    option->setPricingEngine(
+        ext::make_shared<AnalyticEuropeanEngine>(process));
+    const Real expected = option->NPV();
+
+    const Real tolerance = 1e-3;
+    const Real orders[] = { 2.0, Null<Real>() };
+    for (Real order : orders) {
+        const FdmRichardsonExtrapolation extrapolation(
+            FdEuropeanPutPricer(process, option), order);
+
+        const Real calculated = extrapolation(tolerance);
+        const Real finest = extrapolation.price(extrapolation.refinement());
+
+        if (std::fabs(calculated - expected) > tolerance
+            || std::fabs(calculated - expected)
+                > std::fabs(finest - expected))
+            BOOST_FAIL("failed to extrapolate finite-difference prices"
+                       << std::setprecision(10)
+                       << "\n order:        " << order
+                       << "\n refinement:   " << extrapolation.refinement()
+                       << "\n expected:     " << expected
+                       << "\n finest grid:  " << finest
+                       << "\n extrapolated: " << calculated);
+    }
+}
+
+void FdmLinearOpTest::testOperatorFactorisationCache() {
+
+    BOOST_TEST_MESSAGE("Testing reuse of operator factorisations...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual365Fixed();
+    Date today = Date(22, February, 2018);
+    Settings::instance().evaluationDate() = today;
+
+    const ext::shared_ptr<SimpleQuote> vol(
+        ext::make_shared<SimpleQuote>(0.25));
+    ext::shared_ptr<BlackScholesMertonProcess> process(
+        new BlackScholesMertonProcess(
+            Handle<Quote>(ext::make_shared<SimpleQuote>(100.0)),
+            Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.05, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, vol, dc))));
+
+    const Time maturity = 1.0;
+    const ext::shared_ptr<FdmMesher> mesher(
+        new FdmMesherComposite(ext::make_shared<FdmBlackScholesMesher>(
+            100, process, maturity, 100.0)));
+
+    // the stored factorisation must give the same solution
+    const TripleBandLinearOp op = SecondDerivativeOp(0, mesher).mult(
+        Array(mesher->layout()->size(), 0.5));
+    Array r(mesher->layout()->size());
+    for (Size i=0; i < r.size(); ++i)
+        r[i] = std::sin(0.1*i);
+
+    TripleBandFactorisation factorisation;
+    const Real dts[] = { 0.01, 0.01, 0.02, 0.01 };
+    for (Real dt : dts) {
+        const Array expected = op.solve_splitting(r, -dt);
+        const Array calculated = op.solve_splitting(
+            r, -dt, 1.0, factorisation);
+        for (Size i=0; i < r.size(); ++i) {
+            if (expected[i] != calculated[i])
+                BOOST_FAIL("factorised solve differs from plain solve"
+                           << std::setprecision(16)
+                           << "\n dt:         " << dt
+                           << "\n node:       " << i
+                           << "\n expected:   " << expected[i]
+                           << "\n calculated: " << calculated[i]);
+        }
+    }
+
+    // an operator with constant coefficients must still follow
+    // changes of the market data
+    const ext::shared_ptr<FdmInnerValueCalculator> calculator(
+        ext::make_shared<FdmLogInnerValue>(
+            ext::make_shared<PlainVanillaPayoff>(Option::Put, 100.0),
+            mesher, 0));
+    Array payoff(mesher->layout()->size());
+    const FdmLinearOpIterator endIter = mesher->layout()->end();
+    for (FdmLinearOpIterator iter = mesher->layout()->begin();
+         iter != endIter; ++iter)
+        payoff[iter.index()] = calculator->avgInnerValue(iter, maturity);
+
+    const ext::shared_ptr<FdmLinearOpComposite> bsOp(
+        ext::make_shared<FdmBlackScholesOp>(mesher, process, 100.0));
+
+    const FdmSchemeDesc schemes[] = { FdmSchemeDesc::Douglas(),
+                                      FdmSchemeDesc::ImplicitEuler() };
+    const Volatility vols[] = { 0.25, 0.35 };
+
+    for (const auto& scheme : schemes) {
+        for (Real v : vols) {
+            vol->setValue(v);
+
+            Array calculated(payoff);
+            FdmBackwardSolver(bsOp, FdmBoundaryConditionSet(),
+                              ext::shared_ptr<FdmStepConditionComposite>(),
+                              scheme).rollback(calculated, maturity, 0.0,
+                                               50, 0);
+
+            Array expected(payoff);
+            FdmBackwardSolver(
+                ext::make_shared<FdmBlackScholesOp>(mesher, process, 100.0),
+                FdmBoundaryConditionSet(),
+                ext::shared_ptr<FdmStepConditionComposite>(),
+                scheme).rollback(expected, maturity, 0.0, 50, 0);
+
+            for (Size i=0; i < payoff.size(); ++i) {
+                if (std::fabs(expected[i] - calculated[i]) > 1e-12)
+                    BOOST_FAIL("reused operator differs from new operator"
+                               << std::setprecision(14)
+                               << "\n scheme:     " << scheme.type
+                               << "\n volatility: " << v
+                               << "\n node:       " << i
+                               << "\n expected:   " << expected[i]
+                               << "\n calculated: " << calculated[i]);
+            }
+        }
+    }
+}
+
 void FdmLinearOpTest::testSpareMatrixReference() {
 #ifndef QL_NO_UBLAS_SUPPORT
     BOOST_TEST_MESSAGE("Testing SparseMatrixReference type...");
@@ -1740,6 +2230,14 @@ test_suite* FdmLinearOpTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testGMRES));
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testCrankNicolsonWithDamping));
+    suite->add(
+        QUANTLIB_TEST_CASE(&FdmLinearOpTest::testMultiplePayoffsRollback));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testAdaptiveRollback));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testSparseGridCombination));
+    suite->add(QUANTLIB_TEST_CASE(
+        &FdmLinearOpTest::testRichardsonExtrapolation));
+    suite->add(QUANTLIB_TEST_CASE(
+        &FdmLinearOpTest::testOperatorFactorisationCache));
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testSpareMatrixReference));
     suite->add(
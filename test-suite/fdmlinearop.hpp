@@ -43,6 +43,11 @@ public:
     static void testBiCGstab();
     static void testGMRES();
     static void testCrankNicolsonWithDamping();
+    static void testMultiplePayoffsRollback();
+    static void testAdaptiveRollback();
+    static void testSparseGridCombination();
+    static void testRichardsonExtrapolation();
+    static void testOperatorFactorisationCache();
     static void testSpareMatrixReference();
     static void testSparseMatrixZeroAssignment();
     static void testFdmMesherIntegral();
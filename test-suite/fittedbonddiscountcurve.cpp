@@ -27,13 +27,55 @@
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/canada.hpp>
+#include <ql/time/calendars/nullcalendar.hpp>
 #include <ql/time/daycounters/actualactual.hpp>
 #include <ql/math/initializers.hpp>
+#include <ql/math/optimization/bfgs.hpp>
+#include <ql/math/optimization/levenbergmarquardt.hpp>
 #include <ql/pricingengines/bond/discountingbondengine.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
 
+namespace fitted_bond_discount_curve_test {
+
+    // fixed-rate bonds priced on a Nelson-Siegel curve with the given
+    // parameters, so that a fit can reproduce them exactly
+    std::vector<ext::shared_ptr<BondHelper> > makeHelpers(
+                                                  const Date& today,
+                                                  const Array& parameters) {
+        Integer maturities[] = { 1, 2, 3, 4, 5, 7, 10, 12, 15, 20, 25, 30 };
+        std::vector<ext::shared_ptr<Bond> > bonds;
+        std::vector<ext::shared_ptr<SimpleQuote> > quotes;
+        std::vector<ext::shared_ptr<BondHelper> > helpers;
+        for (Size i=0; i<LENGTH(maturities); ++i) {
+            Schedule schedule(today, today + maturities[i]*Years,
+                              Period(Annual), TARGET(), Unadjusted,
+                              Unadjusted, DateGeneration::Backward, false);
+            bonds.push_back(ext::make_shared<FixedRateBond>(
+                0, 100.0, schedule,
+                std::vector<Rate>(1, 0.02 + 0.001*i), Actual365Fixed()));
+            quotes.push_back(ext::make_shared<SimpleQuote>(100.0));
+            helpers.push_back(ext::make_shared<BondHelper>(
+                                     Handle<Quote>(quotes.back()), bonds.back()));
+        }
+
+        // with no evaluations, the curve uses the given parameters
+        Handle<YieldTermStructure> curve(
+            ext::make_shared<FittedBondDiscountCurve>(
+                today, helpers, Actual365Fixed(), NelsonSiegelFitting(),
+                1.0e-10, 0, parameters));
+        ext::shared_ptr<PricingEngine> engine =
+            ext::make_shared<DiscountingBondEngine>(curve);
+        for (Size i=0; i<bonds.size(); ++i) {
+            bonds[i]->setPricingEngine(engine);
+            quotes[i]->setValue(bonds[i]->cleanPrice());
+        }
+        return helpers;
+    }
+
+}
+
 void FittedBondDiscountCurveTest::testEvaluation() {
 
     BOOST_TEST_MESSAGE("Testing that fitted bond curves work as evaluators...");
@@ -197,9 +239,275 @@ void FittedBondDiscountCurveTest::testFlatExtrapolation() {
 }
 
 
+void FittedBondDiscountCurveTest::testDiscountGradients() {
+
+    BOOST_TEST_MESSAGE("Testing gradients of fitted discount functions...");
+
+    std::vector<Time> knots = { -30.0, -20.0, 0.0, 5.0, 10.0, 15.0,
+                                20.0, 25.0, 30.0, 40.0, 50.0 };
+
+    std::vector<ext::shared_ptr<FittedBondDiscountCurve::FittingMethod> > methods = {
+        ext::make_shared<NelsonSiegelFitting>(),
+        ext::make_shared<NelsonSiegelFitting>(Array(), Array(), 0.5, 20.0),
+        ext::make_shared<SvenssonFitting>(),
+        ext::make_shared<ExponentialSplinesFitting>(true),
+        ext::make_shared<ExponentialSplinesFitting>(false),
+        ext::make_shared<ExponentialSplinesFitting>(true, 7, 0.02),
+        ext::make_shared<CubicBSplinesFitting>(knots, true),
+        ext::make_shared<CubicBSplinesFitting>(knots, false),
+        ext::make_shared<SimplePolynomialFitting>(3, true),
+        ext::make_shared<SimplePolynomialFitting>(3, false)
+    };
+
+    Time times[] = { 0.1, 0.5, 1.0, 2.5, 5.0, 10.0, 17.5, 25.0 };
+    // beyond the cutoff time the extrapolation amplifies the rounding
+    // errors of the differences by (t-t_max)/1e-4, hence the bump size
+    Real h = 1.0e-5;
+    Real tolerance = 1.0e-6;
+
+    for (Size k=0; k<methods.size(); ++k) {
+        const FittedBondDiscountCurve::FittingMethod& method = *methods[k];
+        BOOST_REQUIRE(method.providesDiscountGradient());
+
+        Size n = method.size();
+        Array x(n);
+        for (Size i=0; i<n; ++i)
+            x[i] = 0.01 * (i+1);
+        // keep decay parameters positive and away from zero
+        x[n-1] = 0.3;
+
+        for (Time t : times) {
+            Array gradient(n);
+            method.discountGradient(x, t, gradient);
+            for (Size i=0; i<n; ++i) {
+                Array xp(x), xm(x);
+                xp[i] += h;
+                xm[i] -= h;
+                Real expected =
+                    (method.discount(xp, t) - method.discount(xm, t)) / (2.0*h);
+                if (std::fabs(gradient[i] - expected) >
+                    tolerance * std::max(1.0, std::fabs(expected)))
+                    BOOST_ERROR("failed to reproduce discount gradient:"
+                                << "\n    method:     " << k
+                                << "\n    t:          " << t
+                                << "\n    parameter:  " << i
+                                << "\n    calculated: " << gradient[i]
+                                << "\n    expected:   " << expected);
+            }
+        }
+    }
+}
+
+
+void FittedBondDiscountCurveTest::testCostFunctionGradients() {
+
+    BOOST_TEST_MESSAGE("Testing gradients of the fitting cost function...");
+
+    using namespace fitted_bond_discount_curve_test;
+
+    SavedSettings backup;
+
+    Date today(15, July, 2019);
+    Settings::instance().evaluationDate() = today;
+
+    Array parameters = { 0.04, -0.02, 0.01, 0.4 };
+    std::vector<ext::shared_ptr<BondHelper> > helpers =
+        makeHelpers(today, parameters);
+
+    std::vector<Time> knots = { -30.0, -20.0, 0.0, 5.0, 10.0, 15.0,
+                                20.0, 25.0, 30.0, 40.0, 50.0 };
+    Handle<YieldTermStructure> flat(
+        ext::make_shared<FlatForward>(today, 0.01, Actual365Fixed()));
+
+    std::vector<ext::shared_ptr<FittedBondDiscountCurve::FittingMethod> > methods = {
+        ext::make_shared<NelsonSiegelFitting>(),
+        ext::make_shared<SvenssonFitting>(),
+        ext::make_shared<ExponentialSplinesFitting>(true),
+        ext::make_shared<CubicBSplinesFitting>(knots, true),
+        ext::make_shared<SimplePolynomialFitting>(3, true),
+        ext::make_shared<SpreadFittingMethod>(
+            ext::make_shared<NelsonSiegelFitting>(), flat),
+        ext::make_shared<NelsonSiegelFitting>(
+            Array(), ext::shared_ptr<OptimizationMethod>(), Array(4, 0.5))
+    };
+
+    Real h = 1.0e-6;
+    Real tolerance = 1.0e-6;
+
+    for (Size k=0; k<methods.size(); ++k) {
+        Size n = methods[k]->size();
+        Array x(n);
+        for (Size i=0; i<n; ++i)
+            x[i] = 0.01 * (i+1);
+        x[n-1] = 0.3;
+
+        // with no evaluations, the curve is used as an evaluator and
+        // its cost function is initialized without fitting
+        FittedBondDiscountCurve curve(today, helpers, Actual365Fixed(),
+                                      *methods[k], 1.0e-10, 0, x);
+        const CostFunction& cost = curve.fitResults().costFunction();
+
+        Array values = cost.values(x);
+        Matrix jacobian(values.size(), n);
+        cost.jacobian(jacobian, x);
+        Array gradient(n);
+        Real value = cost.valueAndGradient(gradient, x);
+
+        if (std::fabs(value - std::accumulate(values.begin(), values.end(),
+                                              Real(0.0))) > 1.0e-12)
+            BOOST_ERROR("inconsistent cost function value:"
+                        << "\n    method: " << k
+                        << "\n    value:  " << value);
+
+        for (Size l=0; l<n; ++l) {
+            Array xp(x), xm(x);
+            xp[l] += h;
+            xm[l] -= h;
+            Array vp = cost.values(xp), vm = cost.values(xm);
+            for (Size i=0; i<values.size(); ++i) {
+                Real expected = (vp[i] - vm[i]) / (2.0*h);
+                if (std::fabs(jacobian[i][l] - expected) >
+                    tolerance * std::max(1.0, std::fabs(expected)))
+                    BOOST_ERROR("failed to reproduce cost function Jacobian:"
+                                << "\n    method:     " << k
+                                << "\n    value:      " << i
+                                << "\n    parameter:  " << l
+                                << "\n    calculated: " << jacobian[i][l]
+                                << "\n    expected:   " << expected);
+            }
+            Real expected = (cost.value(xp) - cost.value(xm)) / (2.0*h);
+            if (std::fabs(gradient[l] - expected) >
+                tolerance * std::max(1.0, std::fabs(expected)))
+                BOOST_ERROR("failed to reproduce cost function gradient:"
+                            << "\n    method:     " << k
+                            << "\n    parameter:  " << l
+                            << "\n    calculated: " << gradient[l]
+                            << "\n    expected:   " << expected);
+        }
+    }
+}
+
+
+void FittedBondDiscountCurveTest::testGradientBasedFit() {
+
+    BOOST_TEST_MESSAGE("Testing gradient-based fit of bond curves...");
+
+    using namespace fitted_bond_discount_curve_test;
+
+    SavedSettings backup;
+
+    Date today(15, July, 2019);
+    Settings::instance().evaluationDate() = today;
+
+    Array parameters = { 0.04, -0.02, 0.01, 0.4 };
+    std::vector<ext::shared_ptr<BondHelper> > helpers =
+        makeHelpers(today, parameters);
+
+    // optimizers using the analytic gradient or Jacobian of the cost
+    std::vector<ext::shared_ptr<OptimizationMethod> > optimizers = {
+        ext::make_shared<LevenbergMarquardt>(1.0e-8, 1.0e-8, 1.0e-8, true),
+        ext::make_shared<BFGS>()
+    };
+
+    Array guess = { 0.03, 0.0, 0.0, 0.5 };
+    Real tolerance = 1.0e-4;
+
+    for (Size k=0; k<optimizers.size(); ++k) {
+        NelsonSiegelFitting method(Array(), optimizers[k]);
+        FittedBondDiscountCurve curve(today, helpers, Actual365Fixed(),
+                                      method, 1.0e-10, 10000, guess);
+        Array solution = curve.fitResults().solution();
+        for (Size i=0; i<parameters.size(); ++i) {
+            if (std::fabs(solution[i] - parameters[i]) > tolerance)
+                BOOST_ERROR("failed to reproduce curve parameters:"
+                            << "\n    optimizer:  " << k
+                            << "\n    parameter:  " << i
+                            << "\n    calculated: " << solution[i]
+                            << "\n    expected:   " << parameters[i]
+                            << "\n    iterations: "
+                            << curve.fitResults().numberOfIterations());
+        }
+    }
+}
+
+
+void FittedBondDiscountCurveTest::testSettlementDateCashFlows() {
+
+    BOOST_TEST_MESSAGE("Testing fitted bond curves with coupons paid "
+                       "on the settlement date...");
+
+    SavedSettings backup;
+
+    Date today(15, July, 2019);
+    Settings::instance().evaluationDate() = today;
+
+    // bonds settling today or later, paying a coupon on that date
+    std::vector<ext::shared_ptr<BondHelper> > helpers;
+    Natural settlementDays[] = { 0, 2 };
+    Integer maturities[] = { 2, 5, 10 };
+    for (Natural days : settlementDays) {
+        Date settlement = today + Integer(days)*Days;
+        for (Integer maturity : maturities) {
+            Schedule schedule(settlement - 1*Years, settlement + maturity*Years,
+                              Period(Annual), NullCalendar(), Unadjusted,
+                              Unadjusted, DateGeneration::Backward, false);
+            helpers.push_back(ext::make_shared<BondHelper>(
+                Handle<Quote>(ext::make_shared<SimpleQuote>(100.0)),
+                ext::make_shared<FixedRateBond>(
+                    days, 100.0, schedule, std::vector<Rate>(1, 0.03),
+                    Actual365Fixed())));
+        }
+    }
+
+    Array parameters = { 0.04, -0.02, 0.01, 0.4 };
+
+    // the cost function must use the same cash flows as the bonds
+    // priced on the curve, whatever the settings
+    bool includeReferenceDateEvents[] = { false, true };
+    boost::optional<bool> includeTodaysCashFlows[] = { boost::none,
+                                                       true, false };
+    for (bool includeRefDate : includeReferenceDateEvents) {
+        for (const auto& includeToday : includeTodaysCashFlows) {
+            Settings::instance().includeReferenceDateEvents() =
+                includeRefDate;
+            Settings::instance().includeTodaysCashFlows() = includeToday;
+
+            // with no evaluations, the curve uses the given parameters
+            NelsonSiegelFitting method(Array(helpers.size(), 1.0));
+            FittedBondDiscountCurve curve(today, helpers, Actual365Fixed(),
+                                          method, 1.0e-10, 0, parameters);
+            Array values =
+                curve.fitResults().costFunction().values(parameters);
+
+            for (Size i=0; i<helpers.size(); ++i) {
+                Real expected = helpers[i]->impliedQuote() - 100.0;
+                if (std::fabs(std::sqrt(values[i]) - std::fabs(expected))
+                    > 1.0e-10)
+                    BOOST_ERROR("failed to reproduce bond price error:"
+                                << "\n    bond:            " << i
+                                << "\n    reference date:  "
+                                << includeRefDate
+                                << "\n    today's flows:   "
+                                << (includeToday ? Integer(*includeToday)
+                                                 : Integer(-1))
+                                << "\n    calculated:      "
+                                << std::sqrt(values[i])
+                                << "\n    expected:        "
+                                << std::fabs(expected));
+            }
+        }
+    }
+}
+
+
 test_suite* FittedBondDiscountCurveTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Fitted bond discount curve tests");
     suite->add(QUANTLIB_TEST_CASE(&FittedBondDiscountCurveTest::testEvaluation));
     suite->add(QUANTLIB_TEST_CASE(&FittedBondDiscountCurveTest::testFlatExtrapolation));
+    suite->add(QUANTLIB_TEST_CASE(&FittedBondDiscountCurveTest::testDiscountGradients));
+    suite->add(QUANTLIB_TEST_CASE(&FittedBondDiscountCurveTest::testCostFunctionGradients));
+    suite->add(QUANTLIB_TEST_CASE(&FittedBondDiscountCurveTest::testGradientBasedFit));
+    suite->add(QUANTLIB_TEST_CASE(
+                   &FittedBondDiscountCurveTest::testSettlementDateCashFlows));
     return suite;
 }
@@ -29,6 +29,10 @@ class FittedBondDiscountCurveTest {
   public:
     static void testEvaluation();
     static void testFlatExtrapolation();
+    static void testDiscountGradients();
+    static void testCostFunctionGradients();
+    static void testGradientBasedFit();
+    static void testSettlementDateCashFlows();
     static boost::unit_test_framework::test_suite* suite();
 };
 
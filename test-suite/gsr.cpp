@@ -19,6 +19,7 @@
 
 #include "gsr.hpp"
 #include "utilities.hpp"
+#include <ql/experimental/risk/nettingsetexposure.hpp>
 #include <ql/processes/gsrprocess.hpp>
 #include <ql/models/shortrate/onefactormodels/gsr.hpp>
 #include <ql/instruments/nonstandardswap.hpp>
@@ -27,6 +28,7 @@
 #include <ql/pricingengines/swaption/gaussian1djamshidianswaptionengine.hpp>
 #include <ql/pricingengines/swaption/gaussian1dnonstandardswaptionengine.hpp>
 #include <ql/indexes/swap/euriborswap.hpp>
+#include <ql/termstructures/credit/flathazardrate.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/processes/hullwhiteprocess.hpp>
@@ -285,9 +287,170 @@ void GsrTest::testGsrModel() {
                     << GsrJamNpv << ")");
 }
 
+void GsrTest::testGridCache() {
+
+    BOOST_TEST_MESSAGE("Testing GSR numeraire and zerobond grids...");
+
+    SavedSettings backup;
+
+    Date refDate = Settings::instance().evaluationDate();
+
+    Handle<YieldTermStructure> yts(ext::shared_ptr<YieldTermStructure>(
+        new FlatForward(0, TARGET(), 0.03, Actual365Fixed())));
+    Handle<YieldTermStructure> yts2(ext::shared_ptr<YieldTermStructure>(
+        new FlatForward(0, TARGET(), 0.02, Actual365Fixed())));
+
+    ext::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.01));
+    std::vector<Date> stepDates(1, refDate + 5 * Years);
+    std::vector<Handle<Quote> > vols(2, Handle<Quote>(vol));
+    Handle<Quote> reversion(ext::make_shared<SimpleQuote>(0.01));
+    ext::shared_ptr<Gsr> model(
+        new Gsr(yts, stepDates, vols, reversion, 50.0));
+
+    Real tol = 1E-14;
+
+    const Time times[] = {0.0, 1.0, 4.5, 7.0};
+    for (Size r = 0; r < 2; ++r) {
+        // second round with a changed volatility, the cached grids
+        // must not be used anymore
+        if (r == 1)
+            vol->setValue(0.015);
+        for (Time t : times) {
+            Array z = model->yGrid(7.0, 16, t > 0.0 ? t : 1.0);
+            Array num = model->numeraire(t, z);
+            Array num2 = model->numeraire(t, z, yts2);
+            for (Size i = 0; i < z.size(); ++i) {
+                Real expected = model->numeraire(t, z[i]);
+                Real expected2 = model->numeraire(t, z[i], yts2);
+                if (fabs(num[i] - expected) > tol * expected ||
+                    fabs(num2[i] - expected2) > tol * expected2)
+                    BOOST_ERROR("numeraire on grid differs from pointwise "
+                                "value at t="
+                                << t << ", y=" << z[i] << ": " << num[i]
+                                << " / " << num2[i] << " vs " << expected
+                                << " / " << expected2);
+            }
+            Time T = t + 2.5;
+            Array zb = model->zerobond(T, t, z);
+            Array zb2 = model->zerobond(T, t, z, yts2);
+            for (Size i = 0; i < z.size(); ++i) {
+                Real expected = model->zerobond(T, t, z[i]);
+                Real expected2 = model->zerobond(T, t, z[i], yts2);
+                if (fabs(zb[i] - expected) > tol * expected ||
+                    fabs(zb2[i] - expected2) > tol * expected2)
+                    BOOST_ERROR("zerobond on grid differs from pointwise "
+                                "value at t="
+                                << t << ", T=" << T << ", y=" << z[i] << ": "
+                                << zb[i] << " / " << zb2[i] << " vs "
+                                << expected << " / " << expected2);
+            }
+        }
+    }
+}
+
+void GsrTest::testNettingSetExposure() {
+
+    BOOST_TEST_MESSAGE("Testing Monte Carlo exposure of swaps in the GSR model...");
+
+    SavedSettings backup;
+
+    Handle<YieldTermStructure> yts(ext::shared_ptr<YieldTermStructure>(
+        new FlatForward(0, TARGET(), 0.03, Actual365Fixed())));
+    std::vector<Date> stepDates;
+    std::vector<Real> vols(1, 0.01);
+    std::vector<Real> reversions(1, 0.01);
+    ext::shared_ptr<Gsr> model(
+        new Gsr(yts, stepDates, vols, reversions, 50.0));
+
+    ext::shared_ptr<IborIndex> index(new Euribor6M(yts));
+    ext::shared_ptr<VanillaSwap> payer =
+        MakeVanillaSwap(10 * Years, index, 0.03)
+            .withType(VanillaSwap::Payer)
+            .withNominal(100.0);
+    ext::shared_ptr<VanillaSwap> receiver =
+        MakeVanillaSwap(10 * Years, index, 0.03)
+            .withType(VanillaSwap::Receiver)
+            .withNominal(100.0);
+
+    // at the start of each fixed coupon, the remaining swap is the
+    // underlying of a swaption expiring on the fixing date two days
+    // before, whose price is close to the expected positive exposure
+    std::vector<Date> dates;
+    std::vector<Real> swaptions;
+    const Leg& fixedLeg = payer->fixedLeg();
+    for (Size i = 1; i < fixedLeg.size(); i += 2) {
+        ext::shared_ptr<Coupon> coupon =
+            ext::dynamic_pointer_cast<Coupon>(fixedLeg[i]);
+        Date start = coupon->accrualStartDate();
+        Date expiry = index->fixingDate(start);
+        ext::shared_ptr<VanillaSwap> underlying =
+            MakeVanillaSwap(Period(Integer(fixedLeg.size() - i), Years),
+                            index, 0.03)
+                .withEffectiveDate(start)
+                .withType(VanillaSwap::Payer)
+                .withNominal(100.0);
+        Swaption swaption(underlying,
+                          ext::make_shared<EuropeanExercise>(expiry));
+        swaption.setPricingEngine(ext::make_shared<Gaussian1dSwaptionEngine>(
+            model, 64, 7.0, true, false));
+        dates.push_back(start);
+        swaptions.push_back(swaption.NPV());
+    }
+
+    NettingSetExposure exposure(model, {payer}, dates, 20000, 42);
+    std::vector<Real> epe = exposure.expectedPositiveExposure();
+    std::vector<Real> ene = exposure.expectedNegativeExposure();
+    std::vector<Real> pfe = exposure.potentialFutureExposure(0.95);
+    for (Size k = 0; k < dates.size(); ++k) {
+        if (std::fabs(epe[k] - swaptions[k]) > 0.03 * swaptions[k])
+            BOOST_ERROR("expected exposure on " << dates[k]
+                        << " differs from swaption price:"
+                        << "\n    expected exposure: " << epe[k]
+                        << "\n    swaption:          " << swaptions[k]);
+        if (ene[k] <= 0.0 || pfe[k] <= epe[k])
+            BOOST_ERROR("inconsistent exposures on " << dates[k] << ":"
+                        << "\n    expected positive: " << epe[k]
+                        << "\n    expected negative: " << ene[k]
+                        << "\n    95% potential:     " << pfe[k]);
+    }
+
+    // the exposure of the receiver swap is the negative one of the payer
+    NettingSetExposure mirrored(model, {receiver}, dates, 20000, 42);
+    std::vector<Real> mirroredEpe = mirrored.expectedPositiveExposure();
+    for (Size k = 0; k < dates.size(); ++k) {
+        if (std::fabs(mirroredEpe[k] - ene[k]) > 1.0e-10)
+            BOOST_ERROR("mirrored exposure on " << dates[k] << " differs:"
+                        << "\n    receiver positive: " << mirroredEpe[k]
+                        << "\n    payer negative:    " << ene[k]);
+    }
+
+    Handle<DefaultProbabilityTermStructure> hazard(
+        ext::make_shared<FlatHazardRate>(0, TARGET(), 0.02, Actual365Fixed()));
+    if (std::fabs(mirrored.cva(hazard, 0.4) - exposure.dva(hazard, 0.4)) > 1.0e-10)
+        BOOST_ERROR("receiver CVA differs from payer DVA:"
+                    << "\n    CVA: " << mirrored.cva(hazard, 0.4)
+                    << "\n    DVA: " << exposure.dva(hazard, 0.4));
+
+    // offsetting swaps in the same netting set leave no exposure
+    NettingSetExposure netted(model, {payer, receiver}, dates, 1000, 42);
+    const Matrix& values = netted.values();
+    for (Size k = 0; k < values.rows(); ++k) {
+        for (Size p = 0; p < values.columns(); ++p) {
+            if (std::fabs(values[k][p]) > 1.0e-12)
+                BOOST_FAIL("offsetting swaps don't net on " << dates[k]
+                           << ": " << values[k][p]);
+        }
+    }
+    if (std::fabs(netted.cva(hazard, 0.4)) > 1.0e-12)
+        BOOST_ERROR("non-zero CVA for offsetting swaps: "
+                    << netted.cva(hazard, 0.4));
+}
+
 test_suite *GsrTest::suite() {
     auto* suite = BOOST_TEST_SUITE("GSR model tests");
     suite->add(QUANTLIB_TEST_CASE(&GsrTest::testGsrProcess));
     suite->add(QUANTLIB_TEST_CASE(&GsrTest::testGsrModel));
+    suite->add(QUANTLIB_TEST_CASE(&GsrTest::testGridCache));
+    suite->add(QUANTLIB_TEST_CASE(&GsrTest::testNettingSetExposure));
     return suite;
 }
@@ -29,6 +29,8 @@ class GsrTest {
   public:
     static void testGsrProcess();
     static void testGsrModel();
+    static void testGridCache();
+    static void testNettingSetExposure();
     static void testNonstandardSwaption();
     static void testDummy();
     static boost::unit_test_framework::test_suite *suite();
@@ -20,6 +20,7 @@
 #include "hestonmodel.hpp"
 #include "utilities.hpp"
 #include <ql/experimental/exoticoptions/analyticpdfhestonengine.hpp>
+#include <ql/experimental/variancegamma/ffthestonengine.hpp>
 #include <ql/instruments/dividendbarrieroption.hpp>
 #include <ql/instruments/dividendvanillaoption.hpp>
 #include <ql/math/integrals/gausslobattointegral.hpp>
@@ -28,6 +29,7 @@
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/methods/finitedifferences/operators/numericaldifferentiation.hpp>
 #include <ql/methods/montecarlo/pathgenerator.hpp>
+#include <ql/models/equity/batesmodel.hpp>
 #include <ql/models/equity/hestonmodel.hpp>
 #include <ql/models/equity/hestonmodelhelper.hpp>
 #include <ql/models/equity/piecewisetimedependenthestonmodel.hpp>
@@ -36,7 +38,9 @@
 #include <ql/pricingengines/blackformula.hpp>
 #include <ql/pricingengines/vanilla/analyticdividendeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/analytichestonengine.hpp>
+#include <ql/pricingengines/vanilla/analytichestonhullwhiteengine.hpp>
 #include <ql/pricingengines/vanilla/analyticptdhestonengine.hpp>
+#include <ql/pricingengines/vanilla/batesengine.hpp>
 #include <ql/pricingengines/vanilla/coshestonengine.hpp>
 #include <ql/pricingengines/vanilla/exponentialfittinghestonengine.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
@@ -55,6 +59,9 @@
 #include <ql/time/period.hpp>
 #include <boost/math/special_functions/fpclassify.hpp>
 #include <utility>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -288,6 +295,395 @@ void HestonModelTest::testDAXCalibration() {
     }
 }
 
+#ifdef _OPENMP
+void HestonModelTest::testParallelCalibration() {
+
+    BOOST_TEST_MESSAGE(
+             "Testing parallel evaluation of Heston calibration helpers...");
+
+    SavedSettings backup;
+
+    Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    CalibrationMarketData marketData = getDAXCalibrationMarketData();
+
+    const std::vector<ext::shared_ptr<CalibrationHelper> >& options = marketData.options;
+
+    Array params[2];
+    for (Size k = 0; k < 2; ++k) {
+        const ext::shared_ptr<HestonModel> model(
+            ext::make_shared<HestonModel>(
+                ext::make_shared<HestonProcess>(
+                    marketData.riskFreeTS, marketData.dividendYield,
+                    marketData.s0, 0.1, 1.0, 0.1, 0.5, -0.5)));
+
+        // each helper needs its own engine to be evaluated in parallel
+        for (const auto& option : options)
+            ext::dynamic_pointer_cast<BlackCalibrationHelper>(option)
+                ->setPricingEngine(
+                    ext::make_shared<AnalyticHestonEngine>(model, 64));
+
+        model->enableParallelCalibration(k == 1);
+
+        // evaluate the helpers on several threads even if the
+        // environment limits them
+        const int threads = omp_get_max_threads();
+        omp_set_num_threads(k == 1 ? 4 : 1);
+
+        LevenbergMarquardt om(1e-8, 1e-8, 1e-8);
+        try {
+            model->calibrate(options, om,
+                             EndCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8));
+        } catch (...) {
+            omp_set_num_threads(threads);
+            throw;
+        }
+        omp_set_num_threads(threads);
+        params[k] = model->params();
+    }
+
+    const Real tolerance = 1e-10;
+    for (Size i = 0; i < params[0].size(); ++i) {
+        if (std::fabs(params[0][i] - params[1][i]) > tolerance) {
+            BOOST_ERROR("Failed to reproduce serial calibration"
+                        << "\n    parameter:  " << i
+                        << "\n    serial:     " << params[0][i]
+                        << "\n    parallel:   " << params[1][i]);
+        }
+    }
+}
+#endif
+
+void HestonModelTest::testAnalyticGradientCalibration() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing Heston calibration using analytic gradients...");
+
+    SavedSettings backup;
+
+    Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    CalibrationMarketData marketData = getDAXCalibrationMarketData();
+
+    const std::vector<ext::shared_ptr<CalibrationHelper> >& options = marketData.options;
+
+    const ext::shared_ptr<HestonModel> model(
+        ext::make_shared<HestonModel>(
+            ext::make_shared<HestonProcess>(
+                marketData.riskFreeTS, marketData.dividendYield,
+                marketData.s0, 0.1, 1.0, 0.1, 0.5, -0.5)));
+
+    const ext::shared_ptr<AnalyticHestonEngine> engine =
+        ext::make_shared<AnalyticHestonEngine>(model, 64);
+
+    // check the engine gradient against finite differences
+    const Date maturity = settlementDate + Period(1, Years);
+    const Real strikes[] = { 3000.0, 4468.17, 6000.0 };
+    const Array params = model->params();
+    const Real h = 1e-5;
+    for (Real strike : strikes) {
+        const PlainVanillaPayoff payoff(Option::Call, strike);
+
+        BOOST_REQUIRE(engine->providesGradient());
+        Array gradient;
+        const Real value = engine->valueAndGradient(payoff, maturity, gradient);
+
+        VanillaOption option(ext::make_shared<PlainVanillaPayoff>(payoff),
+                             ext::make_shared<EuropeanExercise>(maturity));
+        option.setPricingEngine(engine);
+        if (std::fabs(option.NPV() - value) > 1e-8) {
+            BOOST_ERROR("Failed to reproduce the engine value"
+                        << "\n    strike:     " << strike
+                        << "\n    calculated: " << value
+                        << "\n    expected:   " << option.NPV());
+        }
+
+        for (Size k = 0; k < params.size(); ++k) {
+            Array bumped = params;
+            bumped[k] += h;
+            model->setParams(bumped);
+            const Real up = option.NPV();
+            bumped[k] -= 2*h;
+            model->setParams(bumped);
+            const Real down = option.NPV();
+            model->setParams(params);
+
+            const Real expected = (up - down)/(2*h);
+            if (std::fabs(gradient[k] - expected) > 1e-4*std::max(1.0, std::fabs(expected))) {
+                BOOST_ERROR("Failed to reproduce the price gradient"
+                            << "\n    strike:     " << strike
+                            << "\n    parameter:  " << k
+                            << "\n    calculated: " << gradient[k]
+                            << "\n    expected:   " << expected);
+            }
+        }
+    }
+
+    // engines adding a term to the characteristic function don't
+    // provide the gradient, even on a pure Heston model
+    const AnalyticHestonHullWhiteEngine hullWhiteEngine(
+        model, ext::make_shared<HullWhite>(marketData.riskFreeTS, 0.1, 1e-8),
+        64);
+    if (hullWhiteEngine.providesGradient())
+        BOOST_ERROR("Heston Hull-White engine unexpectedly "
+                    "provides the price gradient");
+
+    // calibrate using the Jacobian provided by the helpers
+    for (const auto& option : options)
+        ext::dynamic_pointer_cast<BlackCalibrationHelper>(option)->setPricingEngine(engine);
+
+    LevenbergMarquardt om(1e-8, 1e-8, 1e-8, true);
+    model->calibrate(options, om,
+                     EndCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8));
+
+    Real sse = 0;
+    for (Size i = 0; i < 13*8; ++i) {
+        const Real diff = options[i]->calibrationError()*100.0;
+        sse += diff*diff;
+    }
+    Real expected = 177.2; //see article by A. Sepp.
+    if (std::fabs(sse - expected) > 1.0) {
+        BOOST_ERROR("Failed to reproduce calibration error"
+                    << "\n    calculated: " << sse
+                    << "\n    expected:   " << expected);
+    }
+}
+
+void HestonModelTest::testMultipleStrikesAnalyticEngines() {
+    BOOST_TEST_MESSAGE(
+        "Testing multiple-strikes pricing with Fourier-based Heston engines...");
+
+    SavedSettings backup;
+
+    const Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Handle<YieldTermStructure> riskFreeTS(flatRate(0.03, dayCounter));
+    const Handle<YieldTermStructure> dividendTS(flatRate(0.01, dayCounter));
+    const Handle<Quote> s0(ext::make_shared<SimpleQuote>(100.0));
+
+    const ext::shared_ptr<HestonModel> model(
+        ext::make_shared<HestonModel>(
+            ext::make_shared<HestonProcess>(
+                riskFreeTS, dividendTS, s0, 0.04, 1.5, 0.06, 0.5, -0.7)));
+
+    const ext::shared_ptr<BatesModel> batesModel(
+        ext::make_shared<BatesModel>(
+            ext::make_shared<BatesProcess>(
+                riskFreeTS, dividendTS, s0, 0.04, 1.5, 0.06, 0.5, -0.7,
+                0.5, -0.1, 0.15)));
+
+    const Date maturity = settlementDate + Period(18, Months);
+    const Time term = dayCounter.yearFraction(settlementDate, maturity);
+    const Option::Type types[] = { Option::Call, Option::Put };
+    const std::vector<Real> strikes = { 60.0, 80.0, 95.0, 100.0, 110.0, 150.0 };
+
+    const AnalyticHestonEngine::Integration reference =
+        AnalyticHestonEngine::Integration::gaussLaguerre(192);
+
+    const ext::shared_ptr<AnalyticHestonEngine> laguerreEngine =
+        ext::make_shared<AnalyticHestonEngine>(model, 192);
+    const ext::shared_ptr<AnalyticHestonEngine> legendreEngine =
+        ext::make_shared<AnalyticHestonEngine>(
+            model, AnalyticHestonEngine::Gatheral,
+            AnalyticHestonEngine::Integration::gaussLegendre(256));
+    const ext::shared_ptr<AnalyticHestonEngine> lobattoEngine =
+        ext::make_shared<AnalyticHestonEngine>(model, 1e-10, 10000);
+    const ext::shared_ptr<COSHestonEngine> cosEngine =
+        ext::make_shared<COSHestonEngine>(model, 16, 400);
+
+    const ext::shared_ptr<BatesEngine> batesEngine =
+        ext::make_shared<BatesEngine>(batesModel, 192);
+    const ext::shared_ptr<BatesEngine> batesLobattoEngine =
+        ext::make_shared<BatesEngine>(batesModel, 1e-10, 10000);
+
+    for (auto type : types) {
+        const std::vector<Real> laguerre =
+            laguerreEngine->values(type, strikes, maturity);
+        const std::vector<Real> legendre =
+            legendreEngine->values(type, strikes, maturity);
+        const std::vector<Real> lobatto =
+            lobattoEngine->values(type, strikes, maturity);
+        const std::vector<Real> cos =
+            cosEngine->values(type, strikes, maturity);
+        const std::vector<Real> bates =
+            batesEngine->values(type, strikes, maturity);
+        const std::vector<Real> batesLobatto =
+            batesLobattoEngine->values(type, strikes, maturity);
+
+        for (Size i = 0; i < strikes.size(); ++i) {
+            Real expected;
+            Size evaluations;
+            AnalyticHestonEngine::doCalculation(
+                riskFreeTS->discount(maturity), dividendTS->discount(maturity),
+                s0->value(), strikes[i], term,
+                model->kappa(), model->theta(), model->sigma(),
+                model->v0(), model->rho(),
+                PlainVanillaPayoff(type, strikes[i]), reference,
+                AnalyticHestonEngine::Gatheral, nullptr,
+                expected, evaluations);
+
+            const std::string names[] = {
+                "Gauss-Laguerre", "Gauss-Legendre", "Gauss-Lobatto", "COS" };
+            const Real calculated[] = {
+                laguerre[i], legendre[i], lobatto[i], cos[i] };
+            const Real tolerance[] = { 1e-10, 1e-6, 1e-6, 1e-6 };
+
+            for (Size j = 0; j < LENGTH(calculated); ++j) {
+                if (std::fabs(calculated[j] - expected) > tolerance[j]) {
+                    BOOST_ERROR("failed to reproduce Heston price "
+                                "with multiple strikes"
+                                << "\n    engine:     " << names[j]
+                                << "\n    strike:     " << strikes[i]
+                                << std::setprecision(12)
+                                << "\n    calculated: " << calculated[j]
+                                << "\n    expected:   " << expected);
+                }
+            }
+
+            if (std::fabs(bates[i] - batesLobatto[i]) > 1e-6) {
+                BOOST_ERROR("failed to reproduce Bates price "
+                            "with multiple strikes"
+                            << "\n    strike:     " << strikes[i]
+                            << std::setprecision(12)
+                            << "\n    calculated: " << bates[i]
+                            << "\n    expected:   " << batesLobatto[i]);
+            }
+
+            // options sharing the engine and maturity reuse
+            // the cached characteristic function
+            VanillaOption option(
+                ext::make_shared<PlainVanillaPayoff>(type, strikes[i]),
+                ext::make_shared<EuropeanExercise>(maturity));
+            option.setPricingEngine(laguerreEngine);
+            if (std::fabs(option.NPV() - laguerre[i]) > 1e-12
+                || laguerreEngine->numberOfEvaluations() != 0) {
+                BOOST_ERROR("failed to reuse cached characteristic function"
+                            << "\n    strike:      " << strikes[i]
+                            << std::setprecision(12)
+                            << "\n    calculated:  " << option.NPV()
+                            << "\n    expected:    " << laguerre[i]
+                            << "\n    evaluations: "
+                            << laguerreEngine->numberOfEvaluations());
+            }
+        }
+    }
+}
+
+void HestonModelTest::testFFTEngines() {
+    BOOST_TEST_MESSAGE("Testing FFT engines for Heston-type models...");
+
+    SavedSettings backup;
+
+    const Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Handle<YieldTermStructure> riskFreeTS(flatRate(0.03, dayCounter));
+    const Handle<YieldTermStructure> dividendTS(flatRate(0.01, dayCounter));
+    const Handle<Quote> s0(ext::make_shared<SimpleQuote>(100.0));
+
+    const Real v0 = 0.04, kappa = 1.5, theta = 0.06, sigma = 0.5, rho = -0.7;
+
+    const ext::shared_ptr<HestonModel> model(
+        ext::make_shared<HestonModel>(
+            ext::make_shared<HestonProcess>(
+                riskFreeTS, dividendTS, s0, v0, kappa, theta, sigma, rho)));
+
+    const ext::shared_ptr<BatesModel> batesModel(
+        ext::make_shared<BatesModel>(
+            ext::make_shared<BatesProcess>(
+                riskFreeTS, dividendTS, s0, v0, kappa, theta, sigma, rho,
+                0.5, -0.1, 0.15)));
+
+    const ext::shared_ptr<PiecewiseTimeDependentHestonModel> ptdModel(
+        ext::make_shared<PiecewiseTimeDependentHestonModel>(
+            riskFreeTS, dividendTS, s0, v0,
+            ConstantParameter(theta, PositiveConstraint()),
+            ConstantParameter(kappa, PositiveConstraint()),
+            ConstantParameter(sigma, PositiveConstraint()),
+            ConstantParameter(rho, BoundaryConstraint(-1.0, 1.0)),
+            TimeGrid(5.0, 10)));
+
+    const ext::shared_ptr<PricingEngine> analyticEngine =
+        ext::make_shared<AnalyticHestonEngine>(model, 192);
+    const ext::shared_ptr<PricingEngine> batesAnalyticEngine =
+        ext::make_shared<BatesEngine>(batesModel, 192);
+
+    const ext::shared_ptr<FFTEngine> fftEngines[] = {
+        ext::make_shared<FFTHestonEngine>(model),
+        ext::make_shared<FFTHestonEngine>(model, 0.001),
+        ext::make_shared<FFTBatesEngine>(batesModel),
+        ext::make_shared<FFTBatesEngine>(batesModel, 0.001),
+        ext::make_shared<FFTPTDHestonEngine>(ptdModel),
+        ext::make_shared<FFTPTDHestonEngine>(ptdModel, 0.001)
+    };
+    const ext::shared_ptr<PricingEngine> referenceEngines[] = {
+        analyticEngine, analyticEngine,
+        batesAnalyticEngine, batesAnalyticEngine,
+        analyticEngine, analyticEngine
+    };
+    const std::string names[] = {
+        "Heston FFT", "Heston fractional FFT",
+        "Bates FFT", "Bates fractional FFT",
+        "PTD Heston FFT", "PTD Heston fractional FFT"
+    };
+    // odd engines use a non-power-of-two grid; their log-strike
+    // spacing is finer than 0.005, at which the interpolation between
+    // grid strikes leaves errors around 1e-3
+    for (Size k = 1; k < LENGTH(fftEngines); k += 2)
+        fftEngines[k]->enableFractionalFFT(1000, 0.1);
+
+    const Period maturities[] = { Period(6, Months), Period(18, Months) };
+    const Option::Type types[] = { Option::Call, Option::Put };
+    const Real strikes[] = { 60.0, 80.0, 95.0, 100.0, 110.0, 150.0 };
+
+    std::vector<ext::shared_ptr<Instrument> > options;
+    for (const auto& maturity : maturities) {
+        const ext::shared_ptr<Exercise> exercise =
+            ext::make_shared<EuropeanExercise>(settlementDate + maturity);
+        for (auto type : types)
+            for (Real strike : strikes)
+                options.push_back(ext::make_shared<VanillaOption>(
+                    ext::make_shared<PlainVanillaPayoff>(type, strike),
+                    exercise));
+    }
+
+    const Real tol = 1e-4;
+    for (Size k = 0; k < LENGTH(fftEngines); ++k) {
+        fftEngines[k]->precalculate(options);
+
+        for (const auto& instrument : options) {
+            const ext::shared_ptr<VanillaOption> option =
+                ext::dynamic_pointer_cast<VanillaOption>(instrument);
+
+            option->setPricingEngine(referenceEngines[k]);
+            const Real expected = option->NPV();
+            option->setPricingEngine(fftEngines[k]);
+            const Real calculated = option->NPV();
+
+            if (std::fabs(calculated - expected) > tol) {
+                const ext::shared_ptr<StrikedTypePayoff> payoff =
+                    ext::dynamic_pointer_cast<StrikedTypePayoff>(
+                                                          option->payoff());
+                BOOST_ERROR("failed to reproduce analytic price"
+                            << "\n    engine:     " << names[k]
+                            << "\n    type:       " << payoff->optionType()
+                            << "\n    strike:     " << payoff->strike()
+                            << "\n    maturity:   "
+                            << option->exercise()->lastDate()
+                            << std::setprecision(12)
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected
+                            << "\n    tolerance:  " << tol);
+            }
+        }
+    }
+}
+
 void HestonModelTest::testAnalyticVsBlack() {
     BOOST_TEST_MESSAGE("Testing analytic Heston engine against Black formula...");
 
@@ -3226,11 +3622,20 @@ test_suite* HestonModelTest::suite(SpeedLevel speed) {
 
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testBlackCalibration));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testDAXCalibration));
+    #ifdef _OPENMP
+    // without OpenMP, the parallel loop runs serially
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testParallelCalibration));
+    #endif
+    suite->add(QUANTLIB_TEST_CASE(
+                    &HestonModelTest::testAnalyticGradientCalibration));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testAnalyticVsBlack));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testAnalyticVsCached));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testDifferentIntegrals));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testFdVanillaVsCached));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testMultipleStrikesEngine));
+    suite->add(QUANTLIB_TEST_CASE(
+                    &HestonModelTest::testMultipleStrikesAnalyticEngines));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testFFTEngines));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testMcVsCached));
     suite->add(QUANTLIB_TEST_CASE(
                     &HestonModelTest::testAnalyticPiecewiseTimeDependent));
@@ -30,6 +30,8 @@ class HestonModelTest {
   public:
     static void testBlackCalibration();
     static void testDAXCalibration();
+    static void testParallelCalibration();
+    static void testAnalyticGradientCalibration();
     static void testAnalyticVsBlack();
     static void testAnalyticVsCached();
     static void testKahlJaeckelCase();
@@ -38,6 +40,8 @@ class HestonModelTest {
     static void testFdVanillaVsCached();    
     static void testDifferentIntegrals();
     static void testMultipleStrikesEngine();
+    static void testMultipleStrikesAnalyticEngines();
+    static void testFFTEngines();
     static void testAnalyticPiecewiseTimeDependent();
     static void testDAXCalibrationOfTimeDependentModel();
     static void testAlanLewisReferencePrices();
@@ -36,6 +36,7 @@
 #include <ql/math/interpolations/kernelinterpolation2d.hpp>
 #include <ql/math/interpolations/lagrangeinterpolation.hpp>
 #include <ql/math/interpolations/linearinterpolation.hpp>
+#include <ql/math/interpolations/loginterpolation.hpp>
 #include <ql/math/interpolations/multicubicspline.hpp>
 #include <ql/math/interpolations/sabrinterpolation.hpp>
 #include <ql/math/kernelfunctions.hpp>
@@ -2397,6 +2398,127 @@ void InterpolationTest::testBackwardFlatOnSinglePoint() {
     }
 }
 
+namespace {
+
+    // linear interpolation counting the uniformity checks it receives
+    Size uniformityChecks = 0;
+
+    template <class I1, class I2>
+    class CheckedLinearImpl : public detail::LinearInterpolationImpl<I1,I2> {
+      public:
+        CheckedLinearImpl(const I1& xBegin, const I1& xEnd, const I2& yBegin)
+        : detail::LinearInterpolationImpl<I1,I2>(xBegin, xEnd, yBegin) {}
+        bool checkUniformity() override {
+            ++uniformityChecks;
+            return detail::LinearInterpolationImpl<I1,I2>::checkUniformity();
+        }
+    };
+
+    class CheckedLinear {
+      public:
+        template <class I1, class I2>
+        Interpolation interpolate(const I1& xBegin, const I1& xEnd,
+                                  const I2& yBegin) const {
+            return CheckedInterpolation<CheckedLinearImpl<I1,I2> >(
+                                                      xBegin, xEnd, yBegin);
+        }
+        static const bool global = false;
+        static const Size requiredPoints = 2;
+
+        template <class T>
+        class CheckedInterpolation : public Interpolation {
+          public:
+            template <class I1, class I2>
+            CheckedInterpolation(const I1& xBegin, const I1& xEnd,
+                                 const I2& yBegin) {
+                impl_ = ext::make_shared<T>(xBegin, xEnd, yBegin);
+                impl_->update();
+            }
+        };
+    };
+
+}
+
+void InterpolationTest::testHintedLocate() {
+    BOOST_TEST_MESSAGE("Testing hinted and batch interpolation lookups...");
+
+    const Size n = 21;
+    std::vector<Real> uniform(n), nonUniform(n), y(n);
+    for (Size i=0; i<n; ++i) {
+        uniform[i] = 0.5*i;
+        nonUniform[i] = 0.5*i + 0.1*std::sin(Real(i));
+        y[i] = std::exp(0.1*i) + 0.2*std::cos(Real(i));
+    }
+
+    // increasing points on and between nodes, plus a few
+    // unsorted ones and some outside the range
+    std::vector<Real> x;
+    for (Size i=0; i<=200; ++i)
+        x.push_back(-0.5 + 0.05*i);
+    const Real extra[] = { 3.3, 0.0, 10.0, 7.25, 0.5, 9.99, -1.0, 11.0 };
+    x.insert(x.end(), extra, extra+LENGTH(extra));
+
+    const std::vector<Real>* grids[] = { &uniform, &nonUniform };
+    for (auto grid : grids) {
+        std::vector<Interpolation> interpolations, references;
+        for (auto* v : { &interpolations, &references }) {
+            v->push_back(Linear().interpolate(
+                             grid->begin(), grid->end(), y.begin()));
+            v->push_back(LogLinear().interpolate(
+                             grid->begin(), grid->end(), y.begin()));
+            v->push_back(Cubic().interpolate(
+                             grid->begin(), grid->end(), y.begin()));
+            v->push_back(BackwardFlat().interpolate(
+                             grid->begin(), grid->end(), y.begin()));
+        }
+        // the references keep searching for the intervals; all the
+        // interpolations, including the log-linear one through the
+        // interpolation of the logs, compute them on uniform grids
+        for (Size k=0; k<interpolations.size(); ++k) {
+            const bool direct = interpolations[k].checkUniformity();
+            if (direct != (grid == &uniform))
+                BOOST_FAIL("failed to detect "
+                           << (direct ? "non-uniform" : "uniform")
+                           << " grid for interpolation " << k);
+        }
+
+        for (Size k=0; k<interpolations.size(); ++k) {
+            const Interpolation& f = interpolations[k];
+
+            std::vector<Real> batch(x.size());
+            f(&x[0], &batch[0], x.size(), true);
+
+            Size hint = 0;
+            for (Size i=0; i<x.size(); ++i) {
+                const Real expected = references[k](x[i], true);
+                const Real plain = f(x[i], true);
+                const Real hinted = f(x[i], hint, true);
+                if (std::fabs(plain - expected) > 1e-14
+                    || std::fabs(hinted - expected) > 1e-14
+                    || std::fabs(batch[i] - expected) > 1e-14)
+                    BOOST_FAIL("failed to reproduce interpolated value"
+                               << "\n    interpolation: " << k
+                               << "\n    x:             " << x[i]
+                               << "\n    expected:      " << expected
+                               << "\n    plain:         " << plain
+                               << "\n    hinted:        " << hinted
+                               << "\n    batch:         " << batch[i]);
+            }
+        }
+    }
+
+    // log interpolations forward the check to the interpolation of
+    // the logs, which performs the lookups
+    uniformityChecks = 0;
+    CheckedLinear::CheckedInterpolation<
+        detail::LogInterpolationImpl<std::vector<Real>::const_iterator,
+                                     std::vector<Real>::const_iterator,
+                                     CheckedLinear> >
+        logLinear(uniform.begin(), uniform.end(), y.begin());
+    if (!logLinear.checkUniformity() || uniformityChecks != 1)
+        BOOST_FAIL("uniformity check not forwarded by log interpolation");
+}
+
 test_suite* InterpolationTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Interpolation tests");
 
@@ -2448,6 +2570,7 @@ test_suite* InterpolationTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(
         &InterpolationTest::testBackwardFlatOnSinglePoint));
+    suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testHintedLocate));
 
 
     return suite;
@@ -62,6 +62,9 @@ class PiecewiseYieldCurveTest {
 
     static void testIterativeBootstrapRetries();
 
+    static void testJacobian();
+    static void testMultiCurveSensitivities();
+
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -503,7 +503,7 @@ test_suite* init_unit_test_suite(int, char* []) {
     test->add(CompiledBoostVersionTest::suite());
     test->add(CompoundOptionTest::suite());
     test->add(ConvertibleBondTest::suite());
-    test->add(CreditRiskPlusTest::suite());
+    test->add(CreditRiskPlusTest::suite(speed));
     test->add(DoubleBarrierOptionTest::suite(speed));
     test->add(DoubleBinaryOptionTest::suite());
     test->add(EuropeanOptionTest::experimental());
@@ -24,7 +24,13 @@
 #include <ql/time/calendars/japan.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
 #include <ql/time/calendars/weekendsonly.hpp>
+#include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <ql/time/daycounters/actualactual.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
+#include <ql/time/daycounters/thirty365.hpp>
 #include <ql/instruments/creditdefaultswap.hpp>
+#include <iomanip>
 #include <map>
 #include <vector>
 
@@ -1074,6 +1080,61 @@ void ScheduleTest::testTruncation() {
     BOOST_CHECK(t.isRegular().front() == true);
 }
 
+void ScheduleTest::testSwapLegAccruals() {
+    BOOST_TEST_MESSAGE(
+        "Testing schedule and accrual generation for a 30-year quarterly leg...");
+
+    // the start date is moved at each iteration so that different
+    // dates are generated.
+    Date startDate(15, March, 2021);
+    DayCounter dayCounters[] = {
+        Thirty360(Thirty360::BondBasis),
+        Thirty360(Thirty360::European),
+        Thirty360(Thirty360::Italian),
+        Thirty360(Thirty360::German),
+        Thirty365(),
+        Actual360(),
+        Actual365Fixed(),
+        ActualActual(ActualActual::ISMA)
+    };
+
+    for (Size k=0; k<250; ++k) {
+        Date start = startDate + Integer(k);
+        Schedule s = MakeSchedule().from(start)
+                                   .to(start + 30*Years)
+                                   .withFrequency(Quarterly)
+                                   .withCalendar(TARGET())
+                                   .withConvention(ModifiedFollowing)
+                                   .backwards();
+
+        if (s.size() != 121)
+            BOOST_FAIL("unexpected number of dates: " << s.size() <<
+                       " (121 expected) for schedule starting on " << start);
+
+        std::vector<Date> startDates(s.dates().begin(), s.dates().end()-1);
+        std::vector<Date> endDates(s.dates().begin()+1, s.dates().end());
+
+        for (const auto& dayCounter : dayCounters) {
+            std::vector<Time> accruals =
+                dayCounter.yearFractions(startDates, endDates,
+                                         startDates, endDates);
+            for (Size i=0; i<accruals.size(); ++i) {
+                Time expected =
+                    dayCounter.yearFraction(startDates[i], endDates[i],
+                                            startDates[i], endDates[i]);
+                if (accruals[i] != expected)
+                    BOOST_FAIL("batch year fraction differs from single one"
+                               << "\n    day counter: " << dayCounter
+                               << "\n    period:      " << startDates[i]
+                               << " to " << endDates[i]
+                               << std::setprecision(12)
+                               << "\n    calculated:  " << accruals[i]
+                               << "\n    expected:    " << expected);
+            }
+        }
+    }
+}
+
 test_suite* ScheduleTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Schedule tests");
     suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testDailySchedule));
@@ -1103,5 +1164,6 @@ test_suite* ScheduleTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testFirstDateOnMaturity));
     suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testNextToLastDateOnStart));
     suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testTruncation));
+    suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testSwapLegAccruals));
     return suite;
 }
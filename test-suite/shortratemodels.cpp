@@ -24,6 +24,7 @@
 #include "shortratemodels.hpp"
 #include "utilities.hpp"
 #include <ql/cashflows/iborcoupon.hpp>
+#include <ql/discretizedasset.hpp>
 #include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
 #include <ql/models/shortrate/onefactormodels/extendedcoxingersollross.hpp>
 #include <ql/models/shortrate/calibrationhelpers/swaptionhelper.hpp>
@@ -453,6 +454,70 @@ void ShortRateModelTest::testExtendedCoxIngersollRossDiscountFactor() {
     }
 }
 
+void ShortRateModelTest::testTreeSpread() {
+    BOOST_TEST_MESSAGE("Testing spread changes on a short-rate tree...");
+
+    SavedSettings backup;
+    const Date today = Settings::instance().evaluationDate();
+
+    const Handle<YieldTermStructure> rTS(
+        flatRate(today, 0.04, Actual365Fixed()));
+    const HullWhite model(rTS, 0.1, 0.01);
+
+    const Time maturity = 5.0;
+    const TimeGrid grid(maturity, 100);
+
+    const auto rollback = [&](const ext::shared_ptr<Lattice>& lattice) {
+        DiscretizedDiscountBond bond;
+        bond.initialize(lattice, maturity);
+        bond.rollback(0.0);
+        return bond.presentValue();
+    };
+
+    const ext::shared_ptr<Lattice> lattice = model.tree(grid);
+    const ext::shared_ptr<OneFactorModel::ShortRateTree> tree =
+        ext::dynamic_pointer_cast<OneFactorModel::ShortRateTree>(lattice);
+    QL_REQUIRE(tree, "short-rate tree expected");
+
+    // roll back once so that the discounts are stored
+    const Real unspread = rollback(lattice);
+
+    const Real tol = 1e-12;
+    for (Spread spread : {0.01, -0.005, 0.0}) {
+        tree->setSpread(spread);
+        const Real calculated = rollback(lattice);
+
+        const ext::shared_ptr<Lattice> freshLattice = model.tree(grid);
+        ext::dynamic_pointer_cast<OneFactorModel::ShortRateTree>(freshLattice)
+            ->setSpread(spread);
+        const Real expected = rollback(freshLattice);
+
+        if (std::fabs(calculated-expected) > tol) {
+            BOOST_ERROR("Failed to reproduce fresh-tree price after spread change:"
+                        << std::setprecision(12)
+                        << "\n  spread    : " << spread
+                        << "\n  calculated: " << calculated
+                        << "\n  expected  : " << expected
+                        << std::scientific
+                        << "\n  difference: " << calculated-expected
+                        << "\n  tolerance : " << tol);
+        }
+
+        // the spread is constant, so it discounts the whole bond
+        const Real shifted = unspread*std::exp(-spread*maturity);
+        if (std::fabs(calculated-shifted) > tol) {
+            BOOST_ERROR("Failed to reproduce spread discount on the tree:"
+                        << std::setprecision(12)
+                        << "\n  spread    : " << spread
+                        << "\n  calculated: " << calculated
+                        << "\n  expected  : " << shifted
+                        << std::scientific
+                        << "\n  difference: " << calculated-shifted
+                        << "\n  tolerance : " << tol);
+        }
+    }
+}
+
 test_suite* ShortRateModelTest::suite(SpeedLevel speed) {
     auto* suite = BOOST_TEST_SUITE("Short-rate model tests");
 
@@ -462,6 +527,7 @@ test_suite* ShortRateModelTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testFuturesConvexityBias));
     suite->add(QUANTLIB_TEST_CASE(
         &ShortRateModelTest::testExtendedCoxIngersollRossDiscountFactor));
+    suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testTreeSpread));
 
     if (speed == Slow) {
         suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testSwaps));
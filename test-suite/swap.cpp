@@ -35,6 +35,15 @@
 #include <ql/cashflows/cashflows.hpp>
 #include <ql/cashflows/couponpricer.hpp>
 #include <ql/currencies/europe.hpp>
+#include <ql/experimental/risk/scenarioanalysis.hpp>
+#include <ql/experimental/risk/sensitivityanalysis.hpp>
+#include <ql/instruments/makevanillaswap.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/math/statistics/riskstatistics.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
+#include <ql/termstructures/yield/ratehelpers.hpp>
+#include <ql/time/calendars/target.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -98,6 +107,46 @@ namespace swap_test {
         }
     };
 
+    // swaps on a bootstrapped curve and on a flat one, each with its
+    // own quotes
+    SensitivityGraph makeSensitivityGraph() {
+        SensitivityGraph graph;
+        Calendar calendar = TARGET();
+
+        Integer lengths[] = { 1, 2, 3, 5, 7, 10 };
+        Rate rates[] = { 0.020, 0.022, 0.025, 0.029, 0.031, 0.033 };
+        std::vector<ext::shared_ptr<RateHelper> > helpers;
+        for (Size i=0; i<LENGTH(lengths); ++i) {
+            ext::shared_ptr<SimpleQuote> rate(new SimpleQuote(rates[i]));
+            graph.quotes.emplace_back(rate);
+            helpers.push_back(ext::make_shared<SwapRateHelper>(
+                Handle<Quote>(rate), lengths[i]*Years, calendar, Annual,
+                Unadjusted, Thirty360(Thirty360::BondBasis),
+                ext::make_shared<Euribor6M>()));
+        }
+        Handle<YieldTermStructure> curve(
+            ext::make_shared<PiecewiseYieldCurve<Discount, LogLinear> >(
+                2, calendar, helpers, Actual365Fixed()));
+
+        ext::shared_ptr<SimpleQuote> flat(new SimpleQuote(0.03));
+        graph.quotes.emplace_back(flat);
+        Handle<YieldTermStructure> flatCurve(ext::make_shared<FlatForward>(
+            2, calendar, Handle<Quote>(flat), Actual365Fixed()));
+
+        Integer swapLengths[] = { 2, 4, 8 };
+        for (auto& length : swapLengths)
+            graph.instruments.push_back(ext::shared_ptr<VanillaSwap>(
+                MakeVanillaSwap(length*Years,
+                                ext::make_shared<Euribor6M>(curve), 0.025)
+                .withNominal(100.0)));
+        for (auto& length : swapLengths)
+            graph.instruments.push_back(ext::shared_ptr<VanillaSwap>(
+                MakeVanillaSwap(length*Years,
+                                ext::make_shared<Euribor6M>(flatCurve), 0.025)
+                .withNominal(100.0)));
+        return graph;
+    }
+
 }
 
 
@@ -329,6 +378,193 @@ void SwapTest::testCachedValue() {
 }
 
 
+void SwapTest::testBucketSensitivities() {
+
+    BOOST_TEST_MESSAGE("Testing bucket sensitivities of a swap book...");
+
+    using namespace swap_test;
+
+    SavedSettings backup;
+
+    SensitivityGraph graph = makeSensitivityGraph();
+    Size n = graph.quotes.size(), m = graph.instruments.size();
+    std::vector<Real> npv(m);
+    for (Size j=0; j<m; ++j)
+        npv[j] = graph.instruments[j]->NPV();
+
+    std::pair<Matrix, Matrix> sensitivities =
+        bucketSensitivities(graph.quotes, graph.instruments);
+
+    // the bootstrap is only solved to its accuracy, whose noise is
+    // amplified by the second differences
+    Real deltaTolerance = 1.0e-6, gammaTolerance = 1.0e-2;
+    for (Size j=0; j<m; ++j) {
+        std::vector<ext::shared_ptr<Instrument> > swap(1, graph.instruments[j]);
+        std::pair<std::vector<Real>, std::vector<Real> > expected =
+            bucketAnalysis(graph.quotes, swap, std::vector<Real>());
+        for (Size i=0; i<n; ++i) {
+            if (std::fabs(sensitivities.first[i][j] - expected.first[i]) > deltaTolerance
+                || std::fabs(sensitivities.second[i][j] - expected.second[i]) > gammaTolerance)
+                BOOST_ERROR("failed to reproduce bucket analysis:\n"
+                            << std::setprecision(12)
+                            << "    quote:      " << i << "\n"
+                            << "    swap:       " << j << "\n"
+                            << "    delta:      " << sensitivities.first[i][j] << "\n"
+                            << "    expected:   " << expected.first[i] << "\n"
+                            << "    gamma:      " << sensitivities.second[i][j] << "\n"
+                            << "    expected:   " << expected.second[i]);
+        }
+        // the last quote only drives the flat curve
+        bool dependent = (j >= m/2);
+        if ((sensitivities.first[n-1][j] != 0.0) != dependent
+            || (sensitivities.first[0][j] != 0.0) == dependent)
+            BOOST_ERROR("unexpected dependencies of swap " << j << ":\n"
+                        << std::setprecision(12)
+                        << "    first quote:  " << sensitivities.first[0][j] << "\n"
+                        << "    last quote:   " << sensitivities.first[n-1][j]);
+    }
+
+    for (Size j=0; j<m; ++j) {
+        if (std::fabs(graph.instruments[j]->NPV() - npv[j]) > 1.0e-9)
+            BOOST_ERROR("failed to restore the value of swap " << j << ":\n"
+                        << std::setprecision(12)
+                        << "    value:      " << graph.instruments[j]->NPV() << "\n"
+                        << "    expected:   " << npv[j]);
+    }
+
+    std::pair<Matrix, Matrix> parallel =
+        bucketSensitivities(&makeSensitivityGraph, 3);
+    for (Size i=0; i<n; ++i) {
+        for (Size j=0; j<m; ++j) {
+            if (std::fabs(parallel.first[i][j] - sensitivities.first[i][j]) > deltaTolerance
+                || std::fabs(parallel.second[i][j] - sensitivities.second[i][j]) > gammaTolerance)
+                BOOST_ERROR("sensitivities on separate graphs differ:\n"
+                            << std::setprecision(12)
+                            << "    quote:      " << i << "\n"
+                            << "    swap:       " << j << "\n"
+                            << "    delta:      " << parallel.first[i][j] << "\n"
+                            << "    expected:   " << sensitivities.first[i][j] << "\n"
+                            << "    gamma:      " << parallel.second[i][j] << "\n"
+                            << "    expected:   " << sensitivities.second[i][j]);
+        }
+    }
+}
+
+void SwapTest::testScenarioValueAtRisk() {
+
+    BOOST_TEST_MESSAGE("Testing scenario value at risk of a swap book...");
+
+    using namespace swap_test;
+
+    SavedSettings backup;
+
+    SensitivityGraph graph = makeSensitivityGraph();
+    Size n = graph.quotes.size();
+
+    // random walks of the quotes, with a few gaps in the last one
+    MersenneTwisterUniformRng rng(42);
+    Size observations = 260;
+    std::vector<TimeSeries<Real> > histories(n);
+    std::vector<Real> levels(n);
+    for (Size i=0; i<n; ++i) {
+        Real rate = graph.quotes[i]->value();
+        levels[i] = rate;
+        for (Size k=0; k<observations; ++k) {
+            if (i != n-1 || k % 10 != 5)
+                histories[i][Date(2, January, 2019) + k] = rate;
+            rate += 0.0010*(rng.nextReal()-0.5);
+        }
+    }
+
+    Matrix scenarios = historicalScenarios(histories);
+    Size expectedScenarios = observations - observations/10 - 1;
+    if (scenarios.rows() != expectedScenarios)
+        BOOST_FAIL("wrong number of historical scenarios:\n"
+                   << "    calculated: " << scenarios.rows() << "\n"
+                   << "    expected:   " << expectedScenarios);
+
+    RiskStatistics full, parallel, approximated;
+    scenarioRevaluation(full, &makeSensitivityGraph, 1,
+                        scenarios, std::vector<Real>());
+    scenarioRevaluation(parallel, &makeSensitivityGraph, 3,
+                        scenarios, std::vector<Real>());
+
+    std::pair<Matrix, Matrix> sensitivities =
+        bucketSensitivities(graph.quotes, graph.instruments);
+    std::vector<Real> delta(n, 0.0), gamma(n, 0.0);
+    for (Size i=0; i<n; ++i) {
+        for (Size j=0; j<graph.instruments.size(); ++j) {
+            delta[i] += sensitivities.first[i][j];
+            gamma[i] += sensitivities.second[i][j];
+        }
+    }
+    deltaGammaRevaluation(approximated, delta, gamma, scenarios);
+
+    Real percentile = 0.99;
+    Real var = full.valueAtRisk(percentile);
+    if (full.samples() != expectedScenarios || var <= 0.0)
+        BOOST_ERROR("unexpected full revaluation:\n"
+                    << "    samples:       " << full.samples() << "\n"
+                    << "    value at risk: " << var);
+    if (parallel.samples() != full.samples()
+        || std::fabs(parallel.valueAtRisk(percentile) - var) > 1.0e-8
+        || std::fabs(parallel.expectedShortfall(percentile)
+                     - full.expectedShortfall(percentile)) > 1.0e-8)
+        BOOST_ERROR("revaluation on separate graphs differs:\n"
+                    << std::setprecision(12)
+                    << "    value at risk:      "
+                    << parallel.valueAtRisk(percentile) << "\n"
+                    << "    expected:           " << var << "\n"
+                    << "    expected shortfall: "
+                    << parallel.expectedShortfall(percentile) << "\n"
+                    << "    expected:           "
+                    << full.expectedShortfall(percentile));
+
+    Real tolerance = 0.01;
+    if (std::fabs(approximated.valueAtRisk(percentile) - var) > tolerance*var)
+        BOOST_ERROR("delta-gamma value at risk too far from full revaluation:\n"
+                    << std::setprecision(12)
+                    << "    delta-gamma: " << approximated.valueAtRisk(percentile) << "\n"
+                    << "    full:        " << var);
+
+    // relative scenarios give the same changes of the quotes
+    for (Size k=0; k<scenarios.rows(); ++k)
+        for (Size i=0; i<n; ++i)
+            scenarios[k][i] /= levels[i];
+    RiskStatistics relative;
+    scenarioRevaluation(relative, &makeSensitivityGraph, 2,
+                        scenarios, std::vector<Real>(), true);
+    if (std::fabs(relative.valueAtRisk(percentile) - var) > 1.0e-8)
+        BOOST_ERROR("relative scenarios differ from absolute ones:\n"
+                    << std::setprecision(12)
+                    << "    value at risk: " << relative.valueAtRisk(percentile) << "\n"
+                    << "    expected:      " << var);
+
+    // simulated scenarios reproduce the given covariance
+    Matrix covariance(2, 2);
+    covariance[0][0] = 1.0e-8;
+    covariance[0][1] = covariance[1][0] = 0.5e-8;
+    covariance[1][1] = 4.0e-8;
+    Matrix simulated = simulatedScenarios(covariance, 20000);
+    Matrix sampleCovariance(2, 2, 0.0);
+    for (Size k=0; k<simulated.rows(); ++k)
+        for (Size i=0; i<2; ++i)
+            for (Size j=0; j<2; ++j)
+                sampleCovariance[i][j] +=
+                    simulated[k][i]*simulated[k][j]/simulated.rows();
+    for (Size i=0; i<2; ++i) {
+        for (Size j=0; j<2; ++j) {
+            if (std::fabs(sampleCovariance[i][j] - covariance[i][j])
+                > 0.05*std::sqrt(covariance[i][i]*covariance[j][j]))
+                BOOST_ERROR("wrong covariance of simulated scenarios:\n"
+                            << "    element:    " << i << ", " << j << "\n"
+                            << "    calculated: " << sampleCovariance[i][j] << "\n"
+                            << "    expected:   " << covariance[i][j]);
+        }
+    }
+}
+
+
 test_suite* SwapTest::suite() {
     auto* suite = BOOST_TEST_SUITE("Swap tests");
     suite->add(QUANTLIB_TEST_CASE(&SwapTest::testFairRate));
@@ -337,6 +573,8 @@ test_suite* SwapTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&SwapTest::testSpreadDependency));
     suite->add(QUANTLIB_TEST_CASE(&SwapTest::testInArrears));
     suite->add(QUANTLIB_TEST_CASE(&SwapTest::testCachedValue));
+    suite->add(QUANTLIB_TEST_CASE(&SwapTest::testBucketSensitivities));
+    suite->add(QUANTLIB_TEST_CASE(&SwapTest::testScenarioValueAtRisk));
     return suite;
 }
 
@@ -33,6 +33,8 @@ class SwapTest {
     static void testSpreadDependency();
     static void testInArrears();
     static void testCachedValue();
+    static void testBucketSensitivities();
+    static void testScenarioValueAtRisk();
     static boost::unit_test_framework::test_suite* suite();
 };
 